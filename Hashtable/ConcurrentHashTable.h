@@ -0,0 +1,507 @@
+#ifndef CONCURRENTHASHTABLE_H
+#define CONCURRENTHASHTABLE_H
+
+#include "Hashtable.h"
+#include "EpochReclamation.h"
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+//==============================================================================|
+
+/**
+ * @brief Hash table that many threads can read and write at once.
+ *
+ * @details Writers lock one of STRIPES stripes. Bucket i belongs to stripe i % STRIPES, so writers to different
+ * stripes never wait for each other. Readers take no lock at all. They pin an epoch (see EpochReclamation) and walk
+ * the chains, whose heads and links are published with release stores.
+ *
+ * Nodes are never changed after they are published. An update links a new node in place of the old one, and a
+ * removal unlinks the node. Unlinked nodes are collected per stripe and retired to EpochReclamation in batches, so
+ * a node is only freed once no reader can still see it. This way a reader always copies a complete value.
+ *
+ * A resize locks every stripe, copies all nodes into a bucket array twice the size and publishes it with one
+ * store. Writers wait for the resize, but readers continue on the old array until they see the new one. The old
+ * array and its nodes are then retired as a whole.
+ *
+ * Lookups return copies of the values. Iteration with forEach is weakly consistent: it sees every entry that was
+ * present for the whole iteration and may or may not see concurrent changes. V must be default constructible.
+ *
+ * @tparam K The type of the keys.
+ * @tparam V The type of the values.
+ * @tparam Hash The hash function, KeyHash<K> by default.
+ */
+template <typename K, typename V, typename Hash = KeyHash<K>>
+class ConcurrentHashTable {
+private:
+    /**
+     * @brief An entry. Only next changes after the node is published.
+     */
+    struct Node {
+        const K key;
+        const V value;
+        const size_t hash; // Spread hash of the key
+        std::atomic<Node*> next;
+
+        Node(const K& k, const V& v, size_t h, Node* n) : key(k), value(v), hash(h), next(n) {}
+    };
+
+    /**
+     * @brief A bucket array, replaced as a whole on resize. Owns the nodes linked from it.
+     */
+    struct BucketArray {
+        size_t mask; // Number of buckets minus one, the number of buckets is a power of two
+        std::atomic<Node*>* heads;
+
+        explicit BucketArray(size_t buckets) : mask(buckets - 1), heads(new std::atomic<Node*>[buckets]) {
+            for (size_t i = 0; i < buckets; ++i) {
+                heads[i].store(nullptr, std::memory_order_relaxed);
+            }
+        }
+        ~BucketArray() { delete[] heads; }
+        BucketArray(const BucketArray&) = delete;
+        BucketArray& operator=(const BucketArray&) = delete;
+
+        static void destroyWithNodes(void* array); // Deleter used to retire an array together with its nodes
+    };
+
+    /**
+     * @brief Writer lock and bookkeeping of one stripe, padded to its own cache line.
+     */
+    struct alignas(64) Stripe {
+        std::mutex mutex;
+        std::atomic<size_t> count; // Entries in the buckets of this stripe, only changed under mutex
+        std::vector<Node*>* garbage; // Unlinked nodes not retired yet, only touched under mutex
+
+        Stripe() : count(0), garbage(nullptr) {}
+    };
+
+    typedef std::unique_lock<std::mutex> StripeLock;
+
+    static const size_t STRIPES = 64; // Number of writer locks, a power of two
+    static const size_t INITIAL_TABLE_SIZE = 64; // Initial number of buckets, a power of two and at least STRIPES
+    static const size_t GARBAGE_BATCH = 64; // Unlinked nodes collected by a stripe before they are retired together
+    static constexpr float LOAD_FACTOR = 0.75f; // Average chain length that triggers a resize
+
+    std::atomic<BucketArray*> table; // Current bucket array
+    Stripe stripes[STRIPES];
+    Hash hashFunction; // The hash function to use
+
+    size_t hashOf(const K& key) const { return HashMixing::spread(hashFunction(key)); }
+    Stripe& stripeOf(size_t hash) { return stripes[hash & (STRIPES - 1)]; }
+    Node* findNode(const BucketArray* array, const K& key, size_t hash) const; // Find a node, the caller is pinned or holds the stripe lock
+    std::vector<Node*>* discard(Stripe& stripe, Node* node); // Queue an unlinked node, returns a full batch to retire; stripe lock held
+    static void retireBatch(std::vector<Node*>* batch); // Hand a batch of unlinked nodes to EpochReclamation
+    bool overloaded(const Stripe& stripe, const BucketArray* array) const; // Whether a stripe holds more than its share of entries
+    void resize(BucketArray* expected); // Double the bucket array unless another thread already replaced expected
+    void lockAll(StripeLock (&locks)[STRIPES]); // Lock every stripe in index order
+
+    template <typename Update>
+    bool update(const K& key, Update makeValue); // Shared write path of insert, putIfAbsent and compute
+
+public:
+    ConcurrentHashTable(); // Default constructor
+    ~ConcurrentHashTable(); // Destructor, no other thread may use the table any more
+
+    ConcurrentHashTable(const ConcurrentHashTable&) = delete;
+    ConcurrentHashTable& operator=(const ConcurrentHashTable&) = delete;
+
+    void insert(const K& key, const V& value); // Insert or overwrite a value
+    bool putIfAbsent(const K& key, const V& value); // Insert only if the key is absent, returns whether it inserted
+    template <typename Func>
+    V compute(const K& key, Func func); // Atomically replace the value with func(pointer to current value or nullptr)
+    bool erase(const K& key); // Remove a key, returns whether it was present
+
+    V get(const K& key) const; // Get a copy of the value, throws KeyNotFoundException if absent
+    bool tryGet(const K& key, V& value) const; // Copy the value into value if present, never blocks
+    bool contains(const K& key) const; // Check whether a key is present, never blocks
+
+    template <typename Func>
+    void forEach(Func func) const; // Call func(key, value) for every entry, weakly consistent
+
+    size_t size() const; // Number of entries, exact only while no writer is active
+    bool isEmpty() const; // Check whether size() is 0
+    void clear(); // Remove every entry
+    size_t getTableSize() const; // Number of buckets
+};
+
+//==============================================================================|
+
+/**
+ * @brief Delete a retired bucket array and every node still linked from it.
+ */
+template <typename K, typename V, typename Hash>
+void ConcurrentHashTable<K, V, Hash>::BucketArray::destroyWithNodes(void* array) {
+    BucketArray* buckets = static_cast<BucketArray*>(array);
+    for (size_t i = 0; i <= buckets->mask; ++i) {
+        Node* node = buckets->heads[i].load(std::memory_order_relaxed);
+        while (node != nullptr) {
+            Node* next = node->next.load(std::memory_order_relaxed);
+            delete node;
+            node = next;
+        }
+    }
+    delete buckets;
+}
+
+/**
+ * @brief Default constructor.
+ */
+template <typename K, typename V, typename Hash>
+ConcurrentHashTable<K, V, Hash>::ConcurrentHashTable() : table(new BucketArray(INITIAL_TABLE_SIZE)), hashFunction() {
+}
+
+/**
+ * @brief Destructor. Frees the table directly, batches already retired are freed by EpochReclamation.
+ */
+template <typename K, typename V, typename Hash>
+ConcurrentHashTable<K, V, Hash>::~ConcurrentHashTable() {
+    BucketArray::destroyWithNodes(table.load(std::memory_order_relaxed));
+    for (Stripe& stripe : stripes) {
+        if (stripe.garbage != nullptr) {
+            for (Node* node : *stripe.garbage) {
+                delete node;
+            }
+            delete stripe.garbage;
+        }
+    }
+}
+
+/**
+ * @brief Find the node holding key in one bucket array.
+ *
+ * @details The caller is either pinned or holds the stripe lock of the key, so no node it reaches can be freed.
+ */
+template <typename K, typename V, typename Hash>
+typename ConcurrentHashTable<K, V, Hash>::Node* ConcurrentHashTable<K, V, Hash>::findNode(const BucketArray* array, const K& key, size_t hash) const {
+    for (Node* node = array->heads[hash & array->mask].load(std::memory_order_acquire); node != nullptr;
+         node = node->next.load(std::memory_order_acquire)) {
+        if (node->hash == hash && node->key == key) {
+            return node;
+        }
+    }
+    return nullptr;
+}
+
+/**
+ * @brief Queue a node that was just unlinked. The stripe lock must be held.
+ *
+ * @return A full batch that the caller must pass to retireBatch() after releasing the lock, or nullptr.
+ */
+template <typename K, typename V, typename Hash>
+std::vector<typename ConcurrentHashTable<K, V, Hash>::Node*>* ConcurrentHashTable<K, V, Hash>::discard(Stripe& stripe, Node* node) {
+    if (stripe.garbage == nullptr) {
+        stripe.garbage = new std::vector<Node*>();
+        stripe.garbage->reserve(GARBAGE_BATCH);
+    }
+    stripe.garbage->push_back(node);
+    if (stripe.garbage->size() < GARBAGE_BATCH) {
+        return nullptr;
+    }
+    std::vector<Node*>* batch = stripe.garbage;
+    stripe.garbage = nullptr;
+    return batch;
+}
+
+/**
+ * @brief Retire a batch of unlinked nodes with a single EpochReclamation call.
+ */
+template <typename K, typename V, typename Hash>
+void ConcurrentHashTable<K, V, Hash>::retireBatch(std::vector<Node*>* batch) {
+    if (batch == nullptr) {
+        return;
+    }
+    EpochReclamation::instance().retire(batch, [](void* nodes) {
+        std::vector<Node*>* list = static_cast<std::vector<Node*>*>(nodes);
+        for (Node* node : *list) {
+            delete node;
+        }
+        delete list;
+    });
+}
+
+/**
+ * @brief Check whether a stripe holds more than its share of LOAD_FACTOR entries per bucket.
+ */
+template <typename K, typename V, typename Hash>
+bool ConcurrentHashTable<K, V, Hash>::overloaded(const Stripe& stripe, const BucketArray* array) const {
+    return stripe.count.load(std::memory_order_relaxed) * STRIPES > (array->mask + 1) * LOAD_FACTOR;
+}
+
+/**
+ * @brief Lock every stripe. Always in index order, so two threads locking all stripes cannot deadlock.
+ */
+template <typename K, typename V, typename Hash>
+void ConcurrentHashTable<K, V, Hash>::lockAll(StripeLock (&locks)[STRIPES]) {
+    for (size_t i = 0; i < STRIPES; ++i) {
+        locks[i] = StripeLock(stripes[i].mutex);
+    }
+}
+
+/**
+ * @brief Replace the bucket array with one twice the size.
+ *
+ * @details Nodes are copied rather than relinked, because a reader may be walking an old chain right now and must
+ * still find every entry behind its position. Bucket j of the new array belongs to the same stripe as bucket
+ * j & mask of the old one, so the stripe counts stay valid.
+ *
+ * @param expected The array that was found overloaded. Nothing happens if another thread already replaced it.
+ */
+template <typename K, typename V, typename Hash>
+void ConcurrentHashTable<K, V, Hash>::resize(BucketArray* expected) {
+    BucketArray* old;
+    {
+        StripeLock locks[STRIPES];
+        lockAll(locks);
+        old = table.load(std::memory_order_relaxed);
+        if (old != expected) {
+            return;
+        }
+        if (old->mask + 1 >= static_cast<size_t>(std::numeric_limits<int>::max() / 2)) {
+            throw HashtableException("Cannot resize: maximum table size reached.");
+        }
+        BucketArray* grown = new BucketArray((old->mask + 1) * 2);
+        for (size_t i = 0; i <= old->mask; ++i) {
+            for (Node* node = old->heads[i].load(std::memory_order_relaxed); node != nullptr;
+                 node = node->next.load(std::memory_order_relaxed)) {
+                std::atomic<Node*>& head = grown->heads[node->hash & grown->mask];
+                head.store(new Node(node->key, node->value, node->hash, head.load(std::memory_order_relaxed)), std::memory_order_relaxed);
+            }
+        }
+        table.store(grown, std::memory_order_release);
+    }
+    EpochReclamation::instance().retire(old, &BucketArray::destroyWithNodes);
+}
+
+/**
+ * @brief Shared write path: link a node with a new value in place of the current one, or in front of the chain.
+ *
+ * @param makeValue Called under the stripe lock with a pointer to the current value, or nullptr if the key is
+ * absent. It stores the new value through its second argument and returns false to leave the table unchanged.
+ * @return Whether the table was changed.
+ */
+template <typename K, typename V, typename Hash>
+template <typename Update>
+bool ConcurrentHashTable<K, V, Hash>::update(const K& key, Update makeValue) {
+    size_t hash = hashOf(key);
+    Stripe& stripe = stripeOf(hash);
+    std::vector<Node*>* batch = nullptr;
+    BucketArray* array;
+    bool grow = false;
+    {
+        StripeLock lock(stripe.mutex);
+        // The array cannot be replaced while this stripe is locked
+        array = table.load(std::memory_order_acquire);
+        std::atomic<Node*>& head = array->heads[hash & array->mask];
+        std::atomic<Node*>* link = &head;
+        Node* current = link->load(std::memory_order_relaxed);
+        while (current != nullptr && !(current->hash == hash && current->key == key)) {
+            link = &current->next;
+            current = link->load(std::memory_order_relaxed);
+        }
+
+        const V* existing = current ? &current->value : nullptr;
+        V value{};
+        if (!makeValue(existing, value)) {
+            return false;
+        }
+        if (current != nullptr) {
+            Node* replacement = new Node(key, value, hash, current->next.load(std::memory_order_relaxed));
+            link->store(replacement, std::memory_order_release);
+            batch = discard(stripe, current);
+        } else {
+            head.store(new Node(key, value, hash, head.load(std::memory_order_relaxed)), std::memory_order_release);
+            stripe.count.store(stripe.count.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            grow = overloaded(stripe, array);
+        }
+    }
+    retireBatch(batch);
+    if (grow) {
+        resize(array);
+    }
+    return true;
+}
+
+/**
+ * @brief Insert a key, overwriting its value if it is already present.
+ */
+template <typename K, typename V, typename Hash>
+void ConcurrentHashTable<K, V, Hash>::insert(const K& key, const V& value) {
+    update(key, [&](const V*, V& result) {
+        result = value;
+        return true;
+    });
+}
+
+/**
+ * @brief Insert a key only if it is not present yet. Checking and inserting is one atomic step.
+ *
+ * @return true if the value was inserted, false if the key was already present.
+ */
+template <typename K, typename V, typename Hash>
+bool ConcurrentHashTable<K, V, Hash>::putIfAbsent(const K& key, const V& value) {
+    return update(key, [&](const V* existing, V& result) {
+        if (existing != nullptr) {
+            return false;
+        }
+        result = value;
+        return true;
+    });
+}
+
+/**
+ * @brief Atomically replace the value of a key with one computed from the current value.
+ *
+ * @details func runs while the stripe of the key is locked, so it must be short and must not use this table.
+ *
+ * @param func Called as func(const V* current) with nullptr if the key is absent, returns the new value.
+ * @return The new value.
+ */
+template <typename K, typename V, typename Hash>
+template <typename Func>
+V ConcurrentHashTable<K, V, Hash>::compute(const K& key, Func func) {
+    V computed{};
+    update(key, [&](const V* existing, V& result) {
+        result = func(existing);
+        computed = result;
+        return true;
+    });
+    return computed;
+}
+
+/**
+ * @brief Remove a key.
+ *
+ * @return true if the key was present.
+ */
+template <typename K, typename V, typename Hash>
+bool ConcurrentHashTable<K, V, Hash>::erase(const K& key) {
+    size_t hash = hashOf(key);
+    Stripe& stripe = stripeOf(hash);
+    std::vector<Node*>* batch;
+    {
+        StripeLock lock(stripe.mutex);
+        BucketArray* array = table.load(std::memory_order_acquire);
+        std::atomic<Node*>* link = &array->heads[hash & array->mask];
+        Node* current = link->load(std::memory_order_relaxed);
+        while (current != nullptr && !(current->hash == hash && current->key == key)) {
+            link = &current->next;
+            current = link->load(std::memory_order_relaxed);
+        }
+        if (current == nullptr) {
+            return false;
+        }
+        link->store(current->next.load(std::memory_order_relaxed), std::memory_order_release);
+        stripe.count.store(stripe.count.load(std::memory_order_relaxed) - 1, std::memory_order_relaxed);
+        batch = discard(stripe, current);
+    }
+    retireBatch(batch);
+    return true;
+}
+
+/**
+ * @brief Get a copy of the value of a key.
+ *
+ * @throws KeyNotFoundException if the key is absent.
+ */
+template <typename K, typename V, typename Hash>
+V ConcurrentHashTable<K, V, Hash>::get(const K& key) const {
+    V value;
+    if (!tryGet(key, value)) {
+        throw KeyNotFoundException("Key not found in hash table. Key: " + to_string_helper(key));
+    }
+    return value;
+}
+
+/**
+ * @brief Copy the value of a key if it is present. Never locks and never waits for writers.
+ *
+ * @return true if the key was found and value was assigned.
+ */
+template <typename K, typename V, typename Hash>
+bool ConcurrentHashTable<K, V, Hash>::tryGet(const K& key, V& value) const {
+    size_t hash = hashOf(key);
+    EpochReclamation::Guard guard = EpochReclamation::instance().pin();
+    Node* node = findNode(table.load(std::memory_order_acquire), key, hash);
+    if (node == nullptr) {
+        return false;
+    }
+    value = node->value;
+    return true;
+}
+
+/**
+ * @brief Check whether a key is present. Never locks and never waits for writers.
+ */
+template <typename K, typename V, typename Hash>
+bool ConcurrentHashTable<K, V, Hash>::contains(const K& key) const {
+    size_t hash = hashOf(key);
+    EpochReclamation::Guard guard = EpochReclamation::instance().pin();
+    return findNode(table.load(std::memory_order_acquire), key, hash) != nullptr;
+}
+
+/**
+ * @brief Call func(key, value) for every entry of the current bucket array without locking.
+ */
+template <typename K, typename V, typename Hash>
+template <typename Func>
+void ConcurrentHashTable<K, V, Hash>::forEach(Func func) const {
+    EpochReclamation::Guard guard = EpochReclamation::instance().pin();
+    const BucketArray* array = table.load(std::memory_order_acquire);
+    for (size_t i = 0; i <= array->mask; ++i) {
+        for (Node* node = array->heads[i].load(std::memory_order_acquire); node != nullptr;
+             node = node->next.load(std::memory_order_acquire)) {
+            func(node->key, node->value);
+        }
+    }
+}
+
+/**
+ * @brief Get the number of entries. Concurrent writers may make the result stale immediately.
+ */
+template <typename K, typename V, typename Hash>
+size_t ConcurrentHashTable<K, V, Hash>::size() const {
+    size_t total = 0;
+    for (const Stripe& stripe : stripes) {
+        total += stripe.count.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+/**
+ * @brief Check whether the table is empty.
+ */
+template <typename K, typename V, typename Hash>
+bool ConcurrentHashTable<K, V, Hash>::isEmpty() const {
+    return size() == 0;
+}
+
+/**
+ * @brief Remove every entry by publishing a fresh bucket array. Readers still on the old one finish undisturbed.
+ */
+template <typename K, typename V, typename Hash>
+void ConcurrentHashTable<K, V, Hash>::clear() {
+    BucketArray* old;
+    {
+        StripeLock locks[STRIPES];
+        lockAll(locks);
+        old = table.load(std::memory_order_relaxed);
+        table.store(new BucketArray(INITIAL_TABLE_SIZE), std::memory_order_release);
+        for (Stripe& stripe : stripes) {
+            stripe.count.store(0, std::memory_order_relaxed);
+        }
+    }
+    EpochReclamation::instance().retire(old, &BucketArray::destroyWithNodes);
+}
+
+/**
+ * @brief Get the number of buckets.
+ */
+template <typename K, typename V, typename Hash>
+size_t ConcurrentHashTable<K, V, Hash>::getTableSize() const {
+    return table.load(std::memory_order_acquire)->mask + 1;
+}
+
+#endif // CONCURRENTHASHTABLE_H
@@ -0,0 +1,275 @@
+#ifndef EPOCHRECLAMATION_H
+#define EPOCHRECLAMATION_H
+
+#include <atomic>
+#include <cstdint>
+#include <iostream>
+#include <mutex>
+#include <vector>
+
+//#define DEBUG
+
+//==============================================================================|
+
+/**
+ * @brief Epoch-based reclamation for data structures whose readers never take locks.
+ *
+ * @details A reader pins the current epoch for as long as it looks at shared data. Pinning is a plain store to a
+ * slot owned by the reading thread, followed by a memory fence, so readers never write to a shared cache line and
+ * never use atomic read-modify-write operations.
+ *
+ * A writer first unlinks an object so that new readers cannot reach it. It then retires the object, which advances
+ * the global epoch and tags the object with it. The object is deleted once no reader is pinned at an older epoch,
+ * because only such readers could still hold a pointer to it.
+ *
+ * There is one process-wide instance. Each thread gets a reader slot on first use, which is handed to another
+ * thread when it exits. Slots are never freed, so they stay valid during thread and static destruction.
+ */
+class EpochReclamation {
+private:
+    /**
+     * @brief Per-thread reader state, padded to its own cache line.
+     */
+    struct alignas(64) ReaderSlot {
+        std::atomic<uint64_t> epoch; // Epoch pinned by the owning thread, 0 while it is not reading
+        std::atomic<bool> owned; // Set while a live thread uses this slot
+        unsigned int depth; // Nesting depth of guards; only touched by the owning thread
+        ReaderSlot* next; // Next slot in the registry, immutable once published
+
+        ReaderSlot() : epoch(0), owned(true), depth(0), next(nullptr) {}
+    };
+
+    /**
+     * @brief An object waiting until no reader can reference it.
+     */
+    struct Retired {
+        void* object;
+        void (*deleter)(void*);
+        uint64_t epoch;
+    };
+
+    /**
+     * @brief Releases the slot of a thread when the thread exits.
+     */
+    struct ThreadSlot {
+        ReaderSlot* slot = nullptr;
+        ~ThreadSlot() {
+            if (slot != nullptr) {
+                slot->epoch.store(0, std::memory_order_release);
+                slot->owned.store(false, std::memory_order_release);
+            }
+        }
+    };
+
+    std::atomic<uint64_t> globalEpoch; // Current epoch, starts at 1 because 0 marks an idle reader
+    std::atomic<ReaderSlot*> slots; // Registry of reader slots, new slots are pushed at the head
+    std::mutex retiredMutex; // Protects retired; only writers take it
+    std::vector<Retired> retired; // Objects waiting to be deleted
+
+    EpochReclamation() : globalEpoch(1), slots(nullptr) {}
+
+    ReaderSlot* localSlot(); // Get the reader slot of the calling thread, claiming one if needed
+    uint64_t oldestPinnedEpoch(); // Smallest epoch pinned by any reader, or UINT64_MAX if none is reading
+    std::vector<Retired> takeReclaimable(); // Remove every retired object no reader can reach from the list; retiredMutex must be held
+    static void destroy(const std::vector<Retired>& objects); // Run the deleters, outside the lock so they may retire more objects
+
+public:
+    EpochReclamation(const EpochReclamation&) = delete;
+    EpochReclamation& operator=(const EpochReclamation&) = delete;
+
+    static EpochReclamation& instance(); // Get the process-wide instance
+
+    class Guard; // RAII reader critical section
+
+    Guard pin(); // Enter a reader critical section
+    template <typename U>
+    void retire(U* object); // Delete object once no reader can still reference it
+    void retire(void* object, void (*deleter)(void*)); // Call deleter(object) once no reader can still reference it
+    void collect(); // Delete every retired object that is no longer reachable
+    size_t pendingCount(); // Number of retired objects not deleted yet
+};
+
+//==============================================================================|
+
+/**
+ * @brief Keeps the calling thread pinned for its lifetime.
+ *
+ * @details Pointers loaded from an epoch-protected structure while a guard is alive stay valid until the guard is destroyed.
+ * Guards may be nested. A guard must be destroyed on the thread that created it.
+ */
+class EpochReclamation::Guard {
+private:
+    ReaderSlot* slot;
+
+public:
+    explicit Guard(ReaderSlot* readerSlot) : slot(readerSlot) {}
+    Guard(Guard&& other) noexcept : slot(other.slot) { other.slot = nullptr; }
+    Guard(const Guard&) = delete;
+    Guard& operator=(const Guard&) = delete;
+    Guard& operator=(Guard&&) = delete;
+
+    ~Guard() {
+        if (slot != nullptr && --slot->depth == 0) {
+            slot->epoch.store(0, std::memory_order_release);
+        }
+    }
+};
+
+/**
+ * @brief Get the process-wide instance.
+ *
+ * @details The instance is intentionally never destroyed, so threads that exit during static destruction can still release their slot.
+ */
+inline EpochReclamation& EpochReclamation::instance() {
+    static EpochReclamation* reclamation = new EpochReclamation();
+    return *reclamation;
+}
+
+/**
+ * @brief Get the reader slot of the calling thread.
+ *
+ * @details On first use a thread takes over a slot released by an exited thread, or pushes a new one onto the registry.
+ * This is the only place readers use read-modify-write operations, and it runs once per thread.
+ */
+inline EpochReclamation::ReaderSlot* EpochReclamation::localSlot() {
+    static thread_local ThreadSlot threadSlot;
+    if (threadSlot.slot != nullptr) {
+        return threadSlot.slot;
+    }
+    for (ReaderSlot* slot = slots.load(std::memory_order_acquire); slot != nullptr; slot = slot->next) {
+        bool expected = false;
+        if (!slot->owned.load(std::memory_order_relaxed) && slot->owned.compare_exchange_strong(expected, true, std::memory_order_acquire)) {
+            threadSlot.slot = slot;
+            return slot;
+        }
+    }
+    ReaderSlot* slot = new ReaderSlot();
+    ReaderSlot* head = slots.load(std::memory_order_relaxed);
+    do {
+        slot->next = head;
+    } while (!slots.compare_exchange_weak(head, slot, std::memory_order_release, std::memory_order_relaxed));
+    threadSlot.slot = slot;
+    return slot;
+}
+
+/**
+ * @brief Enter a reader critical section.
+ *
+ * @details The current epoch is stored in the thread's own slot, followed by a full fence. The fence pairs with the
+ * fence in oldestPinnedEpoch(): either the writer sees this reader as pinned, or this reader sees everything the
+ * writer unlinked before retiring.
+ *
+ * @return A guard that ends the critical section when destroyed.
+ */
+inline EpochReclamation::Guard EpochReclamation::pin() {
+    ReaderSlot* slot = localSlot();
+    if (slot->depth++ == 0) {
+        slot->epoch.store(globalEpoch.load(std::memory_order_acquire), std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+    }
+    return Guard(slot);
+}
+
+/**
+ * @brief Get the smallest epoch pinned by any reader.
+ *
+ * @return The oldest pinned epoch, or UINT64_MAX if no reader is inside a critical section.
+ */
+inline uint64_t EpochReclamation::oldestPinnedEpoch() {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    uint64_t oldest = UINT64_MAX;
+    for (ReaderSlot* slot = slots.load(std::memory_order_acquire); slot != nullptr; slot = slot->next) {
+        uint64_t pinned = slot->epoch.load(std::memory_order_acquire);
+        if (pinned != 0 && pinned < oldest) {
+            oldest = pinned;
+        }
+    }
+    return oldest;
+}
+
+/**
+ * @brief Delete an object once no reader can still reference it.
+ *
+ * @details The object must already be unreachable for new readers. Deletion happens in a later call to
+ * retire() or collect(), possibly on another thread.
+ *
+ * @param object The object to delete with operator delete.
+ */
+template <typename U>
+void EpochReclamation::retire(U* object) {
+    retire(static_cast<void*>(object), [](void* p) { delete static_cast<U*>(p); });
+}
+
+/**
+ * @brief Call a deleter on an object once no reader can still reference it.
+ *
+ * @param object The object to release.
+ * @param deleter The function that releases it.
+ */
+inline void EpochReclamation::retire(void* object, void (*deleter)(void*)) {
+    std::vector<Retired> reclaimable;
+    {
+        std::lock_guard<std::mutex> lock(retiredMutex);
+        // Readers pinned from now on start at the new epoch and cannot have seen the object.
+        uint64_t epoch = globalEpoch.fetch_add(1, std::memory_order_acq_rel) + 1;
+        retired.push_back(Retired{object, deleter, epoch});
+        reclaimable = takeReclaimable();
+    }
+    destroy(reclaimable);
+}
+
+/**
+ * @brief Delete every retired object that no reader can reach any more.
+ */
+inline void EpochReclamation::collect() {
+    std::vector<Retired> reclaimable;
+    {
+        std::lock_guard<std::mutex> lock(retiredMutex);
+        reclaimable = takeReclaimable();
+    }
+    destroy(reclaimable);
+}
+
+/**
+ * @brief Remove every retired object that no reader can reach from the retired list. retiredMutex must be held.
+ *
+ * @details An object retired at epoch E is unreachable once every pinned reader has pinned E or later.
+ *
+ * @return The objects that can be deleted.
+ */
+inline std::vector<EpochReclamation::Retired> EpochReclamation::takeReclaimable() {
+    uint64_t oldest = oldestPinnedEpoch();
+    std::vector<Retired> reclaimable;
+    size_t kept = 0;
+    for (size_t i = 0; i < retired.size(); i++) {
+        if (retired[i].epoch <= oldest) {
+            reclaimable.push_back(retired[i]);
+        } else {
+            retired[kept++] = retired[i];
+        }
+    }
+    retired.resize(kept);
+    #ifdef DEBUG
+    std::cout << "Reclaiming " << reclaimable.size() << " objects" << std::endl;
+    #endif
+    return reclaimable;
+}
+
+/**
+ * @brief Run the deleters of the given objects.
+ */
+inline void EpochReclamation::destroy(const std::vector<Retired>& objects) {
+    for (const Retired& object : objects) {
+        object.deleter(object.object);
+    }
+}
+
+/**
+ * @brief Get the number of retired objects that have not been deleted yet.
+ */
+inline size_t EpochReclamation::pendingCount() {
+    std::lock_guard<std::mutex> lock(retiredMutex);
+    return retired.size();
+}
+
+#endif // EPOCHRECLAMATION_H
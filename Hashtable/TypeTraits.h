@@ -3,6 +3,8 @@
 
 #include <string>
 #include <cstddef>
+#include <utility>
+#include <vector>
 
 template <typename T>
 struct TypeTraits {
@@ -0,0 +1,71 @@
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+// Replaces every form of the global operator new and delete for the allocation_test binary, counting allocations
+// so a test can check that a code path does not allocate. This file is its own translation unit so the replaced
+// operators are never inlined into the code that uses them.
+
+static std::atomic<size_t> allocations(0);
+
+size_t allocationCount() {
+    return allocations.load();
+}
+
+static void* allocate(size_t size, size_t alignment) {
+    allocations++;
+    if (size == 0) {
+        size = 1;
+    }
+    if (alignment <= alignof(std::max_align_t)) {
+        return std::malloc(size);
+    }
+#ifdef _WIN32
+    return _aligned_malloc(size, alignment);
+#else
+    void* memory = nullptr;
+    return posix_memalign(&memory, alignment, size) == 0 ? memory : nullptr;
+#endif
+}
+
+static void release(void* memory, size_t alignment) noexcept {
+#ifdef _WIN32
+    if (alignment > alignof(std::max_align_t)) {
+        _aligned_free(memory);
+        return;
+    }
+#else
+    (void)alignment;
+#endif
+    std::free(memory);
+}
+
+static void* allocateOrThrow(size_t size, size_t alignment) {
+    if (void* memory = allocate(size, alignment)) {
+        return memory;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new(size_t size) { return allocateOrThrow(size, 0); }
+void* operator new[](size_t size) { return allocateOrThrow(size, 0); }
+void* operator new(size_t size, const std::nothrow_t&) noexcept { return allocate(size, 0); }
+void* operator new[](size_t size, const std::nothrow_t&) noexcept { return allocate(size, 0); }
+void* operator new(size_t size, std::align_val_t alignment) { return allocateOrThrow(size, static_cast<size_t>(alignment)); }
+void* operator new[](size_t size, std::align_val_t alignment) { return allocateOrThrow(size, static_cast<size_t>(alignment)); }
+void* operator new(size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept { return allocate(size, static_cast<size_t>(alignment)); }
+void* operator new[](size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept { return allocate(size, static_cast<size_t>(alignment)); }
+
+void operator delete(void* memory) noexcept { release(memory, 0); }
+void operator delete[](void* memory) noexcept { release(memory, 0); }
+void operator delete(void* memory, size_t) noexcept { release(memory, 0); }
+void operator delete[](void* memory, size_t) noexcept { release(memory, 0); }
+void operator delete(void* memory, const std::nothrow_t&) noexcept { release(memory, 0); }
+void operator delete[](void* memory, const std::nothrow_t&) noexcept { release(memory, 0); }
+void operator delete(void* memory, std::align_val_t alignment) noexcept { release(memory, static_cast<size_t>(alignment)); }
+void operator delete[](void* memory, std::align_val_t alignment) noexcept { release(memory, static_cast<size_t>(alignment)); }
+void operator delete(void* memory, size_t, std::align_val_t alignment) noexcept { release(memory, static_cast<size_t>(alignment)); }
+void operator delete[](void* memory, size_t, std::align_val_t alignment) noexcept { release(memory, static_cast<size_t>(alignment)); }
+void operator delete(void* memory, std::align_val_t alignment, const std::nothrow_t&) noexcept { release(memory, static_cast<size_t>(alignment)); }
+void operator delete[](void* memory, std::align_val_t alignment, const std::nothrow_t&) noexcept { release(memory, static_cast<size_t>(alignment)); }
@@ -0,0 +1,75 @@
+#include <gtest/gtest.h>
+#include "HashTable.h"
+#include <string>
+#include <vector>
+
+// Tests that count heap allocations. They live in their own binary because allocation_counter.cc replaces the global
+// operator new and delete for the whole program.
+
+size_t allocationCount(); // Defined in allocation_counter.cc
+
+template <typename Storage>
+void expectMissesDoNotAllocate() {
+    HashTable<std::string, int, KeyHash<std::string>, Storage> table;
+    for (int i = 0; i < 100; i++) {
+        table.insert("present" + std::to_string(i), i);
+    }
+    std::vector<std::string> missing;
+    for (int i = 0; i < 100; i++) {
+        missing.push_back("missing" + std::to_string(i));
+    }
+
+    size_t before = allocationCount();
+    for (const std::string& key : missing) {
+        EXPECT_TRUE(table.find(key) == table.end());
+        EXPECT_EQ(table.tryGet(key), nullptr);
+        EXPECT_FALSE(table.erase(key));
+        EXPECT_FALSE(table.contains(key));
+    }
+    EXPECT_EQ(allocationCount(), before);
+
+    int* value = table.tryGet("present7");
+    ASSERT_NE(value, nullptr);
+    *value = 70;
+    EXPECT_EQ(table.get("present7"), 70);
+    EXPECT_EQ((*table.find("present8")).value, 8);
+    EXPECT_TRUE(table.erase("present7"));
+    EXPECT_EQ(table.tryGet("present7"), nullptr);
+    EXPECT_EQ(table.size(), 99);
+}
+
+TEST(HashTableLookup, MissesDoNotThrowOrAllocate) {
+    expectMissesDoNotAllocate<ChainedStorage>();
+    expectMissesDoNotAllocate<IncrementalChainedStorage>();
+    expectMissesDoNotAllocate<RobinHoodStorage>();
+}
+
+template <typename Storage>
+void expectIterationDoesNotAllocate() {
+    HashTable<std::string, std::string, KeyHash<std::string>, Storage> table;
+    for (int i = 0; i < 100; i++) {
+        table.insert("a key long enough to live on the heap " + std::to_string(i), std::string(100, 'v'));
+    }
+    const auto& constTable = table;
+
+    size_t before = allocationCount();
+    size_t characters = 0;
+    for (const auto& kv : table) {
+        characters += kv.key.size() + kv.value.size();
+    }
+    for (auto it = constTable.cbegin(); it != constTable.cend(); ++it) {
+        characters += it->first().size() + it->second().size();
+    }
+    EXPECT_EQ(allocationCount(), before);
+    EXPECT_GT(characters, 2u * 100 * 100);
+}
+
+TEST(HashTableIteration, FullIterationDoesNotAllocate) {
+    expectIterationDoesNotAllocate<ChainedStorage>();
+    expectIterationDoesNotAllocate<RobinHoodStorage>();
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,251 @@
+#include "Hashtable.h"
+#include "ConcurrentHashTable.h"
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <mutex>
+#include <thread>
+
+// Simple micro benchmarks for HashTable and its hash functions. Build the "hashtable_benchmark" target in Release
+// mode and run it directly.
+
+static const unsigned int KEYS = 200000;
+static const int ROUNDS = 10;
+static const unsigned long BUCKETS = 1 << 18;
+
+template <typename Func>
+double nanosecondsPerKey(Func func) {
+    auto start = std::chrono::steady_clock::now();
+    for (int round = 0; round < ROUNDS; round++) {
+        func();
+    }
+    auto stop = std::chrono::steady_clock::now();
+    double total = std::chrono::duration<double, std::nano>(stop - start).count();
+    return total / (static_cast<double>(KEYS) * ROUNDS);
+}
+
+// Hash speed, and how many keys share a bucket with an earlier key when the low bits pick one of BUCKETS buckets
+template <typename Hash, typename K>
+void benchmarkHash(const char* name, const std::vector<K>& keys) {
+    Hash hash;
+    volatile uint64_t sink = 0;
+    double perKey = nanosecondsPerKey([&]() {
+        uint64_t combined = 0;
+        for (const K& key : keys) {
+            combined ^= hash(key);
+        }
+        sink = sink + combined;
+    });
+
+    std::vector<unsigned int> load(BUCKETS, 0);
+    unsigned int collisions = 0;
+    unsigned int longest = 0;
+    for (const K& key : keys) {
+        unsigned int& bucket = load[hash(key) & (BUCKETS - 1)];
+        collisions += bucket > 0;
+        longest = std::max(longest, ++bucket);
+    }
+    std::printf("  %-40s %6.2f ns/key   collisions: %7u   longest bucket: %6u\n", name, perKey, collisions, longest);
+}
+
+// Insert every key, then look every key up
+template <typename Table, typename K>
+void benchmarkTable(const char* name, const std::vector<K>& keys) {
+    volatile long long sink = 0;
+    double inserted = nanosecondsPerKey([&]() {
+        Table table;
+        for (unsigned int i = 0; i < keys.size(); i++) {
+            table.insert(keys[i], static_cast<int>(i));
+        }
+    });
+
+    Table table;
+    for (unsigned int i = 0; i < keys.size(); i++) {
+        table.insert(keys[i], static_cast<int>(i));
+    }
+    double found = nanosecondsPerKey([&]() {
+        long long sum = 0;
+        for (const K& key : keys) {
+            sum += table.get(key);
+        }
+        sink = sink + sum;
+    });
+    std::printf("  %-40s insert: %7.2f ns/key   get: %7.2f ns/key\n", name, inserted, found);
+}
+
+// Remove and re-insert keys of a full table, every remove frees a node and every insert allocates one
+template <typename Table, typename K>
+void benchmarkChurn(const char* name, const std::vector<K>& keys) {
+    Table table;
+    for (unsigned int i = 0; i < keys.size(); i++) {
+        table.insert(keys[i], static_cast<int>(i));
+    }
+    double churned = nanosecondsPerKey([&]() {
+        for (unsigned int i = 0; i < keys.size(); i++) {
+            table.remove(keys[i]);
+            table.insert(keys[i], static_cast<int>(i));
+        }
+    });
+    double cleared = nanosecondsPerKey([&]() {
+        Table scratch;
+        for (unsigned int i = 0; i < keys.size(); i++) {
+            scratch.insert(keys[i], static_cast<int>(i));
+        }
+        scratch.clear();
+    });
+    std::printf("  %-40s remove+insert: %7.2f ns/key   fill+clear: %7.2f ns/key\n", name, churned, cleared);
+}
+
+// Time every single insert while a table grows to LATENCY_KEYS keys and report the latency percentiles
+template <typename Table>
+void benchmarkInsertLatency(const char* name) {
+    static const unsigned int LATENCY_KEYS = 4000000;
+    std::vector<double> latencies;
+    latencies.reserve(LATENCY_KEYS);
+    Table table;
+    for (unsigned int i = 0; i < LATENCY_KEYS; i++) {
+        auto start = std::chrono::steady_clock::now();
+        table.insert(static_cast<int>(i), static_cast<int>(i));
+        auto stop = std::chrono::steady_clock::now();
+        latencies.push_back(std::chrono::duration<double, std::nano>(stop - start).count());
+    }
+    std::sort(latencies.begin(), latencies.end());
+    auto percentile = [&](double p) { return latencies[static_cast<size_t>(p * (latencies.size() - 1))]; };
+    std::printf("  %-40s p50: %7.0f ns   p99: %7.0f ns   p99.99: %9.0f ns   max: %11.0f ns\n", name,
+                percentile(0.5), percentile(0.99), percentile(0.9999), latencies.back());
+}
+
+// HashTable behind one global mutex, the setup ConcurrentHashTable replaces
+class LockedHashTable {
+private:
+    HashTable<int, int, FastHash<int>> table;
+    std::mutex mutex;
+
+public:
+    void insert(int key, int value) {
+        std::lock_guard<std::mutex> lock(mutex);
+        table.insert(key, value);
+    }
+    bool tryGet(int key, int& value) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!table.contains(key)) {
+            return false;
+        }
+        value = table.get(key);
+        return true;
+    }
+};
+
+// Million operations per second for threads sharing one table, readPercent of the operations are lookups
+template <typename Table>
+double operationsPerSecond(Table& table, unsigned int threads, unsigned int readPercent) {
+    static const unsigned int OPERATIONS = 1000000;
+    static const unsigned int KEY_RANGE = 100000;
+    unsigned int perThread = OPERATIONS / threads;
+    std::vector<std::thread> workers;
+    auto start = std::chrono::steady_clock::now();
+    for (unsigned int t = 0; t < threads; t++) {
+        workers.emplace_back([&table, perThread, readPercent, t]() {
+            std::mt19937 random(t + 1);
+            int value = 0;
+            long long found = 0;
+            for (unsigned int i = 0; i < perThread; i++) {
+                int key = static_cast<int>(random() % KEY_RANGE);
+                if (random() % 100 < readPercent) {
+                    found += table.tryGet(key, value);
+                } else {
+                    table.insert(key, static_cast<int>(i));
+                }
+            }
+            volatile long long sink = found;
+            (void)sink;
+        });
+    }
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+    auto stop = std::chrono::steady_clock::now();
+    double seconds = std::chrono::duration<double>(stop - start).count();
+    return perThread * threads / seconds / 1e6;
+}
+
+void benchmarkConcurrentScaling() {
+    std::printf("Concurrent scaling (%u hardware threads), Mops/s: global mutex / ConcurrentHashTable\n", std::thread::hardware_concurrency());
+    const unsigned int readPercents[] = {100, 90, 50};
+    for (unsigned int threads = 1; threads <= 64; threads *= 2) {
+        std::printf("  %2u threads", threads);
+        for (unsigned int readPercent : readPercents) {
+            LockedHashTable locked;
+            ConcurrentHashTable<int, int, FastHash<int>> concurrent;
+            for (int key = 0; key < 100000; key += 2) {
+                locked.insert(key, key);
+                concurrent.insert(key, key);
+            }
+            double lockedRate = operationsPerSecond(locked, threads, readPercent);
+            double concurrentRate = operationsPerSecond(concurrent, threads, readPercent);
+            std::printf("   %3u%% reads: %6.2f / %6.2f", readPercent, lockedRate, concurrentRate);
+        }
+        std::printf("\n");
+    }
+}
+
+int main() {
+    std::mt19937_64 random(42);
+
+    std::vector<int> sequential, strided;
+    for (unsigned int i = 0; i < KEYS; i++) {
+        sequential.push_back(static_cast<int>(i));
+        strided.push_back(static_cast<int>(i * 4096));
+    }
+
+    std::vector<std::string> shortStrings, longStrings;
+    for (unsigned int i = 0; i < KEYS; i++) {
+        shortStrings.push_back("key" + std::to_string(i));
+        std::string text(200, ' ');
+        for (char& c : text) {
+            c = static_cast<char>('a' + random() % 26);
+        }
+        longStrings.push_back(text);
+    }
+
+    std::vector<double> doubles;
+    for (unsigned int i = 0; i < KEYS; i++) {
+        doubles.push_back(i * 0.5);
+    }
+
+    std::printf("Hash functions (%u keys, %lu buckets)\n", KEYS, BUCKETS);
+    benchmarkHash<KeyHash<int>>("KeyHash<int> sequential", sequential);
+    benchmarkHash<FastHash<int>>("FastHash<int> sequential", sequential);
+    benchmarkHash<KeyHash<int>>("KeyHash<int> stride 4096", strided);
+    benchmarkHash<FastHash<int>>("FastHash<int> stride 4096", strided);
+    benchmarkHash<KeyHash<std::string>>("KeyHash<string> \"key<n>\"", shortStrings);
+    benchmarkHash<FastHash<std::string>>("FastHash<string> \"key<n>\"", shortStrings);
+    benchmarkHash<KeyHash<std::string>>("KeyHash<string> 200 bytes", longStrings);
+    benchmarkHash<FastHash<std::string>>("FastHash<string> 200 bytes", longStrings);
+    benchmarkHash<KeyHash<double>>("KeyHash<double> multiples of 0.5", doubles);
+    benchmarkHash<FastHash<double>>("FastHash<double> multiples of 0.5", doubles);
+
+    std::printf("HashTable (%u keys, %d rounds)\n", KEYS, ROUNDS);
+    benchmarkTable<HashTable<int, int>>("chained, KeyHash<int> stride 4096", strided);
+    benchmarkTable<HashTable<int, int, FastHash<int>>>("chained, FastHash<int> stride 4096", strided);
+    benchmarkTable<HashTable<int, int, FastHash<int>, RobinHoodStorage>>("robin hood, FastHash<int> stride 4096", strided);
+    benchmarkTable<HashTable<std::string, int>>("chained, KeyHash<string>", longStrings);
+    benchmarkTable<HashTable<std::string, int, FastHash<std::string>>>("chained, FastHash<string>", longStrings);
+    benchmarkTable<HashTable<std::string, int, FastHash<std::string>, RobinHoodStorage>>("robin hood, FastHash<string>", longStrings);
+
+    std::printf("Node churn (%u keys, %d rounds)\n", KEYS, ROUNDS);
+    benchmarkChurn<HashTable<int, int, FastHash<int>>>("chained, heap nodes", sequential);
+    benchmarkChurn<HashTable<int, int, FastHash<int>, PooledChainedStorage>>("chained, pooled nodes", sequential);
+    benchmarkChurn<HashTable<std::string, int, FastHash<std::string>>>("chained, heap nodes, strings", shortStrings);
+    benchmarkChurn<HashTable<std::string, int, FastHash<std::string>, PooledChainedStorage>>("chained, pooled nodes, strings", shortStrings);
+
+    std::printf("Insert latency while growing\n");
+    benchmarkInsertLatency<HashTable<int, int, FastHash<int>>>("chained, rehash at once");
+    benchmarkInsertLatency<HashTable<int, int, FastHash<int>, IncrementalChainedStorage>>("chained, incremental rehash");
+    benchmarkConcurrentScaling();
+    return 0;
+}
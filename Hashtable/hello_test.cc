@@ -1,6 +1,12 @@
 #include <gtest/gtest.h>
 #include "HashTable.h" // Make sure this path is correct
 #include "SimpleVector.h"
+#include "ConcurrentHashTable.h"
+#include <map>
+#include <set>
+#include <atomic>
+#include <thread>
+#include <vector>
 
 class HashTableTest : public ::testing::Test {
 protected:
@@ -110,6 +116,24 @@ TEST_F(HashTableTest, GetKeysAndValues) {
         EXPECT_EQ(ht.get(keys[i]), values[i]);
     }
 }
+
+TEST_F(HashTableTest, GetKeysOnSmallTableStaysInline) {
+    ht.insert("one", 1);
+    ht.insert("two", 2);
+
+    auto keys = ht.getKeys();
+    auto values = ht.getValues();
+    EXPECT_TRUE(keys.isInline());
+    EXPECT_TRUE(values.isInline());
+    EXPECT_EQ(keys.elements(), 2);
+
+    for (int i = 0; i < 20; i++) {
+        ht.insert("key" + std::to_string(i), i);
+    }
+    auto manyKeys = ht.getKeys();
+    EXPECT_FALSE(manyKeys.isInline());
+    EXPECT_EQ(manyKeys.elements(), 22);
+}
 TEST(HashTableDifferentTypes, IntStringHashTable) {
     HashTable<int, std::string> ht;
     ht.insert(1, "one");
@@ -145,6 +169,484 @@ TEST_F(HashTableTest, EdgeCases) {
     EXPECT_THROW(ht.get("non-existent"), KeyNotFoundException);
 }
 
+// Sends every key to one of four home slots, so Robin Hood probing and backward shifts run on long clusters.
+struct ClusteringHash {
+    unsigned long operator()(const int& key) const {
+        return static_cast<unsigned long>(key % 4);
+    }
+};
+
+TEST(HashTableRobinHood, SameApiAsChained) {
+    HashTable<std::string, int, KeyHash<std::string>, RobinHoodStorage> rh;
+    EXPECT_TRUE(rh.isEmpty());
+
+    for (int i = 0; i < 100; i++) {
+        rh.insert("key" + std::to_string(i), i);
+    }
+    rh.insert("key7", 700);
+    EXPECT_EQ(rh.size(), 100);
+    EXPECT_EQ(rh.get("key7"), 700);
+    EXPECT_EQ(rh["key99"], 99);
+    EXPECT_GT(rh.getTableSize(), 100);
+
+    rh.remove("key0");
+    EXPECT_FALSE(rh.contains("key0"));
+    EXPECT_THROW(rh.remove("key0"), KeyNotFoundException);
+    EXPECT_THROW(rh.get("key0"), KeyNotFoundException);
+
+    int count = 0;
+    for (const auto& kv : rh) {
+        EXPECT_EQ(rh.get(kv.key), kv.value);
+        count++;
+    }
+    EXPECT_EQ(count, 99);
+    EXPECT_EQ(rh.getKeys().elements(), 99);
+
+    auto it = rh.begin();
+    EXPECT_TRUE(it.find("key0") == rh.end());
+    EXPECT_EQ((*it.find("key5")).value, 5);
+
+    rh.clear();
+    EXPECT_TRUE(rh.isEmpty());
+    EXPECT_TRUE(rh.begin() == rh.end());
+}
+
+TEST(HashTableRobinHood, BackwardShiftKeepsClustersReachable) {
+    HashTable<int, int, ClusteringHash, RobinHoodStorage> rh;
+    std::map<int, int> expected;
+    for (int i = 0; i < 200; i++) {
+        rh.insert(i, i * 10);
+        expected[i] = i * 10;
+    }
+    // Remove from the middle of every cluster, then refill some of the holes
+    for (int i = 0; i < 200; i += 3) {
+        rh.remove(i);
+        expected.erase(i);
+    }
+    for (int i = 0; i < 200; i += 6) {
+        rh.insert(i, -i);
+        expected[i] = -i;
+    }
+
+    EXPECT_EQ(rh.size(), static_cast<int>(expected.size()));
+    for (int i = 0; i < 200; i++) {
+        auto found = expected.find(i);
+        if (found == expected.end()) {
+            EXPECT_FALSE(rh.contains(i)) << i;
+        } else {
+            EXPECT_EQ(rh.get(i), found->second) << i;
+        }
+    }
+}
+
+TEST(HashTableRobinHood, CopiesAreIndependent) {
+    HashTable<int, std::string, KeyHash<int>, RobinHoodStorage> original;
+    for (int i = 0; i < 40; i++) {
+        original.insert(i, std::to_string(i));
+    }
+    HashTable<int, std::string, KeyHash<int>, RobinHoodStorage> copy = original;
+    EXPECT_TRUE(copy == original);
+
+    copy.insert(1, "changed");
+    copy.remove(2);
+    EXPECT_TRUE(copy != original);
+    EXPECT_EQ(original.get(1), "1");
+    EXPECT_TRUE(original.contains(2));
+
+    HashTable<int, std::string> chained;
+    chained.insert(1, "one");
+    HashTable<int, std::string> chainedCopy = chained;
+    chainedCopy.insert(1, "uno");
+    EXPECT_EQ(chained.get(1), "one");
+}
+
+// Value whose copy constructor throws once copiesLeft runs out, counting the live instances
+struct ThrowingValue {
+    static int copiesLeft;
+    static int live;
+    int id;
+    explicit ThrowingValue(int i) : id(i) { live++; }
+    ThrowingValue(const ThrowingValue& other) : id(other.id) {
+        if (copiesLeft-- == 0) {
+            throw std::runtime_error("copy failed");
+        }
+        live++;
+    }
+    ThrowingValue(ThrowingValue&& other) noexcept : id(other.id) { live++; }
+    ThrowingValue& operator=(const ThrowingValue& other) = default;
+    ~ThrowingValue() { live--; }
+};
+int ThrowingValue::copiesLeft = 1 << 30;
+int ThrowingValue::live = 0;
+
+template <typename Storage>
+void expectMovesAndFailedCopiesAreClean() {
+    typedef typename Storage::template Table<int, ThrowingValue, KeyHash<int>> Table;
+    {
+        Table original;
+        for (int i = 0; i < 100; i++) {
+            original.insertOrAssign(i, ThrowingValue(i));
+        }
+        Table moved(std::move(original));
+        EXPECT_EQ(moved.size(), 100u);
+        EXPECT_EQ(moved.find(42)->id, 42);
+
+        // The moved-from table is empty and allocates again on its next insert
+        EXPECT_EQ(original.size(), 0u);
+        EXPECT_EQ(original.find(1), nullptr);
+        EXPECT_FALSE(original.erase(1));
+        EXPECT_TRUE(original.atEnd(original.first()));
+        Table empty(original);
+        EXPECT_EQ(empty.size(), 0u);
+        original.insertOrAssign(7, ThrowingValue(7));
+        EXPECT_EQ(original.find(7)->id, 7);
+
+        // A copy that throws halfway destroys the entries it already copied
+        int before = ThrowingValue::live;
+        ThrowingValue::copiesLeft = 50;
+        EXPECT_THROW(Table copy(moved), std::runtime_error);
+        ThrowingValue::copiesLeft = 1 << 30;
+        EXPECT_EQ(ThrowingValue::live, before);
+    }
+    EXPECT_EQ(ThrowingValue::live, 0);
+}
+
+TEST(HashTableStorage, MovesDoNotAllocateAndFailedCopiesClean) {
+    expectMovesAndFailedCopiesAreClean<ChainedStorage>();
+    expectMovesAndFailedCopiesAreClean<PooledChainedStorage>();
+    expectMovesAndFailedCopiesAreClean<IncrementalChainedStorage>();
+    expectMovesAndFailedCopiesAreClean<RobinHoodStorage>();
+}
+
+TEST(HashFunctions, FastHashIsConsistentAndSpreadsKeys) {
+    FastHash<std::string> stringHash;
+    std::string text(100, 'x');
+    static_assert(std::is_same<decltype(stringHash(text)), uint64_t>::value, "FastHash returns the full 64-bit hash");
+    std::set<uint64_t> prefixHashes;
+    for (size_t length = 0; length <= text.size(); length++) {
+        std::string prefix = text.substr(0, length);
+        EXPECT_EQ(stringHash(prefix), stringHash(std::string(prefix)));
+        prefixHashes.insert(stringHash(prefix));
+    }
+    EXPECT_EQ(prefixHashes.size(), text.size() + 1);
+    EXPECT_NE(stringHash("abcdefgh12345678"), stringHash("abcdefgh12345679"));
+
+    // Keys 1024 apart all land in bucket 0 of a 1024 bucket table under the identity hash
+    FastHash<int> intHash;
+    std::set<uint64_t> buckets;
+    for (int i = 0; i < 1024; i++) {
+        buckets.insert(intHash(i * 1024) % 1024);
+    }
+    EXPECT_GT(buckets.size(), 512u);
+}
+
+TEST(HashFunctions, FloatingPointZeroesHashAlike) {
+    EXPECT_EQ(KeyHash<double>()(0.0), KeyHash<double>()(-0.0));
+    EXPECT_EQ(KeyHash<float>()(0.0f), KeyHash<float>()(-0.0f));
+    EXPECT_EQ(FastHash<double>()(0.0), FastHash<double>()(-0.0));
+    EXPECT_NE(FastHash<double>()(1.0), FastHash<double>()(2.0));
+
+    HashTable<double, int, FastHash<double>> table;
+    table.insert(0.0, 1);
+    table.insert(-0.0, 2);
+    EXPECT_EQ(table.size(), 1);
+    EXPECT_EQ(table.get(0.0), 2);
+
+    HashTable<std::string, int, FastHash<std::string>, RobinHoodStorage> strings;
+    for (int i = 0; i < 1000; i++) {
+        strings.insert("key" + std::to_string(i), i);
+    }
+    EXPECT_EQ(strings.get("key999"), 999);
+    EXPECT_EQ(strings.size(), 1000);
+}
+
+// Identity hash that counts how often the table calls it
+struct CountingHash {
+    static int calls;
+    unsigned long operator()(const int& key) const {
+        calls++;
+        return static_cast<unsigned long>(key);
+    }
+};
+int CountingHash::calls = 0;
+
+template <typename Storage>
+void expectOneHashPerOperation() {
+    HashTable<int, int, CountingHash, Storage> table;
+    CountingHash::calls = 0;
+    for (int i = 0; i < 1000; i++) {
+        table.insert(i * 4096, i);
+    }
+    // Growing from 16 to over 1000 buckets reuses the cached hashes
+    EXPECT_EQ(CountingHash::calls, 1000);
+    EXPECT_EQ(table.getTableSize() & (table.getTableSize() - 1), 0);
+
+    CountingHash::calls = 0;
+    for (int i = 0; i < 1000; i++) {
+        EXPECT_EQ(table.get(i * 4096), i);
+    }
+    table.remove(0);
+    EXPECT_EQ(CountingHash::calls, 1001);
+}
+
+TEST(HashTableSizing, GrowthReusesCachedHashes) {
+    expectOneHashPerOperation<ChainedStorage>();
+    expectOneHashPerOperation<RobinHoodStorage>();
+}
+
+TEST(HashTableSizing, PowerOfTwoBucketsSpreadStridedKeys) {
+    HashTable<int, int> table;
+    EXPECT_EQ(table.getTableSize(), 16);
+    for (int i = 0; i < 10000; i++) {
+        table.insert(i * 4096, i);
+        EXPECT_EQ(table.getTableSize() & (table.getTableSize() - 1), 0);
+    }
+    EXPECT_EQ(table.size(), 10000);
+    EXPECT_EQ(table.get(4096 * 9999), 9999);
+}
+
+TEST(HashTablePooledNodes, RemovedNodesAreRecycled) {
+    HashTable<std::string, int, KeyHash<std::string>, PooledChainedStorage> table;
+    table.insert("first", 1);
+    int* firstValue = &table.get("first");
+    table.remove("first");
+
+    // The next insert reuses the node freed by the remove
+    table.insert("second", 2);
+    EXPECT_EQ(&table.get("second"), firstValue);
+
+    for (int i = 0; i < 2000; i++) {
+        table.insert("key" + std::to_string(i), i);
+    }
+    for (int i = 0; i < 2000; i += 2) {
+        table.remove("key" + std::to_string(i));
+    }
+    EXPECT_EQ(table.size(), 1001);
+    EXPECT_EQ(table.get("key1999"), 1999);
+    EXPECT_FALSE(table.contains("key1998"));
+
+    HashTable<std::string, int, KeyHash<std::string>, PooledChainedStorage> copy = table;
+    table.clear();
+    EXPECT_TRUE(table.isEmpty());
+    EXPECT_EQ(copy.size(), 1001);
+    EXPECT_EQ(copy.get("second"), 2);
+}
+
+TEST(HashTablePooledNodes, ClearReleasesSlabsAndTableStaysUsable) {
+    HashTable<int, int, KeyHash<int>, BasicChainedStorage<PooledNodeAllocator<16>>> table;
+    for (int round = 0; round < 3; round++) {
+        for (int i = 0; i < 500; i++) {
+            table.insert(i, i + round);
+        }
+        EXPECT_EQ(table.size(), 500);
+        EXPECT_EQ(table.get(499), 499 + round);
+        table.clear();
+        EXPECT_TRUE(table.isEmpty());
+        EXPECT_FALSE(table.contains(0));
+    }
+}
+
+TEST(HashTableIncrementalRehash, LookupsSeeBothArraysWhileRehashing) {
+    HashTable<int, int, KeyHash<int>, IncrementalChainedStorage> table;
+    for (int i = 0; i < 3000; i++) {
+        table.insert(i, i);
+        // Spot check old and new keys after every insert, some of them land while a rehash is running
+        EXPECT_EQ(table.get(i / 2), i / 2);
+        EXPECT_EQ(table.get(i), i);
+    }
+    for (int i = 0; i < 3000; i += 3) {
+        table.remove(i);
+    }
+    EXPECT_EQ(table.size(), 2000);
+    EXPECT_FALSE(table.contains(2997));
+    EXPECT_TRUE(table.contains(2998));
+    EXPECT_THROW(table.remove(0), KeyNotFoundException);
+}
+
+TEST(HashTableIncrementalRehash, IterationAndCopyDuringRehash) {
+    HashTable<int, int, KeyHash<int>, IncrementalChainedStorage> table;
+    HashTable<int, int, KeyHash<int>, IncrementalChainedStorage>::StorageTable probe;
+    int inserted = 0;
+    // Fill until the table starts a rehash, the next inserts only move a few chains
+    while (!probe.isRehashing()) {
+        probe.insertOrAssign(inserted, inserted);
+        table.insert(inserted, inserted);
+        inserted++;
+    }
+    table.insert(inserted, inserted);
+    inserted++;
+
+    long long sum = 0;
+    int visited = 0;
+    for (const auto& kv : table) {
+        EXPECT_EQ(kv.key, kv.value);
+        sum += kv.value;
+        visited++;
+    }
+    EXPECT_EQ(visited, inserted);
+    EXPECT_EQ(sum, static_cast<long long>(inserted) * (inserted - 1) / 2);
+    EXPECT_EQ(table.getKeys().elements(), static_cast<size_t>(inserted));
+
+    auto copy = table;
+    EXPECT_TRUE(copy == table);
+    table.clear();
+    EXPECT_TRUE(table.isEmpty());
+    EXPECT_EQ(copy.get(inserted - 1), inserted - 1);
+}
+
+TEST(ConcurrentHashTableTest, SingleThreadedApi) {
+    ConcurrentHashTable<std::string, int> table;
+    EXPECT_TRUE(table.isEmpty());
+    for (int i = 0; i < 1000; i++) {
+        table.insert("key" + std::to_string(i), i);
+    }
+    EXPECT_EQ(table.size(), 1000u);
+    EXPECT_GE(table.getTableSize(), 1000u);
+    EXPECT_EQ(table.get("key500"), 500);
+
+    table.insert("key500", -500);
+    EXPECT_EQ(table.get("key500"), -500);
+    EXPECT_FALSE(table.putIfAbsent("key1", 100));
+    EXPECT_TRUE(table.putIfAbsent("new", 7));
+    EXPECT_EQ(table.compute("new", [](const int* current) { return current ? *current * 2 : 0; }), 14);
+    EXPECT_EQ(table.compute("absent", [](const int* current) { return current ? *current : 42; }), 42);
+
+    int value = 0;
+    EXPECT_TRUE(table.erase("key0"));
+    EXPECT_FALSE(table.erase("key0"));
+    EXPECT_FALSE(table.tryGet("key0", value));
+    EXPECT_THROW(table.get("key0"), KeyNotFoundException);
+    EXPECT_TRUE(table.tryGet("key999", value));
+    EXPECT_EQ(value, 999);
+
+    size_t visited = 0;
+    table.forEach([&](const std::string&, int) { visited++; });
+    EXPECT_EQ(visited, table.size());
+
+    table.clear();
+    EXPECT_TRUE(table.isEmpty());
+    EXPECT_FALSE(table.contains("key999"));
+}
+
+TEST(ConcurrentHashTableTest, ReadersSeeCompleteValuesDuringWritesAndResizes) {
+    ConcurrentHashTable<int, std::string> table;
+    const int writers = 4;
+    const int perWriter = 5000;
+    std::atomic<bool> done(false);
+    std::atomic<int> badReads(0);
+
+    std::vector<std::thread> threads;
+    for (int r = 0; r < 2; r++) {
+        threads.emplace_back([&]() {
+            std::string value;
+            while (!done.load()) {
+                for (int key = 0; key < writers * perWriter; key += 97) {
+                    if (table.tryGet(key, value) && value != std::to_string(key) && value != "updated" + std::to_string(key)) {
+                        badReads++;
+                    }
+                }
+            }
+        });
+    }
+    std::vector<std::thread> writerThreads;
+    for (int w = 0; w < writers; w++) {
+        writerThreads.emplace_back([&, w]() {
+            for (int i = 0; i < perWriter; i++) {
+                int key = w * perWriter + i;
+                table.insert(key, std::to_string(key));
+                if (i % 2 == 0) {
+                    table.insert(key, "updated" + std::to_string(key));
+                }
+                if (i % 5 == 0) {
+                    table.erase(key);
+                }
+            }
+        });
+    }
+    for (auto& thread : writerThreads) {
+        thread.join();
+    }
+    done = true;
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    EXPECT_EQ(badReads.load(), 0);
+    EXPECT_EQ(table.size(), static_cast<size_t>(writers * perWriter * 4 / 5));
+    EXPECT_FALSE(table.contains(perWriter));
+    EXPECT_EQ(table.get(perWriter + 2), "updated" + std::to_string(perWriter + 2));
+    EXPECT_EQ(table.get(perWriter + 1), std::to_string(perWriter + 1));
+}
+
+TEST(ConcurrentHashTableTest, ComputeAndPutIfAbsentAreAtomic) {
+    ConcurrentHashTable<int, int> table;
+    std::atomic<int> winners(0);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 8; t++) {
+        threads.emplace_back([&]() {
+            for (int i = 0; i < 2000; i++) {
+                table.compute(i % 100, [](const int* current) { return current ? *current + 1 : 1; });
+                if (table.putIfAbsent(1000 + i, i)) {
+                    winners++;
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    for (int key = 0; key < 100; key++) {
+        EXPECT_EQ(table.get(key), 8 * 20);
+    }
+    EXPECT_EQ(winners.load(), 2000);
+    EXPECT_EQ(table.size(), 2100u);
+}
+
+TEST(HashTableLookup, ConstLookups) {
+    HashTable<int, std::string> table;
+    table.insert(1, "one");
+    const HashTable<int, std::string>& constTable = table;
+
+    const std::string* one = constTable.tryGet(1);
+    ASSERT_NE(one, nullptr);
+    EXPECT_EQ(*one, "one");
+    EXPECT_EQ(constTable.tryGet(2), nullptr);
+    EXPECT_TRUE(constTable.find(2) == constTable.cend());
+    EXPECT_TRUE(constTable.find(1) != constTable.cend());
+}
+
+TEST(HashTableIteration, IteratorsReferToStoredEntries) {
+    HashTable<std::string, int> table;
+    for (int i = 0; i < 50; i++) {
+        table.insert("key" + std::to_string(i), i);
+    }
+
+    for (auto kv : table) {
+        kv.value *= 10;
+    }
+    std::set<std::string> arrowKeys;
+    for (auto it = table.begin(); it != table.end(); ++it) {
+        EXPECT_EQ(table.get(it->first()), it->second());
+        arrowKeys.insert(it->first());
+    }
+    EXPECT_EQ(arrowKeys.size(), 50u);
+    EXPECT_EQ(table.get("key7"), 70);
+
+    const HashTable<std::string, int>& constTable = table;
+    HashTable<std::string, int>::ConstHashtableIterator converted = table.begin();
+    EXPECT_TRUE(converted == constTable.begin());
+    int count = 0;
+    for (const auto& kv : constTable) {
+        EXPECT_EQ(kv.value % 10, 0);
+        count++;
+    }
+    EXPECT_EQ(count, 50);
+
+    HashTable<std::string, int>::KeyValuePair copy = *table.find("key3");
+    table.insert("key3", 0);
+    EXPECT_EQ(copy.value, 30);
+}
+
 int main(int argc, char **argv) {
     ::testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();
@@ -10,63 +10,307 @@
 #include <limits>
 #include <algorithm>
 #include "TypeTraits.h"
+#include "SimpleVectorSimd.h"
 #include <mutex>
+#include <shared_mutex>
+#include <type_traits>
+#include <utility>
+#include <cstring>
+#include <iterator>
 
 //#define DEBUG
 
-template <typename T>
+//==============================================================================|
+
+/**
+ * @brief Locking policy that performs no synchronization at all.
+ *
+ * @details Use this policy for vectors that are only touched by a single thread.
+ * Every lock call is an empty inline function, so element access compiles down to plain pointer arithmetic.
+ */
+struct NoLockPolicy {
+    void lock() const {}
+    void unlock() const {}
+    void lock_shared() const {}
+    void unlock_shared() const {}
+};
+
+/**
+ * @brief Locking policy backed by a single std::mutex.
+ *
+ * @details Readers and writers are serialized on the same mutex. This is the default policy and matches the
+ * behaviour SimpleVector has always had.
+ */
+struct MutexLockPolicy {
+    void lock() const { mtx.lock(); }
+    void unlock() const { mtx.unlock(); }
+    void lock_shared() const { mtx.lock(); }
+    void unlock_shared() const { mtx.unlock(); }
+private:
+    mutable std::mutex mtx;
+};
+
+/**
+ * @brief Locking policy backed by a std::shared_mutex (reader/writer lock).
+ *
+ * @details Read-only methods take a shared lock so that any number of readers can run in parallel,
+ * while methods that modify the vector take an exclusive lock.
+ */
+struct SharedMutexLockPolicy {
+    void lock() const { mtx.lock(); }
+    void unlock() const { mtx.unlock(); }
+    void lock_shared() const { mtx.lock_shared(); }
+    void unlock_shared() const { mtx.unlock_shared(); }
+private:
+    mutable std::shared_mutex mtx;
+};
+
+#if defined(__linux__) && !defined(SIMPLEVECTOR_NO_HUGE_PAGES)
+#define SIMPLEVECTOR_HUGE_PAGES 1
+
+#include <cstdint>
+#include <sys/mman.h>
+
+// Arrays of at least this many bytes are mapped with huge pages. Define as 0 to always use operator new.
+#ifndef SIMPLEVECTOR_HUGE_PAGE_THRESHOLD
+#define SIMPLEVECTOR_HUGE_PAGE_THRESHOLD (8u << 20)
+#endif
+
+/**
+ * @brief Anonymous memory mappings backed by huge pages, used for very large SimpleVector arrays.
+ *
+ * @details Mappings are aligned to and sized in whole 2 MiB pages and marked with MADV_HUGEPAGE, so transparent huge
+ * pages can back them. Defining SIMPLEVECTOR_USE_HUGETLB first tries explicit pages from the hugetlbfs pool
+ * (MAP_HUGETLB) and falls back to transparent ones when the pool is empty.
+ */
+struct HugePages {
+    static constexpr size_t HUGE_PAGE_SIZE = size_t(2) << 20;
+
+    static size_t roundUp(size_t bytes) {
+        if (bytes > std::numeric_limits<size_t>::max() - HUGE_PAGE_SIZE) {
+            throw std::bad_alloc();
+        }
+        return (bytes + HUGE_PAGE_SIZE - 1) & ~(HUGE_PAGE_SIZE - 1);
+    }
+
+    static void* map(size_t bytes) {
+        size_t length = roundUp(bytes);
+#if defined(SIMPLEVECTOR_USE_HUGETLB) && defined(MAP_HUGETLB)
+        void* explicitPages = ::mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        if (explicitPages != MAP_FAILED) {
+            return explicitPages;
+        }
+#endif
+        // Map one extra page and trim both ends so the region starts on a huge page boundary.
+        void* raw = ::mmap(nullptr, length + HUGE_PAGE_SIZE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (raw == MAP_FAILED) {
+            throw std::bad_alloc();
+        }
+        uintptr_t start = reinterpret_cast<uintptr_t>(raw);
+        uintptr_t aligned = (start + HUGE_PAGE_SIZE - 1) & ~(HUGE_PAGE_SIZE - 1);
+        if (aligned > start) {
+            ::munmap(raw, aligned - start);
+        }
+        size_t tail = (start + length + HUGE_PAGE_SIZE) - (aligned + length);
+        if (tail > 0) {
+            ::munmap(reinterpret_cast<void*>(aligned + length), tail);
+        }
+#ifdef MADV_HUGEPAGE
+        ::madvise(reinterpret_cast<void*>(aligned), length, MADV_HUGEPAGE);
+#endif
+        return reinterpret_cast<void*>(aligned);
+    }
+
+    static void unmap(void* storage, size_t bytes) {
+        ::munmap(storage, roundUp(bytes));
+    }
+};
+#endif
+
+//==============================================================================|
+
+/**
+ * @brief Shrink rule shared by the growth policies.
+ *
+ * @details shrinkToFit() only reallocates when more than a quarter of the capacity is unused, so a vector whose size
+ * hovers around one value is not reallocated over and over. Custom growth policies can derive from this struct
+ * or provide their own shouldShrink().
+ */
+struct GrowthPolicyBase {
+    static bool shouldShrink(size_t count, size_t capacity) { return capacity - count > capacity / 4; }
+};
+
+/**
+ * @brief Growth policy that doubles the capacity. This is the default and matches the behaviour SimpleVector has always had.
+ */
+struct DoublingGrowthPolicy : GrowthPolicyBase {
+    static size_t grow(size_t capacity) { return capacity == 0 ? 4 : capacity * 2; }
+};
+
+/**
+ * @brief Growth policy that grows the capacity by half.
+ *
+ * @details It wastes less memory than doubling at the cost of more reallocations.
+ */
+struct OneAndAHalfGrowthPolicy : GrowthPolicyBase {
+    static size_t grow(size_t capacity) { return capacity < 4 ? 4 : capacity + capacity / 2; }
+};
+
+/**
+ * @brief Growth policy that adds a fixed number of elements each time.
+ *
+ * @details Use it for buffers with a known upper bound. Growth is linear, so appends to an unbounded vector cost O(n) each.
+ *
+ * @tparam Increment The number of elements added per growth step.
+ */
+template <size_t Increment>
+struct FixedGrowthPolicy : GrowthPolicyBase {
+    static_assert(Increment > 0, "FixedGrowthPolicy needs a positive increment");
+    static size_t grow(size_t capacity) { return capacity + Increment; }
+};
+
+/**
+ * @brief Allocation counters of one SimpleVector instance.
+ */
+struct SimpleVectorStats {
+    size_t reallocations = 0; // Number of times the elements were moved to a new array
+    size_t bytesCopied = 0; // Bytes of elements moved or copied by those reallocations
+    size_t peakCapacity = 0; // Largest capacity the vector has had
+};
+
+template <typename T, unsigned int N, typename LockPolicy, typename GrowthPolicy>
+class SmallSimpleVector; // SimpleVector with inline storage, see SmallSimpleVector.h
+
+//==============================================================================|
+
+/**
+ * @brief A thread-safe dynamic array.
+ *
+ * @tparam T The type of the elements.
+ * @tparam LockPolicy NoLockPolicy, MutexLockPolicy or SharedMutexLockPolicy.
+ * @tparam GrowthPolicy DoublingGrowthPolicy, OneAndAHalfGrowthPolicy, FixedGrowthPolicy, or any type with
+ * static size_t grow(size_t capacity) and static bool shouldShrink(size_t count, size_t capacity).
+ */
+template <typename T, typename LockPolicy = MutexLockPolicy, typename GrowthPolicy = DoublingGrowthPolicy>
 class SimpleVector {
 private:
     T* array; // Pointer to the array
-    unsigned int count; // Number of elements in the array
-    unsigned int capacity; // Capacity of the array
-
-    void resize(); // Resize the array to 2 * capacity
-    void resize(unsigned int newCapacity); // Resize the array to the specified capacity
+    size_t elementCount; // Number of elements in the array
+    size_t capacity; // Capacity of the array
+    T* inlineBuffer; // Inline storage supplied by SmallSimpleVector, nullptr for heap-only vectors
+    size_t inlineCapacity; // Number of elements the inline storage can hold
+
+    // The private helpers below expect the caller to already hold the write lock.
+    void resize(); // Grow the array as the growth policy says
+    void resize(size_t newCapacity); // Resize the array to the specified capacity
     void ensureCapacity(); // Ensure that the array has enough capacity to add a new element
-    int calculateNewCapacity(); // Calculate the new capacity of the array
-    mutable std::mutex mtx; // Mutex for synchronization
+    size_t calculateNewCapacity(); // Calculate the new capacity of the array
+    static constexpr size_t maxElements() { return std::numeric_limits<size_t>::max() / sizeof(T); } // Largest capacity that can be allocated
+    static bool usesHugePages(size_t slots); // Check if storage for this many elements is mapped with huge pages
+    static T* allocate(size_t slots); // Allocate raw, unconstructed storage for the given number of elements
+    static void deallocate(T* storage, size_t slots); // Release storage obtained from allocate(slots)
+    static void destroyRange(T* first, T* last); // Run the destructor of every element in [first, last)
+    template<typename... Args>
+    T& emplaceUnlocked(Args&&... args); // Construct an element at the end without taking the lock
+    size_t growthCapacity(size_t needed); // Capacity to grow to so that at least needed elements fit
+    template<typename Construct>
+    void appendUnlocked(size_t n, Construct construct); // Construct n elements at the end, growing at most once
+    template<typename InputIt>
+    static void constructRange(T* dest, InputIt first, size_t n); // Copy-construct n elements into raw storage
+    void adoptStorage(SimpleVector& other); // Take over the elements of other; this vector must be empty
+    void recordPeak(); // Fold the current capacity into the peak before it can drop
+    SimpleVectorStats statistics; // Allocation counters of this instance
+    mutable LockPolicy lockPolicy; // Locking policy used for synchronization
+
+    typedef std::lock_guard<LockPolicy> WriteLock; // Exclusive lock for methods that modify the vector
+    typedef std::shared_lock<LockPolicy> ReadLock; // Shared lock for read-only methods
+
+protected:
+    SimpleVector(T* buffer, size_t bufferCapacity); // Constructor used by SmallSimpleVector to supply inline storage
+    void copyFrom(const SimpleVector& other); // Copy the elements of other into this empty vector
+    void moveFrom(SimpleVector& other); // Take over the elements of other; this vector must be empty
+    void replaceStorage(SimpleVector& other); // Replace the elements with those of other, which no other thread may use
+    void releaseStorage(); // Destroy all elements and free any heap storage
+    void truncate(size_t count); // Destroy the elements past count, keeping the capacity
+    bool storageIsInline() const; // Check if the elements live in the inline storage
 
 public:
-    class SimpleVectorIterator; // Forward declaration of the SimpleVectorIterator class
+    template <typename Element>
+    class BasicIterator; // Contiguous iterator over Element, which is T or const T
+    typedef BasicIterator<T> SimpleVectorIterator; // Iterator over mutable elements
+    typedef BasicIterator<const T> ConstSimpleVectorIterator; // Iterator over const elements
+
+    typedef T value_type; // Define the element type
+    typedef T& reference; // Define the reference type
+    typedef const T& const_reference; // Define the const reference type
 
     SimpleVector(); // Default constructor
     
-    SimpleVector(unsigned int initialCapacity); // Constructor with initial capacity
+    SimpleVector(size_t initialCapacity); // Constructor with initial capacity
     
     SimpleVector(const SimpleVector& other); // Copy constructor
+    SimpleVector(SimpleVector&& other) noexcept(std::is_nothrow_move_constructible<T>::value); // Move constructor
+    template <unsigned int N>
+    SimpleVector(SmallSimpleVector<T, N, LockPolicy, GrowthPolicy>&& other); // Move from a SmallSimpleVector, may allocate
     SimpleVector(std::initializer_list<T> initList); // Constructor with initializer list
 
+    SimpleVector& operator=(const SimpleVector& other); // Copy assignment operator
+    SimpleVector& operator=(SimpleVector&& other) noexcept(std::is_nothrow_move_constructible<T>::value); // Move assignment operator
+    template <unsigned int N>
+    SimpleVector& operator=(SmallSimpleVector<T, N, LockPolicy, GrowthPolicy>&& other); // Move-assign from a SmallSimpleVector, may allocate
+
     ~SimpleVector(); // Destructor
     void releaseMemory(); // Release the memory used by the array
     bool shrinkToFit(); // Shrink the capacity of the array to match the count of elements
-    void clear(); // Clear the array by setting all elements to their default value and resetting the count
+    void clear(); // Destroy all elements, keeping the capacity
     void push_back(const T& item); // Add an element to the array
+    void push_back(T&& item); // Add an element to the array by moving it
     void put(const T& item); // Add an element to the array
     template<typename... Args>
     void bulk_add(Args&&... args); // Add multiple elements to the array
-    void emplace_back(); // Add an element to the array using emplace
-    void emplace_back(const T& value); // Add an element to the array using emplace
+    template<typename... Args>
+    T& emplace_back(Args&&... args); // Construct an element in place at the end of the array
+    void reserve(size_t n); // Make room for at least n elements
+    void append(const T* first, size_t n); // Add n elements copied from an array
+    template<typename InputIt>
+    void append(InputIt first, InputIt last); // Add the elements of the range [first, last)
+    void insert(size_t index, const T* first, size_t n); // Insert n elements copied from an array before index
+    template<typename InputIt>
+    void insert(size_t index, InputIt first, InputIt last); // Insert the elements of the range [first, last) before index
     T& back(); // Get the last element in the array
     T& front(); // Get the first element in the array
     void remove(const T& item); // Remove an element from the array
-    T& operator[](unsigned int index); // Overload the subscript operator for non-const objects
-    const T& operator[](unsigned int index) const; // Overload the subscript operator for const objects
-    unsigned int size() const; // Get the number of elements in the array
-    unsigned int elements() const; // Get the number of elements in the array
-    T& get(unsigned int index); // Get the element at the specified index
+    T& operator[](size_t index); // Overload the subscript operator for non-const objects
+    const T& operator[](size_t index) const; // Overload the subscript operator for const objects
+    T& at_unchecked(size_t index); // Get the element at the specified index without locking or bounds checking
+    const T& at_unchecked(size_t index) const; // Get the element at the specified index without locking or bounds checking
+    T* data(); // Get a pointer to the underlying array
+    const T* data() const; // Get a pointer to the underlying array
+    size_t size() const; // Get the number of elements in the array
+    size_t elements() const; // Get the number of elements in the array
+    T& get(size_t index); // Get the element at the specified index
     bool isEmpty() const; // Check if the array is empty
-    int indexOf(const T& element); // Get the index of the specified element
+    ptrdiff_t indexOf(const T& element); // Get the index of the specified element, or -1
     bool contains(const T& element); // Check if the array contains the specified element
     bool contains(const T& element) const; // Check if the array contains the specified element
+    size_t count(const T& element) const; // Count the elements equal to the specified element
+    T min() const; // Get the smallest element
+    T max() const; // Get the largest element
+    typename SimdKernels<T>::SumType sum() const; // Get the sum of all elements
+    SimpleVectorStats stats() const; // Get the allocation counters of this vector
+    void resetStats(); // Reset the allocation counters
 
     SimpleVectorIterator begin(); // Get an iterator pointing to the first element in the array
     SimpleVectorIterator end(); // Get an iterator pointing to one past the last element in the array
 
-    const SimpleVectorIterator cbegin(); // Get a const iterator pointing to the first element in the array.
-    const SimpleVectorIterator cend(); // Get a const iterator pointing to one past the last element in the array.
+    ConstSimpleVectorIterator begin() const; // Get a const iterator pointing to the first element in the array
+    ConstSimpleVectorIterator end() const; // Get a const iterator pointing to one past the last element in the array
+
+    ConstSimpleVectorIterator cbegin() const; // Get a const iterator pointing to the first element in the array.
+    ConstSimpleVectorIterator cend() const; // Get a const iterator pointing to one past the last element in the array.
     
     typedef SimpleVectorIterator iterator; // Define the iterator type
+    typedef ConstSimpleVectorIterator const_iterator; // Define the const iterator type
 };
 
 //==============================================================================|
@@ -107,8 +351,8 @@ private:
  * @tparam T The type of the elements in the SimpleVector.
  * 
  */
-template <typename T>
-SimpleVector<T>::SimpleVector() : array(new T[4]), count(0), capacity(4) {
+template <typename T, typename LockPolicy, typename GrowthPolicy>
+SimpleVector<T, LockPolicy, GrowthPolicy>::SimpleVector() : array(allocate(4)), elementCount(0), capacity(4), inlineBuffer(nullptr), inlineCapacity(0) {
     #ifdef DEBUG
     std::cout << "Created array with size: 4" << std::endl;
     #endif
@@ -125,28 +369,29 @@ SimpleVector<T>::SimpleVector() : array(new T[4]), count(0), capacity(4) {
  * 
  * @throw SimpleVectorException if the initializer list is empty.
  */
-template <typename T>
-SimpleVector<T>::SimpleVector(std::initializer_list<T> initList) {
+template <typename T, typename LockPolicy, typename GrowthPolicy>
+SimpleVector<T, LockPolicy, GrowthPolicy>::SimpleVector(std::initializer_list<T> initList) : inlineBuffer(nullptr), inlineCapacity(0) {
     if(initList.size() == 0) {
         throw SimpleVectorException("Initializer list must not be empty.");
     }
-    if(initList.size() > std::numeric_limits<unsigned int>::max()) {
-        throw SimpleVectorException("Initializer list is too large for this SimpleVector implementation.");
-    }
-    array = new T[initList.size()];
+    array = allocate(initList.size());
     #ifdef DEBUG
     std::cout << "Created array with size: " << initList.size() << std::endl;
     #endif
-    capacity = static_cast<unsigned int>(initList.size());
-    count = 0;
-    for (const T& value : initList) {
-        if(count == capacity) {
-            resize(2 * capacity);
+    capacity = initList.size();
+    elementCount = 0;
+    try {
+        for (const T& value : initList) {
+            new (array + elementCount) T(value);
+            elementCount++;
+            #ifdef DEBUG
+            std::cout << "Added element: " << value << std::endl;
+            #endif
         }
-        array[count++] = value;
-        #ifdef DEBUG
-        std::cout << "Added element: " << value << std::endl;
-        #endif
+    } catch (...) {
+        destroyRange(array, array + elementCount);
+        deallocate(array, capacity);
+        throw;
     }
 }
 
@@ -160,20 +405,16 @@ SimpleVector<T>::SimpleVector(std::initializer_list<T> initList) {
  * 
  * @throw SimpleVectorException if the initial capacity is 0.
  */
-template <typename T>
-SimpleVector<T>::SimpleVector(unsigned int initialCapacity) : array(new T[initialCapacity]), count(0), capacity(initialCapacity) {    
+template <typename T, typename LockPolicy, typename GrowthPolicy>
+SimpleVector<T, LockPolicy, GrowthPolicy>::SimpleVector(size_t initialCapacity) : array(nullptr), elementCount(0), capacity(initialCapacity), inlineBuffer(nullptr), inlineCapacity(0) {
     if (initialCapacity == 0) {
         throw SimpleVectorException("Initial capacity must be greater than 0.");
     }
 
-    array = new T[initialCapacity];
+    array = allocate(initialCapacity);
     #ifdef DEBUG
     std::cout << "Created array with size: " << initialCapacity << std::endl;
     #endif
-
-    count = 0;
-    capacity = initialCapacity;
-
 }
 
 /**
@@ -182,25 +423,261 @@ SimpleVector<T>::SimpleVector(unsigned int initialCapacity) : array(new T[initia
  * @details This constructor creates a new SimpleVector object by copying the elements from another SimpleVector object.
  * 
  * @tparam T The type of the elements in the SimpleVector.
+ * @param other The SimpleVector object to copy. Copying an empty vector produces an empty vector.
+ */
+template <typename T, typename LockPolicy, typename GrowthPolicy>
+SimpleVector<T, LockPolicy, GrowthPolicy>::SimpleVector(const SimpleVector& other) : array(nullptr), elementCount(0), capacity(0), inlineBuffer(nullptr), inlineCapacity(0) {
+    copyFrom(other);
+    #ifdef DEBUG
+    std::cout << "Copied array with size: " << capacity << std::endl;
+    #endif
+}
+
+/**
+ * @brief Constructs a new SimpleVector object by taking over the storage of another SimpleVector object.
+ * 
+ * @details This constructor steals the array of the other vector in O(1). The other vector is left empty with no capacity,
+ * and can be reused; the next insertion allocates fresh storage.
+ * 
+ * Elements in the inline storage of a SmallSimpleVector cannot be stolen and would need a heap array, so a
+ * SmallSimpleVector is moved by the constructor below instead, which may throw. Do not move one through a
+ * SimpleVector reference.
+ * 
+ * @tparam T The type of the elements in the SimpleVector.
+ * @param other The SimpleVector object to move from.
+ */
+template <typename T, typename LockPolicy, typename GrowthPolicy>
+SimpleVector<T, LockPolicy, GrowthPolicy>::SimpleVector(SimpleVector&& other) noexcept(std::is_nothrow_move_constructible<T>::value)
+    : array(nullptr), elementCount(0), capacity(0), inlineBuffer(nullptr), inlineCapacity(0) {
+    moveFrom(other);
+}
+
+/**
+ * @brief Constructs a new SimpleVector object by taking over the elements of a SmallSimpleVector object.
+ * 
+ * @details Heap storage is stolen in O(1). Inline elements are moved one by one into a new heap array.
+ * 
+ * @param other The SmallSimpleVector object to move from. It is left empty.
+ * @throw std::bad_alloc if the inline elements cannot be moved to the heap.
+ */
+template <typename T, typename LockPolicy, typename GrowthPolicy>
+template <unsigned int N>
+SimpleVector<T, LockPolicy, GrowthPolicy>::SimpleVector(SmallSimpleVector<T, N, LockPolicy, GrowthPolicy>&& other)
+    : array(nullptr), elementCount(0), capacity(0), inlineBuffer(nullptr), inlineCapacity(0) {
+    moveFrom(other);
+}
+
+/**
+ * @brief Constructs an empty SimpleVector object that stores its first elements in caller-supplied inline storage.
+ * 
+ * @details This constructor is used by SmallSimpleVector. The buffer must stay valid for the lifetime of this object and is
+ * never freed by SimpleVector. Once more than bufferCapacity elements are added the vector moves to the heap like any other SimpleVector.
+ * 
+ * @param buffer Raw storage for at least bufferCapacity elements.
+ * @param bufferCapacity The number of elements the buffer can hold.
+ */
+template <typename T, typename LockPolicy, typename GrowthPolicy>
+SimpleVector<T, LockPolicy, GrowthPolicy>::SimpleVector(T* buffer, size_t bufferCapacity)
+    : array(buffer), elementCount(0), capacity(bufferCapacity), inlineBuffer(buffer), inlineCapacity(bufferCapacity) {
+}
+
+/**
+ * @brief Replaces the contents of this vector with a copy of another vector.
+ * 
+ * @details The copy is built before this vector is locked, so the two locks are never held at the same time.
+ * 
  * @param other The SimpleVector object to copy.
+ * @return Reference to this vector.
+ */
+template <typename T, typename LockPolicy, typename GrowthPolicy>
+SimpleVector<T, LockPolicy, GrowthPolicy>& SimpleVector<T, LockPolicy, GrowthPolicy>::operator=(const SimpleVector& other) {
+    if (this != &other) {
+        SimpleVector copy(other);
+        WriteLock lock(lockPolicy); // Lock for thread-safety
+        releaseStorage();
+        adoptStorage(copy);
+    }
+    return *this;
+}
+
+/**
+ * @brief Replaces the contents of this vector by taking over the storage of another vector.
  * 
- * @throw SimpleVectorException if the other SimpleVector object is empty.
+ * @details The previous contents of this vector are destroyed. The other vector is left empty.
+ * 
+ * @param other The SimpleVector object to move from.
+ * @return Reference to this vector.
  */
-template <typename T>
-SimpleVector<T>::SimpleVector(const SimpleVector& other) : capacity(other.capacity), count(other.count) {
-    if(other.count == 0) {
-        throw SimpleVectorException("Cannot copy from an empty vector.");
+template <typename T, typename LockPolicy, typename GrowthPolicy>
+SimpleVector<T, LockPolicy, GrowthPolicy>& SimpleVector<T, LockPolicy, GrowthPolicy>::operator=(SimpleVector&& other) noexcept(std::is_nothrow_move_constructible<T>::value) {
+    if (this != &other) {
+        SimpleVector moved(std::move(other));
+        replaceStorage(moved);
     }
-    
-    array = new T[capacity];
-    
-    for (unsigned int i = 0; i < count; i++) {
-        array[i] = other.array[i];
+    return *this;
+}
+
+/**
+ * @brief Replaces the contents of this vector by taking over the elements of a SmallSimpleVector object.
+ * 
+ * @param other The SmallSimpleVector object to move from. It is left empty.
+ * @return Reference to this vector.
+ * @throw std::bad_alloc if the inline elements cannot be moved to the heap.
+ */
+template <typename T, typename LockPolicy, typename GrowthPolicy>
+template <unsigned int N>
+SimpleVector<T, LockPolicy, GrowthPolicy>& SimpleVector<T, LockPolicy, GrowthPolicy>::operator=(SmallSimpleVector<T, N, LockPolicy, GrowthPolicy>&& other) {
+    SimpleVector moved(std::move(other));
+    replaceStorage(moved);
+    return *this;
+}
+
+/**
+ * @brief Copy the elements of another vector into this vector.
+ * 
+ * @details This vector must be empty. The other vector is read-locked for the duration of the copy.
+ * Vectors with inline storage only allocate when the elements do not fit inline; other vectors keep the capacity of the source.
+ * 
+ * @param other The SimpleVector object to copy.
+ */
+template <typename T, typename LockPolicy, typename GrowthPolicy>
+void SimpleVector<T, LockPolicy, GrowthPolicy>::copyFrom(const SimpleVector& other) {
+    ReadLock otherLock(other.lockPolicy); // Hold the source steady while it is copied
+    size_t needed = (inlineBuffer != nullptr) ? other.elementCount : other.capacity;
+    if (needed > capacity) {
+        T* newArray = allocate(needed);
+        if (array != inlineBuffer) {
+            deallocate(array, capacity);
+        }
+        array = newArray;
+        capacity = needed;
+    }
+
+    size_t constructed = 0;
+    try {
+        for (; constructed < other.elementCount; constructed++) {
+            new (array + constructed) T(other.array[constructed]);
+        }
+    } catch (...) {
+        destroyRange(array, array + constructed);
+        throw;
+    }
+    elementCount = other.elementCount;
+}
+
+/**
+ * @brief Take over the elements of another vector.
+ * 
+ * @details This vector must be empty. The other vector is write-locked and left empty.
+ * 
+ * @param other The SimpleVector object to move from.
+ */
+template <typename T, typename LockPolicy, typename GrowthPolicy>
+void SimpleVector<T, LockPolicy, GrowthPolicy>::moveFrom(SimpleVector& other) {
+    WriteLock otherLock(other.lockPolicy); // The source is modified, so take its exclusive lock
+    adoptStorage(other);
+}
+
+/**
+ * @brief Replace the elements of this vector with those of another vector.
+ * 
+ * @details Only this vector is locked, so other must be a temporary that no other thread can reach. Nothing is
+ * allocated when other's storage can be stolen or its elements fit this vector's inline storage.
+ * 
+ * @param other The SimpleVector object to take the elements from. It is left empty.
+ */
+template <typename T, typename LockPolicy, typename GrowthPolicy>
+void SimpleVector<T, LockPolicy, GrowthPolicy>::replaceStorage(SimpleVector& other) {
+    WriteLock lock(lockPolicy); // Lock for thread-safety
+    releaseStorage();
+    adoptStorage(other);
+}
+
+/**
+ * @brief Take over the elements of another vector without locking.
+ * 
+ * @details Heap storage is stolen in O(1). Elements that live in inline storage cannot be stolen and are moved one by one,
+ * and so are small heap arrays when this vector has inline room for them. The other vector is left empty,
+ * pointing back at its own inline storage if it has any.
+ * 
+ * @param other The SimpleVector object to move from.
+ */
+template <typename T, typename LockPolicy, typename GrowthPolicy>
+void SimpleVector<T, LockPolicy, GrowthPolicy>::adoptStorage(SimpleVector& other) {
+    recordPeak();
+    other.recordPeak();
+    bool otherOnHeap = other.array != other.inlineBuffer;
+    bool fitsInline = inlineBuffer != nullptr && other.elementCount <= inlineCapacity;
+    if (otherOnHeap && !fitsInline) {
+        if (array != inlineBuffer) {
+            deallocate(array, capacity);
+        }
+        array = other.array;
+        elementCount = other.elementCount;
+        capacity = other.capacity;
+    } else {
+        if (other.elementCount > capacity) {
+            T* newArray = allocate(other.elementCount);
+            if (array != inlineBuffer) {
+                deallocate(array, capacity);
+            }
+            array = newArray;
+            capacity = other.elementCount;
+        }
+        for (; elementCount < other.elementCount; elementCount++) {
+            new (array + elementCount) T(std::move(other.array[elementCount]));
+        }
+        destroyRange(other.array, other.array + other.elementCount);
+        if (otherOnHeap) {
+            deallocate(other.array, other.capacity);
+        }
+    }
+    other.array = other.inlineBuffer;
+    other.capacity = other.inlineCapacity;
+    other.elementCount = 0;
+}
+
+/**
+ * @brief Check if the elements live in the inline storage supplied by a derived class.
+ * 
+ * @return True if the vector has inline storage and has not spilled to the heap.
+ */
+template <typename T, typename LockPolicy, typename GrowthPolicy>
+bool SimpleVector<T, LockPolicy, GrowthPolicy>::storageIsInline() const {
+    ReadLock lock(lockPolicy); // Lock for thread-safety
+    return inlineBuffer != nullptr && array == inlineBuffer;
+}
+
+/**
+ * @brief Destroy all elements and free any heap storage.
+ * 
+ * @details The vector falls back to its inline storage if it has any, and to no storage at all otherwise.
+ */
+template <typename T, typename LockPolicy, typename GrowthPolicy>
+void SimpleVector<T, LockPolicy, GrowthPolicy>::releaseStorage() {
+    recordPeak();
+    destroyRange(array, array + elementCount);
+    if (array != inlineBuffer) {
+        deallocate(array, capacity);
+    }
+    array = inlineBuffer;
+    capacity = inlineCapacity;
+    elementCount = 0;
+}
+
+/**
+ * @brief Destroy the elements past the specified count, keeping the capacity.
+ * 
+ * @param count The number of elements to keep. Nothing happens if the vector has no more elements than that.
+ */
+template <typename T, typename LockPolicy, typename GrowthPolicy>
+void SimpleVector<T, LockPolicy, GrowthPolicy>::truncate(size_t count) {
+    WriteLock lock(lockPolicy); // Lock for thread-safety
+
+    if (count < elementCount) {
+        destroyRange(array + count, array + elementCount);
+        elementCount = count;
     }
-    
-    #ifdef DEBUG
-    std::cout << "Copied array with size: " << capacity << std::endl;
-    #endif
 }
 
 /**
@@ -210,9 +687,9 @@ SimpleVector<T>::SimpleVector(const SimpleVector& other) : capacity(other.capaci
  * 
  * @tparam T The type of the elements in the SimpleVector.
  */
-template <typename T>
-SimpleVector<T>::~SimpleVector() {
-    delete[] array;
+template <typename T, typename LockPolicy, typename GrowthPolicy>
+SimpleVector<T, LockPolicy, GrowthPolicy>::~SimpleVector() {
+    releaseStorage();
     #ifdef DEBUG
     std::cout << "Deleted array" << std::endl;
     #endif
@@ -222,14 +699,13 @@ SimpleVector<T>::~SimpleVector() {
  * @brief Ensure that the array has enough capacity to add a new element by resizing it if necessary.
  * 
  * @details This method checks if the array has enough capacity to add a new element.
- * If the array is full, it resizes the array to twice its current capacity.
+ * If the array is full, it grows the array to the capacity chosen by the growth policy.
  * 
  */
-template <typename T>
-void SimpleVector<T>::ensureCapacity() {
-    std::lock_guard<std::mutex> lock(mtx); // Lock for thread-safety
-    if (count == capacity) {
-        resize(2 * capacity);
+template <typename T, typename LockPolicy, typename GrowthPolicy>
+void SimpleVector<T, LockPolicy, GrowthPolicy>::ensureCapacity() {
+    if (elementCount == capacity) {
+        resize(calculateNewCapacity());
     }
     #ifdef DEBUG
     std::cout << "Ensured capacity" << std::endl;
@@ -239,61 +715,38 @@ void SimpleVector<T>::ensureCapacity() {
 /**
  * @brief Calculate the new capacity of the array.
  * 
- * @details This method calculates the new capacity of the array when resizing.
+ * @details The growth policy decides the next capacity. A policy that does not grow the array, like capacity * 2
+ * at capacity 0, gets at least one more element and never fewer than 4. A result beyond the largest possible
+ * capacity is clamped to it.
  * 
  * @return The new capacity of the array.
  */
-template <typename T>
-int SimpleVector<T>::calculateNewCapacity() {
-    std::lock_guard<std::mutex> lock(mtx); // Lock for thread-safety
-
-    return 2 * capacity;
+template <typename T, typename LockPolicy, typename GrowthPolicy>
+size_t SimpleVector<T, LockPolicy, GrowthPolicy>::calculateNewCapacity() {
+    size_t newCapacity = GrowthPolicy::grow(capacity);
+    if (newCapacity <= capacity) {
+        newCapacity = std::max<size_t>(capacity + 1, 4);
+    }
+    if (newCapacity > maxElements()) {
+        return maxElements();
+    }
+    return newCapacity;
 }
 
 /**
- * @brief Resize the array to twice its current capacity.
- * 
- * @details This method resizes the array to twice its current capacity.
- * 
+ * @brief Grow the array to the capacity chosen by the growth policy.
  */
-template <typename T>
-void SimpleVector<T>::resize() {
-    std::lock_guard<std::mutex> lock(mtx); // Lock for thread-safety
-
+template <typename T, typename LockPolicy, typename GrowthPolicy>
+void SimpleVector<T, LockPolicy, GrowthPolicy>::resize() {
     #ifdef DEBUG
     std::cout << "Resizing array" << std::endl;
     #endif
 
-    int newCapacity = calculateNewCapacity();
+    size_t newCapacity = calculateNewCapacity();
     if(newCapacity <= capacity) {
         throw SimpleVectorException("New capacity must be greater than current capacity.");
     }
-
-    T* newArray = new T[newCapacity];
-    if(!newArray) {
-        throw SimpleVectorException("Memory allocation failed. Cannot resize array.");
-    }
-
-    for(unsigned int i = 0; i < count; i++) {
-        newArray[i] = array[i];
-    }
-    #ifdef DEBUG
-    std::cout << "Copied elements to new array" << std::endl;
-    #endif
-    delete[] array;
-    #ifdef DEBUG
-    std::cout << "Deleted old array" << std::endl;
-    #endif
-
-    array = newArray;
-    #ifdef DEBUG
-    std::cout << "Set array to new array" << std::endl;
-    #endif
-    capacity = newCapacity;
-    #ifdef DEBUG
-    std::cout << "Set capacity to new capacity" << std::endl;
-    #endif
-    
+    resize(newCapacity);
 }
 
 
@@ -308,77 +761,171 @@ void SimpleVector<T>::resize() {
  * @throw SimpleVectorException if the new capacity is less than the current capacity.
  * @throw SimpleVectorException if memory allocation fails.
  */
-template <typename T>  
-void SimpleVector<T>:: resize(unsigned int newCapacity) {
-    std::lock_guard<std::mutex> lock(mtx); // Lock for thread-safety
-
+template <typename T, typename LockPolicy, typename GrowthPolicy>
+void SimpleVector<T, LockPolicy, GrowthPolicy>::resize(size_t newCapacity) {
     #ifdef DEBUG
     std::cout << "Resizing array to new capacity: " << newCapacity << std::endl;
     #endif
     if(newCapacity == capacity) {
         throw SimpleVectorException("New capacity must be different from current capacity.");
     }
-
-    if(newCapacity > std::numeric_limits<unsigned int>::max()) {
-        throw SimpleVectorException("New capacity is too large for this SimpleVector implementation.");
-    }
-
-    T* newArray = new T[newCapacity];
-    if (!newArray) {
-        throw SimpleVectorException("Memory allocation failed.");
+    recordPeak();
+
+    size_t elementsToMove = (newCapacity < elementCount) ? newCapacity : elementCount;
+    T* newArray;
+    if (inlineBuffer != nullptr && newCapacity <= inlineCapacity) {
+        if (array == inlineBuffer) {
+            // Already inline: the inline capacity cannot change, so only drop the elements past newCapacity.
+            destroyRange(array + elementsToMove, array + elementCount);
+            elementCount = elementsToMove;
+            return;
+        }
+        // Shrinking a heap vector that fits inline again moves it back into the inline storage.
+        newArray = inlineBuffer;
+        newCapacity = inlineCapacity;
+    } else {
+        newArray = allocate(newCapacity);
     }
     #ifdef DEBUG
     std::cout << "Created new array with size: " << newCapacity << std::endl;
     #endif
-    int elementsToCopy = (newCapacity < count) ? newCapacity : count;
-    for (int i = 0; i < elementsToCopy; ++i) {
-        newArray[i] = array[i];
+    size_t moved = 0;
+    try {
+        // Move when it cannot throw, otherwise copy so the old array stays intact if construction fails.
+        for (; moved < elementsToMove; ++moved) {
+            new (newArray + moved) T(std::move_if_noexcept(array[moved]));
+        }
+    } catch (...) {
+        destroyRange(newArray, newArray + moved);
+        if (newArray != inlineBuffer) {
+            deallocate(newArray, newCapacity);
+        }
+        throw;
     }
     #ifdef DEBUG
-    std::cout << "Copied elements to new array" << std::endl;
+    std::cout << "Moved elements to new array" << std::endl;
     #endif
-    delete[] array;
+    destroyRange(array, array + elementCount);
+    if (array != inlineBuffer) {
+        deallocate(array, capacity);
+    }
     #ifdef DEBUG
     std::cout << "Deleted old array" << std::endl;
     #endif
 
     array = newArray;
-    #ifdef DEBUG
-    std::cout << "Set array to new array" << std::endl;
-    #endif
     capacity = newCapacity;
+    elementCount = elementsToMove;
+    statistics.reallocations++;
+    statistics.bytesCopied += elementsToMove * sizeof(T);
     #ifdef DEBUG
-    std::cout << "Set capacity to new capacity" << std::endl;
-    #endif
-    count = elementsToCopy;
-    #ifdef DEBUG
-    std::cout << "Set count to elements copied" << std::endl;
+    std::cout << "Set array, capacity and count" << std::endl;
     #endif
 }
 
+/**
+ * @brief Check if storage for the given number of elements is mapped with huge pages.
+ * 
+ * @details Arrays of at least SIMPLEVECTOR_HUGE_PAGE_THRESHOLD bytes bypass operator new, so random access over
+ * them needs far fewer TLB entries. The decision depends only on the size, so deallocate() can repeat it.
+ */
+template <typename T, typename LockPolicy, typename GrowthPolicy>
+bool SimpleVector<T, LockPolicy, GrowthPolicy>::usesHugePages(size_t slots) {
+#ifdef SIMPLEVECTOR_HUGE_PAGES
+    return SIMPLEVECTOR_HUGE_PAGE_THRESHOLD > 0 && alignof(T) <= HugePages::HUGE_PAGE_SIZE && slots * sizeof(T) >= SIMPLEVECTOR_HUGE_PAGE_THRESHOLD;
+#else
+    (void)slots;
+    return false;
+#endif
+}
+
+/**
+ * @brief Allocate raw storage for the specified number of elements.
+ * 
+ * @details The returned memory is suitably aligned for T but no element is constructed in it.
+ * Elements are created with placement new only when they are actually added to the vector.
+ * Large arrays are mapped with huge pages, see usesHugePages().
+ * 
+ * @param slots The number of elements the storage must be able to hold.
+ * 
+ * @return Pointer to the storage, or nullptr if slots is 0.
+ */
+template <typename T, typename LockPolicy, typename GrowthPolicy>
+T* SimpleVector<T, LockPolicy, GrowthPolicy>::allocate(size_t slots) {
+    if (slots == 0) {
+        return nullptr;
+    }
+    if (slots > maxElements()) {
+        throw SimpleVectorException("New capacity is too large for this SimpleVector implementation.");
+    }
+#ifdef SIMPLEVECTOR_HUGE_PAGES
+    if (usesHugePages(slots)) {
+        return static_cast<T*>(HugePages::map(sizeof(T) * slots));
+    }
+#endif
+    if (alignof(T) > __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+        return static_cast<T*>(::operator new(sizeof(T) * slots, std::align_val_t(alignof(T))));
+    }
+    return static_cast<T*>(::operator new(sizeof(T) * slots));
+}
+
+/**
+ * @brief Release storage obtained from allocate().
+ * 
+ * @details Every element in the storage must already have been destroyed.
+ * 
+ * @param storage The storage to release. May be nullptr.
+ * @param slots The number of elements the storage was allocated for.
+ */
+template <typename T, typename LockPolicy, typename GrowthPolicy>
+void SimpleVector<T, LockPolicy, GrowthPolicy>::deallocate(T* storage, size_t slots) {
+    if (storage == nullptr) {
+        return;
+    }
+#ifdef SIMPLEVECTOR_HUGE_PAGES
+    if (usesHugePages(slots)) {
+        HugePages::unmap(storage, sizeof(T) * slots);
+        return;
+    }
+#else
+    (void)slots;
+#endif
+    if (alignof(T) > __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+        ::operator delete(storage, std::align_val_t(alignof(T)));
+    } else {
+        ::operator delete(storage);
+    }
+}
+
+/**
+ * @brief Destroy every element in the range [first, last).
+ * 
+ * @details The storage itself is left untouched. Trivially destructible types skip the loop entirely.
+ */
+template <typename T, typename LockPolicy, typename GrowthPolicy>
+void SimpleVector<T, LockPolicy, GrowthPolicy>::destroyRange(T* first, T* last) {
+    if (std::is_trivially_destructible<T>::value) {
+        return;
+    }
+    for (; first != last; ++first) {
+        first->~T();
+    }
+}
+
 /**
  * @brief Release the memory used by the array.
  * 
  * @details This method releases the memory used by the array.
  * 
  */
-template <typename T>
-void SimpleVector<T>::releaseMemory() {
-    std::lock_guard<std::mutex> lock(mtx); // Lock for thread-safety
+template <typename T, typename LockPolicy, typename GrowthPolicy>
+void SimpleVector<T, LockPolicy, GrowthPolicy>::releaseMemory() {
+    WriteLock lock(lockPolicy); // Lock for thread-safety
 
     #ifdef DEBUG
     std::cout << "Releasing memory" << std::endl;
     #endif
-    delete[] array;
-    #ifdef DEBUG
-    std::cout << "Deleted array" << std::endl;
-    #endif
-    array = nullptr;
-    #ifdef DEBUG
-    std::cout << "Set array to nullptr" << std::endl;
-    #endif
-    capacity = 0;
-    count = 0;.
+    releaseStorage();
     #ifdef DEBUG
     std::cout << "Set capacity and count to 0" << std::endl;
     #endif
@@ -387,37 +934,66 @@ void SimpleVector<T>::releaseMemory() {
 /**
  * @brief Shrink the capacity of the array to match the count of elements.
  * 
- * @details This method shrinks the capacity of the array to match the count of elements.
+ * @details To avoid reallocating for a few unused slots, the array is only shrunk when the growth policy's
+ * shouldShrink() agrees. A heap array whose elements fit in the inline storage always moves back into it.
  * 
- * @return True if the memory was successfully reserved, false otherwise.
+ * @return True if the array was shrunk, false if it was kept as is.
  */
-template <typename T>
-bool SimpleVector<T>::shrinkToFit() {
-    std::lock_guard<std::mutex> lock(mtx); // Lock for thread-safety
+template <typename T, typename LockPolicy, typename GrowthPolicy>
+bool SimpleVector<T, LockPolicy, GrowthPolicy>::shrinkToFit() {
+    WriteLock lock(lockPolicy); // Lock for thread-safety
 
     #ifdef DEBUG
     std::cout << "Shrinking to fit" << std::endl;
     #endif
-    if (count < capacity) {
-        resize(count);
+    if (elementCount == capacity) {
+        return false;
+    }
+    bool backToInline = inlineBuffer != nullptr && array != inlineBuffer && elementCount <= inlineCapacity;
+    if (backToInline || GrowthPolicy::shouldShrink(elementCount, capacity)) {
+        resize(elementCount);
         return true;
     }
     return false;
 }
 
 /**
- * @brief Clear the array by setting all elements to their default value and resetting the count.
+ * @brief Destroy all elements, keeping the capacity.
  * 
- * @details This method clears the array by setting all elements to their default value and resetting the count.
+ * @details The array is not reallocated, so a vector that is cleared and refilled reuses its storage.
+ * Call releaseMemory() or shrinkToFit() to give the memory back.
  */
-template <typename T>
-void SimpleVector<T>::clear() {
-    std::lock_guard<std::mutex> lock(mtx); // Lock for thread-safety
+template <typename T, typename LockPolicy, typename GrowthPolicy>
+void SimpleVector<T, LockPolicy, GrowthPolicy>::clear() {
+    WriteLock lock(lockPolicy); // Lock for thread-safety
     #ifdef DEBUG
     std::cout << "Clearing array" << std::endl;
     #endif
-    resize(1);
-    count = 0;
+    destroyRange(array, array + elementCount);
+    elementCount = 0;
+}
+
+/**
+ * @brief Construct a new element at the end of the array.
+ * 
+ * @details The caller must already hold the write lock. When the array is full the new element is
+ * built in a temporary first, because the arguments may refer to elements that the resize is about to move.
+ * 
+ * @param args The arguments forwarded to the constructor of T.
+ * 
+ * @return Reference to the new element.
+ */
+template <typename T, typename LockPolicy, typename GrowthPolicy>
+template<typename... Args>
+T& SimpleVector<T, LockPolicy, GrowthPolicy>::emplaceUnlocked(Args&&... args) {
+    if(elementCount == capacity) {
+        T temp(std::forward<Args>(args)...);
+        ensureCapacity();
+        new (array + elementCount) T(std::move(temp));
+    } else {
+        new (array + elementCount) T(std::forward<Args>(args)...);
+    }
+    return array[elementCount++];
 }
 
 /**
@@ -427,17 +1003,28 @@ void SimpleVector<T>::clear() {
  * 
  * @param item The item to be added to the array.
  */
-template <typename T>
-void SimpleVector<T>::push_back(const T& item) {
-    std::lock_guard<std::mutex> lock(mtx); // Lock for thread-safety
+template <typename T, typename LockPolicy, typename GrowthPolicy>
+void SimpleVector<T, LockPolicy, GrowthPolicy>::push_back(const T& item) {
+    WriteLock lock(lockPolicy); // Lock for thread-safety
 
     #ifdef DEBUG
     std::cout << "Pushing back element: " << item << std::endl;
     #endif
-    if(count == capacity) {
-        resize(2 * capacity);
-    }
-    array[count++] = item;
+    emplaceUnlocked(item);
+}
+
+/**
+ * @brief Add an element to the array by moving it.
+ * 
+ * @details This method adds an element to the array, moving from the argument instead of copying it.
+ * 
+ * @param item The item to be moved into the array.
+ */
+template <typename T, typename LockPolicy, typename GrowthPolicy>
+void SimpleVector<T, LockPolicy, GrowthPolicy>::push_back(T&& item) {
+    WriteLock lock(lockPolicy); // Lock for thread-safety
+
+    emplaceUnlocked(std::move(item));
 }
 
 /**
@@ -447,17 +1034,14 @@ void SimpleVector<T>::push_back(const T& item) {
  * 
  * @param item The item to be added to the array.
  */
-template <typename T>
-void SimpleVector<T>::put(const T& item) {
-    std::lock_guard<std::mutex> lock(mtx); // Lock for thread-safety
+template <typename T, typename LockPolicy, typename GrowthPolicy>
+void SimpleVector<T, LockPolicy, GrowthPolicy>::put(const T& item) {
+    WriteLock lock(lockPolicy); // Lock for thread-safety
 
     #ifdef DEBUG
     std::cout << "Adding element: " << item << std::endl;
     #endif
-    if(count == capacity) {
-        resize(2 * capacity);
-    }
-    array[count++] = item;
+    emplaceUnlocked(item);
 }
 
 /**
@@ -470,10 +1054,10 @@ void SimpleVector<T>::put(const T& item) {
  * 
  * @param args The elements to be added to the array.
  */
-template <typename T>
+template <typename T, typename LockPolicy, typename GrowthPolicy>
 template<typename... Args>
-void SimpleVector<T>::bulk_add(Args&&... args) {
-    std::lock_guard<std::mutex> lock(mtx); // Lock for thread-safety
+void SimpleVector<T, LockPolicy, GrowthPolicy>::bulk_add(Args&&... args) {
+    WriteLock lock(lockPolicy); // Lock for thread-safety
 
 #ifdef DEBUG
     std::cout << "Adding multiple elements" << std::endl;
@@ -484,73 +1068,276 @@ void SimpleVector<T>::bulk_add(Args&&... args) {
         throw SimpleVectorException("No elements to add.");
     }
 
-    if (argsCount > std::numeric_limits<unsigned int>::max()) {
-        throw SimpleVectorException("Too many elements to add.");
+    // The lock is already held, so append directly instead of going through put(). The arguments are all
+    // constructed before the old elements are released, so they may refer to elements of this vector.
+    appendUnlocked(argsCount, [&](T* dest) {
+        size_t constructed = 0;
+        try {
+            int dummy[] = { (new (dest + constructed) T(std::forward<Args>(args)), ++constructed, 0)... };
+            (void)dummy; // To avoid unused variable warning
+        } catch (...) {
+            destroyRange(dest, dest + constructed);
+            throw;
+        }
+    });
+}
+
+/**
+ * @brief Add an element to the array using emplace.
+ * 
+ * @details This method constructs a new element in place at the end of the array, forwarding the arguments to the constructor of T.
+ * 
+ * @note Definition: Emplace is a member function in C++ STL. It is used to insert a new element into the container.
+ * @param args The arguments used to construct the new element.
+ * 
+ * @return Reference to the newly constructed element.
+ */
+template <typename T, typename LockPolicy, typename GrowthPolicy>
+template<typename... Args>
+T& SimpleVector<T, LockPolicy, GrowthPolicy>::emplace_back(Args&&... args) {
+    WriteLock lock(lockPolicy); // Lock for thread-safety
+
+    #ifdef DEBUG
+    std::cout << "Emplacing element" << std::endl;
+    #endif
+    return emplaceUnlocked(std::forward<Args>(args)...);
+}
+
+/**
+ * @brief Calculate the capacity to grow to so that at least the given number of elements fit.
+ * 
+ * @details The usual growth step is used when it is large enough, so repeated batches still grow geometrically.
+ * 
+ * @param needed The number of elements that must fit.
+ * 
+ * @return The new capacity of the array.
+ * 
+ * @throw SimpleVectorException if needed exceeds the maximum size of the vector.
+ */
+template <typename T, typename LockPolicy, typename GrowthPolicy>
+size_t SimpleVector<T, LockPolicy, GrowthPolicy>::growthCapacity(size_t needed) {
+    if (needed > maxElements()) {
+        throw SimpleVectorException("Adding these elements would cause an overflow.");
     }
+    return std::max(calculateNewCapacity(), needed);
+}
 
-    unsigned int newCount = count + static_cast<unsigned int>(argsCount);
-    if (newCount < count) {  // Check for overflow
+/**
+ * @brief Construct a batch of elements at the end of the array.
+ * 
+ * @details The caller must already hold the write lock. The array grows at most once. When it grows, the new elements
+ * are constructed in the new array before the old elements are moved, so the source may be part of this vector.
+ * If construction throws, the vector is left unchanged.
+ * 
+ * @param n The number of elements to add.
+ * @param construct Callable that constructs exactly n elements at the given raw storage, cleaning up after itself if it throws.
+ * 
+ * @throw SimpleVectorException if the vector would exceed its maximum size.
+ */
+template <typename T, typename LockPolicy, typename GrowthPolicy>
+template<typename Construct>
+void SimpleVector<T, LockPolicy, GrowthPolicy>::appendUnlocked(size_t n, Construct construct) {
+    if (n == 0) {
+        return;
+    }
+    if (n > maxElements() - elementCount) {
         throw SimpleVectorException("Adding these elements would cause an overflow.");
     }
+    size_t needed = elementCount + n;
+    if (needed <= capacity) {
+        construct(array + elementCount);
+        elementCount = needed;
+        return;
+    }
 
-    if (newCount > capacity) {
-        size_t newCapacity = std::max(static_cast<size_t>(capacity) * 2, static_cast<size_t>(newCount));
-        if (newCapacity > std::numeric_limits<unsigned int>::max()) {
-            newCapacity = std::numeric_limits<unsigned int>::max();
+    size_t newCapacity = growthCapacity(needed);
+    T* newArray = allocate(newCapacity);
+    try {
+        construct(newArray + elementCount);
+    } catch (...) {
+        deallocate(newArray, newCapacity);
+        throw;
+    }
+
+    if (std::is_trivially_copyable<T>::value) {
+        if (elementCount > 0) {
+            std::memcpy(static_cast<void*>(newArray), static_cast<const void*>(array), elementCount * sizeof(T));
+        }
+    } else {
+        size_t moved = 0;
+        try {
+            for (; moved < elementCount; ++moved) {
+                new (newArray + moved) T(std::move_if_noexcept(array[moved]));
+            }
+        } catch (...) {
+            destroyRange(newArray, newArray + moved);
+            destroyRange(newArray + elementCount, newArray + needed);
+            deallocate(newArray, newCapacity);
+            throw;
         }
-        resize(static_cast<unsigned int>(newCapacity));
+        destroyRange(array, array + elementCount);
+    }
+    if (array != inlineBuffer) {
+        deallocate(array, capacity);
     }
 
-    int dummy[] = { (put(std::forward<Args>(args)), 0)... };
-    (void)dummy; // To avoid unused variable warning
+    statistics.reallocations++;
+    statistics.bytesCopied += elementCount * sizeof(T);
+    array = newArray;
+    capacity = newCapacity;
+    elementCount = needed;
 }
 
 /**
- * @brief Add an element to the array using emplace.
+ * @brief Copy-construct elements from a range into raw storage.
+ * 
+ * @details Trivially copyable elements read from a plain array are copied with a single memcpy.
+ * Otherwise the elements are constructed one by one, and the ones already built are destroyed if a constructor throws.
+ * 
+ * @param dest Raw storage for n elements.
+ * @param first Iterator to the first source element.
+ * @param n The number of elements to copy.
+ */
+template <typename T, typename LockPolicy, typename GrowthPolicy>
+template<typename InputIt>
+void SimpleVector<T, LockPolicy, GrowthPolicy>::constructRange(T* dest, InputIt first, size_t n) {
+    typedef typename std::remove_cv<typename std::remove_pointer<InputIt>::type>::type Pointee;
+    if constexpr (std::is_pointer<InputIt>::value && std::is_same<Pointee, T>::value && std::is_trivially_copyable<T>::value) {
+        std::memcpy(static_cast<void*>(dest), static_cast<const void*>(first), n * sizeof(T));
+    } else {
+        size_t constructed = 0;
+        try {
+            for (; constructed < n; ++constructed, ++first) {
+                new (dest + constructed) T(*first);
+            }
+        } catch (...) {
+            destroyRange(dest, dest + constructed);
+            throw;
+        }
+    }
+}
+
+/**
+ * @brief Make room for at least the specified number of elements.
  * 
- * @details This method adds an element to the array using emplace.
+ * @details Growing ahead of a large batch of push_back calls avoids the intermediate reallocations.
+ * This method never shrinks the array.
+ * 
+ * @param n The number of elements the array must be able to hold.
+ * 
+ * @throw SimpleVectorException if n exceeds the maximum size of the vector.
  */
-template <typename T>
-void SimpleVector<T>::emplace_back() {
-    std::lock_guard<std::mutex> lock(mtx); // Lock for thread-safety
+template <typename T, typename LockPolicy, typename GrowthPolicy>
+void SimpleVector<T, LockPolicy, GrowthPolicy>::reserve(size_t n) {
+    WriteLock lock(lockPolicy); // Lock for thread-safety
 
-    #ifdef DEBUG
-    std::cout << "Emplacing element" << std::endl;
-    #endif
-    ensureCapacity();
-    try{
-        new (array + count) T();
-        count++;
-    } catch (std::bad_alloc& e) {
-        std::cerr << "Error: " << e.what() << std::endl;
-        throw;
+    if (n > maxElements()) {
+        throw SimpleVectorException("Requested capacity exceeds the maximum size.");
+    }
+    if (n > capacity) {
+        resize(n);
     }
-    
 }
 
 /**
- * @brief Add an element to the array using emplace.
+ * @brief Add elements copied from an array.
  * 
- * @details This method adds an element to the array using emplace.
+ * @details The lock is taken once and the array grows at most once. Trivially copyable elements are copied with memcpy.
+ * The source may point into this vector.
  * 
- * @note Definition: Emplace is a member function in C++ STL. It is used to insert a new element into the container.
- * @param value The value of the element to be added to the array.
+ * @param first Pointer to the first element to copy.
+ * @param n The number of elements to copy.
  */
-template <typename T>
-void SimpleVector<T>::emplace_back(const T& value) {
-    std::lock_guard<std::mutex> lock(mtx); // Lock for thread-safety
+template <typename T, typename LockPolicy, typename GrowthPolicy>
+void SimpleVector<T, LockPolicy, GrowthPolicy>::append(const T* first, size_t n) {
+    WriteLock lock(lockPolicy); // Lock for thread-safety
 
-    #ifdef DEBUG
-    std::cout << "Emplacing element: " << value << std::endl;
-    #endif
-    ensureCapacity();
-    try{
-        new (array + count) T(value);
-        count++;
-    } catch (std::bad_alloc& e) {
-        std::cerr << "Error: " << e.what() << std::endl;
-        throw;
+    appendUnlocked(n, [first, n](T* dest) { constructRange(dest, first, n); });
+}
+
+/**
+ * @brief Add the elements of a range.
+ * 
+ * @details The lock is taken once. For forward iterators the array grows at most once; single-pass input
+ * iterators cannot be measured up front and fall back to growing as needed.
+ * 
+ * @tparam InputIt The iterator type of the range.
+ * 
+ * @param first Iterator to the first element to add.
+ * @param last Iterator one past the last element to add.
+ */
+template <typename T, typename LockPolicy, typename GrowthPolicy>
+template<typename InputIt>
+void SimpleVector<T, LockPolicy, GrowthPolicy>::append(InputIt first, InputIt last) {
+    WriteLock lock(lockPolicy); // Lock for thread-safety
+
+    typedef typename std::iterator_traits<InputIt>::iterator_category Category;
+    if constexpr (std::is_base_of<std::forward_iterator_tag, Category>::value) {
+        size_t n = static_cast<size_t>(std::distance(first, last));
+        appendUnlocked(n, [first, n](T* dest) { constructRange(dest, first, n); });
+    } else {
+        for (; first != last; ++first) {
+            emplaceUnlocked(*first);
+        }
+    }
+}
+
+/**
+ * @brief Insert elements copied from an array before the specified index.
+ * 
+ * @details The elements are appended in one batch and then rotated into place, so the lock is taken once
+ * and the array grows at most once.
+ * 
+ * @param index The position to insert at. Must not be greater than the number of elements.
+ * @param first Pointer to the first element to copy.
+ * @param n The number of elements to copy.
+ * 
+ * @throw SimpleVectorException if the index is out of range.
+ */
+template <typename T, typename LockPolicy, typename GrowthPolicy>
+void SimpleVector<T, LockPolicy, GrowthPolicy>::insert(size_t index, const T* first, size_t n) {
+    WriteLock lock(lockPolicy); // Lock for thread-safety
+
+    if (index > elementCount) {
+        throw SimpleVectorException("Index out of range.");
+    }
+    size_t oldCount = elementCount;
+    appendUnlocked(n, [first, n](T* dest) { constructRange(dest, first, n); });
+    std::rotate(array + index, array + oldCount, array + elementCount);
+}
+
+/**
+ * @brief Insert the elements of a range before the specified index.
+ * 
+ * @details The elements are appended in one batch and then rotated into place, so the lock is taken once.
+ * 
+ * @tparam InputIt The iterator type of the range.
+ * 
+ * @param index The position to insert at. Must not be greater than the number of elements.
+ * @param first Iterator to the first element to insert.
+ * @param last Iterator one past the last element to insert.
+ * 
+ * @throw SimpleVectorException if the index is out of range.
+ */
+template <typename T, typename LockPolicy, typename GrowthPolicy>
+template<typename InputIt>
+void SimpleVector<T, LockPolicy, GrowthPolicy>::insert(size_t index, InputIt first, InputIt last) {
+    WriteLock lock(lockPolicy); // Lock for thread-safety
+
+    if (index > elementCount) {
+        throw SimpleVectorException("Index out of range.");
     }
+    size_t oldCount = elementCount;
+    typedef typename std::iterator_traits<InputIt>::iterator_category Category;
+    if constexpr (std::is_base_of<std::forward_iterator_tag, Category>::value) {
+        size_t n = static_cast<size_t>(std::distance(first, last));
+        appendUnlocked(n, [first, n](T* dest) { constructRange(dest, first, n); });
+    } else {
+        for (; first != last; ++first) {
+            emplaceUnlocked(*first);
+        }
+    }
+    std::rotate(array + index, array + oldCount, array + elementCount);
 }
 
 /**
@@ -560,17 +1347,17 @@ void SimpleVector<T>::emplace_back(const T& value) {
  * 
  * @return The last element in the array.
  */
-template <typename T>
-T& SimpleVector<T>::back() {
-    std::lock_guard<std::mutex> lock(mtx); // Lock for thread-safety
+template <typename T, typename LockPolicy, typename GrowthPolicy>
+T& SimpleVector<T, LockPolicy, GrowthPolicy>::back() {
+    ReadLock lock(lockPolicy); // Shared lock for thread-safety
 
     #ifdef DEBUG
     std::cout << "Getting last element" << std::endl;
     #endif
-    if(count == 0) {
+    if(elementCount == 0) {
         throw IndexOutOfBoundsException("Array is empty.");
     }
-    return array[count - 1];
+    return array[elementCount - 1];
 }
 
 /**
@@ -580,14 +1367,14 @@ T& SimpleVector<T>::back() {
  * 
  * @return The first element in the array.
  */
-template <typename T>
-T& SimpleVector<T>::front() {
-    std::lock_guard<std::mutex> lock(mtx); // Lock for thread-safety
+template <typename T, typename LockPolicy, typename GrowthPolicy>
+T& SimpleVector<T, LockPolicy, GrowthPolicy>::front() {
+    ReadLock lock(lockPolicy); // Shared lock for thread-safety
 
     #ifdef DEBUG
     std::cout << "Getting first element" << std::endl;
     #endif
-    if(count == 0) {
+    if(elementCount == 0) {
         throw IndexOutOfBoundsException("Array is empty.");
     }
     return array[0];
@@ -600,19 +1387,39 @@ T& SimpleVector<T>::front() {
  * 
  * @param item The item to be removed from the array.
  */
-template <typename T>
-void SimpleVector<T>::remove(const T& item) {
-    std::lock_guard<std::mutex> lock(mtx); // Lock for thread-safety
-
-    unsigned int index = 0;
-    for (unsigned int i = 0; i < count; i++) {
-        if (array[i] == item) {
-            // Element found, skip it
-            continue;
+template <typename T, typename LockPolicy, typename GrowthPolicy>
+void SimpleVector<T, LockPolicy, GrowthPolicy>::remove(const T& item) {
+    WriteLock lock(lockPolicy); // Lock for thread-safety
+
+    if constexpr (std::is_trivially_copyable<T>::value) {
+        // Use the search kernel to skip over runs without a match and slide each run down in one memmove.
+        size_t write = SimdKernels<T>::find(array, elementCount, item);
+        size_t read = write + 1;
+        while (read < elementCount) {
+            size_t next = read + SimdKernels<T>::find(array + read, elementCount - read, item);
+            std::memmove(static_cast<void*>(array + write), static_cast<const void*>(array + read), (next - read) * sizeof(T));
+            write += next - read;
+            read = next + 1;
+        }
+        if (write < elementCount) {
+            destroyRange(array + write, array + elementCount);
+            elementCount = write;
         }
-        array[index++] = array[i];
+    } else {
+        size_t index = 0;
+        for (size_t i = 0; i < elementCount; i++) {
+            if (array[i] == item) {
+                // Element found, skip it
+                continue;
+            }
+            if (index != i) {
+                array[index] = std::move(array[i]);
+            }
+            index++;
+        }
+        destroyRange(array + index, array + elementCount);
+        elementCount = index;
     }
-    count = index;
 }
 
 /**
@@ -623,12 +1430,11 @@ void SimpleVector<T>::remove(const T& item) {
  * @param index The index of the element to be accessed.
  * @return The element at the specified index.
  */
-template <typename T>
-T& SimpleVector<T>::operator[](unsigned int index) {
-    std::lock_guard<std::mutex> lock(mtx); // Lock for thread-safety
+template <typename T, typename LockPolicy, typename GrowthPolicy>
+T& SimpleVector<T, LockPolicy, GrowthPolicy>::operator[](size_t index) {
+    ReadLock lock(lockPolicy); // Shared lock for thread-safety
 
-    static T dummy;
-    if (index >= count || index < 0) {
+    if (index >= elementCount) {
         throw IndexOutOfBoundsException("Error: Index out of bounds.");
     }
     return array[index];
@@ -642,16 +1448,72 @@ T& SimpleVector<T>::operator[](unsigned int index) {
  * @param index The index of the element to be accessed.
  * @return The element at the specified index.
  */
-template <typename T>
-const T& SimpleVector<T>::operator[](unsigned int index) const {
-    std::lock_guard<std::mutex> lock(mtx); // Lock for thread-safety
+template <typename T, typename LockPolicy, typename GrowthPolicy>
+const T& SimpleVector<T, LockPolicy, GrowthPolicy>::operator[](size_t index) const {
+    ReadLock lock(lockPolicy); // Shared lock for thread-safety
 
-    if (index >= count || index < 0) {
+    if (index >= elementCount) {
         throw IndexOutOfBoundsException("Error: Index out of bounds. "); // You can handle this error differently if needed
     }
     return array[index];
 }
 
+/**
+ * @brief Get the element at the specified index without locking or bounds checking.
+ * 
+ * @details This is the fast path for hot loops that have already checked the index and know no other thread
+ * is modifying the vector. Passing an index outside [0, elements()) is undefined behaviour.
+ * 
+ * @param index The index of the element to be accessed.
+ * @return The element at the specified index.
+ */
+template <typename T, typename LockPolicy, typename GrowthPolicy>
+T& SimpleVector<T, LockPolicy, GrowthPolicy>::at_unchecked(size_t index) {
+    return array[index];
+}
+
+/**
+ * @brief Get the element at the specified index without locking or bounds checking.
+ * 
+ * @details Const version of at_unchecked. Passing an index outside [0, elements()) is undefined behaviour.
+ * 
+ * @param index The index of the element to be accessed.
+ * @return The element at the specified index.
+ */
+template <typename T, typename LockPolicy, typename GrowthPolicy>
+const T& SimpleVector<T, LockPolicy, GrowthPolicy>::at_unchecked(size_t index) const {
+    return array[index];
+}
+
+/**
+ * @brief Get a pointer to the underlying array.
+ * 
+ * @details The elements are stored contiguously, so [data(), data() + elements()) is a valid range.
+ * The pointer is invalidated when the vector reallocates, and access through it is not synchronized.
+ * 
+ * @return Pointer to the first element, or nullptr if the vector has no storage.
+ */
+template <typename T, typename LockPolicy, typename GrowthPolicy>
+T* SimpleVector<T, LockPolicy, GrowthPolicy>::data() {
+    ReadLock lock(lockPolicy); // Shared lock for thread-safety
+
+    return array;
+}
+
+/**
+ * @brief Get a pointer to the underlying array.
+ * 
+ * @details Const version of data().
+ * 
+ * @return Pointer to the first element, or nullptr if the vector has no storage.
+ */
+template <typename T, typename LockPolicy, typename GrowthPolicy>
+const T* SimpleVector<T, LockPolicy, GrowthPolicy>::data() const {
+    ReadLock lock(lockPolicy); // Shared lock for thread-safety
+
+    return array;
+}
+
 /**
  * @brief Get the capacity of the Array.
  * 
@@ -659,9 +1521,9 @@ const T& SimpleVector<T>::operator[](unsigned int index) const {
  * 
  * @return The capacity of the array.
  */
-template <typename T>
-unsigned int SimpleVector<T>::size() const {
-    std::lock_guard<std::mutex> lock(mtx); // Lock for thread-safety
+template <typename T, typename LockPolicy, typename GrowthPolicy>
+size_t SimpleVector<T, LockPolicy, GrowthPolicy>::size() const {
+    ReadLock lock(lockPolicy); // Shared lock for thread-safety
 
     if(this -> capacity == 0){
         return 0;
@@ -676,14 +1538,14 @@ unsigned int SimpleVector<T>::size() const {
  * 
  * @return The number of elements in the array.
  */
-template <typename T>
-unsigned int SimpleVector<T>::elements() const {
-    std::lock_guard<std::mutex> lock(mtx); // Lock for thread-safety
+template <typename T, typename LockPolicy, typename GrowthPolicy>
+size_t SimpleVector<T, LockPolicy, GrowthPolicy>::elements() const {
+    ReadLock lock(lockPolicy); // Shared lock for thread-safety
 
-    if(this -> count == 0){
+    if(this -> elementCount == 0){
         return 0;
     }
-    return this -> count;
+    return this -> elementCount;
 }
 
 /**
@@ -696,16 +1558,13 @@ unsigned int SimpleVector<T>::elements() const {
  * @throw IndexOutOfBoundsException if the index is out of bounds.
  * @return Reference to the element at the specified index.
  */
-template <typename T>
-T& SimpleVector<T>::get(unsigned int index) {
-    std::lock_guard<std::mutex> lock(mtx); // Lock for thread-safety
+template <typename T, typename LockPolicy, typename GrowthPolicy>
+T& SimpleVector<T, LockPolicy, GrowthPolicy>::get(size_t index) {
+    ReadLock lock(lockPolicy); // Shared lock for thread-safety
 
-    if (index >= count) {
+    if (index >= elementCount) {
         throw IndexOutOfBoundsException("Error: Index out of bounds: index cannot be greater than count.");
     }
-    if (index < 0) {
-        throw IndexOutOfBoundsException("Error: Index out of bounds: index cannot be negative.");
-    }
     return array[index];
 }
 
@@ -716,11 +1575,11 @@ T& SimpleVector<T>::get(unsigned int index) {
  * 
  * @return True if the array is empty, false otherwise.
  */
-template <typename T>
-bool SimpleVector<T>::isEmpty() const {
-    std::lock_guard<std::mutex> lock(mtx); // Lock for thread-safety
+template <typename T, typename LockPolicy, typename GrowthPolicy>
+bool SimpleVector<T, LockPolicy, GrowthPolicy>::isEmpty() const {
+    ReadLock lock(lockPolicy); // Shared lock for thread-safety
 
-    return count == 0;
+    return elementCount == 0;
 }
 
 /**
@@ -732,39 +1591,61 @@ bool SimpleVector<T>::isEmpty() const {
  * 
  * @return The index of the specified element.
  */
-template <typename T>
-int SimpleVector<T>::indexOf(const T& element) {
-    std::lock_guard<std::mutex> lock(mtx); // Lock for thread-safety
+template <typename T, typename LockPolicy, typename GrowthPolicy>
+ptrdiff_t SimpleVector<T, LockPolicy, GrowthPolicy>::indexOf(const T& element) {
+    ReadLock lock(lockPolicy); // Shared lock for thread-safety
 
-    for (unsigned int i = 0; i < count; i++) {
-        if (array[i] == element) {
-            return i;
-        }
-    }
-    return -1;
+    size_t index = SimdKernels<T>::find(array, elementCount, element);
+    return index == elementCount ? -1 : static_cast<ptrdiff_t>(index);
 }
 
 /**
- * @brief The SimpleVectorIterator class.
- *
- * @details This class represents an iterator for the SimpleVector class.
- *
- * @tparam T The type of the elements in the SimpleVector.
+ * @brief Contiguous random-access iterator over the elements of a SimpleVector.
+ * 
+ * @details The iterator is a thin wrapper around a pointer, so it works with the standard algorithms
+ * (std::sort, std::lower_bound, ...) and loops over it compile to the same code as loops over a raw array.
+ * It also remembers the end of the range for the Java-style hasNext()/next() interface.
+ * 
+ * The iterator does not lock the vector. Like a pointer, it is invalidated when the vector reallocates.
+ * 
+ * @tparam Element T for a mutable iterator, const T for a const iterator.
  */
-template <typename T>
-class SimpleVector<T>::SimpleVectorIterator {
+template <typename T, typename LockPolicy, typename GrowthPolicy>
+template <typename Element>
+class SimpleVector<T, LockPolicy, GrowthPolicy>::BasicIterator {
+    template <typename Other>
+    friend class BasicIterator;
+
 private:
-    T* current;
-    T* end;
+    Element* current;
+    Element* end;
 
 public:
-    SimpleVectorIterator(T* start, T* stop) : current(start), end(stop) {}
+#if __cplusplus >= 202002L
+    using iterator_category = std::contiguous_iterator_tag;
+    using element_type = Element;
+#else
+    using iterator_category = std::random_access_iterator_tag;
+#endif
+    using value_type = typename std::remove_const<Element>::type;
+    using difference_type = std::ptrdiff_t;
+    using pointer = Element*;
+    using reference = Element&;
+
+    BasicIterator() : current(nullptr), end(nullptr) {}
+    BasicIterator(Element* start, Element* stop) : current(start), end(stop) {}
+
+    /**
+     * @brief Convert a mutable iterator to a const iterator
+    */
+    template <typename Other, typename = typename std::enable_if<std::is_same<const Other, Element>::value && !std::is_same<Other, Element>::value>::type>
+    BasicIterator(const BasicIterator<Other>& other) : current(other.current), end(other.end) {}
 
     /**
      * @brief Check if the iterator has reached the end of the vector
      * @return True if the iterator has reached the end of the vector, false otherwise
     */
-    bool hasNext() {
+    bool hasNext() const {
         return current != end;
     }
 
@@ -772,15 +1653,36 @@ public:
      * @brief Get the next element in the vector
      * @return The next element in the vector
     */
-    T& next() {
+    reference next() {
         return *current++;
     }
 
     // The iterator needs to be compatible with STL-style iteration
+    /**
+     * @brief Overload the dereference operator
+    */
+    reference operator*() const {
+        return *current;
+    }
+
+    /**
+     * @brief Overload the member access operator
+    */
+    pointer operator->() const {
+        return current;
+    }
+
+    /**
+     * @brief Overload the subscript operator
+    */
+    reference operator[](difference_type offset) const {
+        return current[offset];
+    }
+
     /**
      * @brief Overload the prefix increment operator
     */
-    SimpleVectorIterator& operator++() {
+    BasicIterator& operator++() {
         ++current;
         return *this;
     }
@@ -788,33 +1690,79 @@ public:
     /**
      * @brief Overload the postfix increment operator
     */
-    bool operator!=(const SimpleVectorIterator& other) const {
-        return current != other.current;
+    BasicIterator operator++(int) {
+        BasicIterator previous = *this;
+        ++current;
+        return previous;
+    }
+
+    /**
+     * @brief Overload the prefix decrement operator
+    */
+    BasicIterator& operator--() {
+        --current;
+        return *this;
     }
+
     /**
-     * @brief Overload the dereference operator
+     * @brief Overload the postfix decrement operator
     */
-    T& operator*() {
-        return *current;
+    BasicIterator operator--(int) {
+        BasicIterator previous = *this;
+        --current;
+        return previous;
     }
 
-};
+    BasicIterator& operator+=(difference_type offset) {
+        current += offset;
+        return *this;
+    }
+
+    BasicIterator& operator-=(difference_type offset) {
+        current -= offset;
+        return *this;
+    }
+
+    friend BasicIterator operator+(BasicIterator it, difference_type offset) {
+        return it += offset;
+    }
+
+    friend BasicIterator operator+(difference_type offset, BasicIterator it) {
+        return it += offset;
+    }
 
+    friend BasicIterator operator-(BasicIterator it, difference_type offset) {
+        return it -= offset;
+    }
 
+    /**
+     * @brief Get the number of elements between two iterators
+    */
+    friend difference_type operator-(const BasicIterator& lhs, const BasicIterator& rhs) {
+        return lhs.current - rhs.current;
+    }
 
+    friend bool operator==(const BasicIterator& lhs, const BasicIterator& rhs) { return lhs.current == rhs.current; }
+    friend bool operator!=(const BasicIterator& lhs, const BasicIterator& rhs) { return lhs.current != rhs.current; }
+    friend bool operator<(const BasicIterator& lhs, const BasicIterator& rhs) { return lhs.current < rhs.current; }
+    friend bool operator>(const BasicIterator& lhs, const BasicIterator& rhs) { return lhs.current > rhs.current; }
+    friend bool operator<=(const BasicIterator& lhs, const BasicIterator& rhs) { return lhs.current <= rhs.current; }
+    friend bool operator>=(const BasicIterator& lhs, const BasicIterator& rhs) { return lhs.current >= rhs.current; }
+};
 
 /**
  * @brief Get an iterator pointing to the first element in the array.
  * 
  * @details This method gets an iterator pointing to the first element in the array.
+ * The lock is only held while the iterator is created; iterating is unsynchronized.
  * 
  * @return An iterator pointing to the first element in the array.
  */
-template <typename T>
-typename SimpleVector<T>::SimpleVectorIterator SimpleVector<T>::begin() {
-    std::lock_guard<std::mutex> lock(mtx); // Lock for thread-safety
+template <typename T, typename LockPolicy, typename GrowthPolicy>
+typename SimpleVector<T, LockPolicy, GrowthPolicy>::SimpleVectorIterator SimpleVector<T, LockPolicy, GrowthPolicy>::begin() {
+    ReadLock lock(lockPolicy); // Shared lock for thread-safety
 
-    return SimpleVectorIterator(array, array + count);
+    return SimpleVectorIterator(array, array + elementCount);
 }
 
 /**
@@ -824,11 +1772,11 @@ typename SimpleVector<T>::SimpleVectorIterator SimpleVector<T>::begin() {
  * 
  * @return An iterator pointing to one past the last element in the array.
  */
-template <typename T>
-typename SimpleVector<T>::SimpleVectorIterator SimpleVector<T>::end() {
-    std::lock_guard<std::mutex> lock(mtx); // Lock for thread-safety
+template <typename T, typename LockPolicy, typename GrowthPolicy>
+typename SimpleVector<T, LockPolicy, GrowthPolicy>::SimpleVectorIterator SimpleVector<T, LockPolicy, GrowthPolicy>::end() {
+    ReadLock lock(lockPolicy); // Shared lock for thread-safety
 
-    return SimpleVectorIterator(array + count, array + count);
+    return SimpleVectorIterator(array + elementCount, array + elementCount);
 }
 
 /**
@@ -838,11 +1786,37 @@ typename SimpleVector<T>::SimpleVectorIterator SimpleVector<T>::end() {
  * 
  * @return A const iterator pointing to the first element in the array.
  */
-template <typename T>
-const typename SimpleVector<T>::SimpleVectorIterator SimpleVector<T>::cbegin() {
-    std::lock_guard<std::mutex> lock(mtx); // Lock for thread-safety
+template <typename T, typename LockPolicy, typename GrowthPolicy>
+typename SimpleVector<T, LockPolicy, GrowthPolicy>::ConstSimpleVectorIterator SimpleVector<T, LockPolicy, GrowthPolicy>::begin() const {
+    ReadLock lock(lockPolicy); // Shared lock for thread-safety
+
+    return ConstSimpleVectorIterator(array, array + elementCount);
+}
+
+/**
+ * @brief Get a const iterator pointing to one past the last element in the array.
+ * 
+ * @details This method gets a const iterator pointing to one past the last element in the array.
+ * 
+ * @return A const iterator pointing to one past the last element in the array.
+ */
+template <typename T, typename LockPolicy, typename GrowthPolicy>
+typename SimpleVector<T, LockPolicy, GrowthPolicy>::ConstSimpleVectorIterator SimpleVector<T, LockPolicy, GrowthPolicy>::end() const {
+    ReadLock lock(lockPolicy); // Shared lock for thread-safety
 
-    return SimpleVectorIterator(array, array + count);
+    return ConstSimpleVectorIterator(array + elementCount, array + elementCount);
+}
+
+/**
+ * @brief Get a const iterator pointing to the first element in the array.
+ * 
+ * @details This method gets a const iterator pointing to the first element in the array.
+ * 
+ * @return A const iterator pointing to the first element in the array.
+ */
+template <typename T, typename LockPolicy, typename GrowthPolicy>
+typename SimpleVector<T, LockPolicy, GrowthPolicy>::ConstSimpleVectorIterator SimpleVector<T, LockPolicy, GrowthPolicy>::cbegin() const {
+    return begin();
 }
 
 /**
@@ -852,42 +1826,144 @@ const typename SimpleVector<T>::SimpleVectorIterator SimpleVector<T>::cbegin() {
  * 
  * @return A const iterator pointing to one past the last element in the array.
  */
-template <typename T>
-const typename SimpleVector<T>::SimpleVectorIterator SimpleVector<T>::cend() {
-    std::lock_guard<std::mutex> lock(mtx); // Lock for thread-safety
+template <typename T, typename LockPolicy, typename GrowthPolicy>
+typename SimpleVector<T, LockPolicy, GrowthPolicy>::ConstSimpleVectorIterator SimpleVector<T, LockPolicy, GrowthPolicy>::cend() const {
+    return end();
+}
 
-    return SimpleVectorIterator(array + count, array + count);
+template <typename T, typename LockPolicy, typename GrowthPolicy>
+bool SimpleVector<T, LockPolicy, GrowthPolicy>::contains(const T& element) {
+    ReadLock lock(lockPolicy); // Shared lock for thread-safety
+
+    return SimdKernels<T>::find(array, elementCount, element) != elementCount;
 }
 
+template <typename T, typename LockPolicy, typename GrowthPolicy>
+bool SimpleVector<T, LockPolicy, GrowthPolicy>::contains(const T& element) const{
+    ReadLock lock(lockPolicy); // Shared lock for thread-safety
 
-template <typename T>
-bool SimpleVector<T>::contains(const T& element) {
-    std::lock_guard<std::mutex> lock(mtx); // Lock for thread-safety
+    return SimdKernels<T>::find(array, elementCount, element) != elementCount;
+}
 
-    for (unsigned int i = 0; i < count; i++) {
-        if (array[i] == element) {
-            return true;
-        }
+/**
+ * @brief Count the elements equal to the specified element.
+ * 
+ * @details Uses the SIMD kernels from SimpleVectorSimd.h for int, char, float and double.
+ * 
+ * @param element The element to count.
+ * 
+ * @return The number of elements equal to element.
+ */
+template <typename T, typename LockPolicy, typename GrowthPolicy>
+size_t SimpleVector<T, LockPolicy, GrowthPolicy>::count(const T& element) const {
+    ReadLock lock(lockPolicy); // Shared lock for thread-safety
+
+    return SimdKernels<T>::count(array, elementCount, element);
+}
+
+/**
+ * @brief Get the smallest element.
+ * 
+ * @details Requires operator< on T. Uses the SIMD kernels for int, char, float and double;
+ * which element is returned when the vector contains NaN is unspecified.
+ * 
+ * @return A copy of the smallest element.
+ * 
+ * @throw IndexOutOfBoundsException if the vector is empty.
+ */
+template <typename T, typename LockPolicy, typename GrowthPolicy>
+T SimpleVector<T, LockPolicy, GrowthPolicy>::min() const {
+    ReadLock lock(lockPolicy); // Shared lock for thread-safety
+
+    if (elementCount == 0) {
+        throw IndexOutOfBoundsException("Array is empty.");
     }
-    return false;
+    return SimdKernels<T>::min(array, elementCount);
+}
+
+/**
+ * @brief Get the largest element.
+ * 
+ * @details Requires operator< on T. Uses the SIMD kernels for int, char, float and double;
+ * which element is returned when the vector contains NaN is unspecified.
+ * 
+ * @return A copy of the largest element.
+ * 
+ * @throw IndexOutOfBoundsException if the vector is empty.
+ */
+template <typename T, typename LockPolicy, typename GrowthPolicy>
+T SimpleVector<T, LockPolicy, GrowthPolicy>::max() const {
+    ReadLock lock(lockPolicy); // Shared lock for thread-safety
+
+    if (elementCount == 0) {
+        throw IndexOutOfBoundsException("Array is empty.");
+    }
+    return SimdKernels<T>::max(array, elementCount);
+}
+
+/**
+ * @brief Get the sum of all elements.
+ * 
+ * @details Integers are summed in long long and floating point values in double, so large vectors do not overflow.
+ * The SIMD kernels add in a different order than a plain loop, so floating point sums may differ in the last bits.
+ * 
+ * @return The sum of all elements, or a value-initialized sum for an empty vector.
+ */
+template <typename T, typename LockPolicy, typename GrowthPolicy>
+typename SimdKernels<T>::SumType SimpleVector<T, LockPolicy, GrowthPolicy>::sum() const {
+    ReadLock lock(lockPolicy); // Shared lock for thread-safety
+
+    return SimdKernels<T>::sum(array, elementCount);
 }
 
-template <typename T>
-bool SimpleVector<T>::contains(const T& element) const{
-    std::lock_guard<std::mutex> lock(mtx); // Lock for thread-safety
 
-    for (unsigned int i = 0; i < count; i++) {
-        if (array[i] == element) {
-            return true;
-        }
+
+
+
+
+
+/**
+ * @brief Fold the current capacity into the peak capacity. Call before the capacity can drop.
+ */
+template <typename T, typename LockPolicy, typename GrowthPolicy>
+void SimpleVector<T, LockPolicy, GrowthPolicy>::recordPeak() {
+    if (capacity > statistics.peakCapacity) {
+        statistics.peakCapacity = capacity;
     }
-    return false;
 }
 
+/**
+ * @brief Get the allocation counters of this vector.
+ * 
+ * @details The counters cover this instance only; copies and moved-to vectors start their own.
+ * 
+ * @return The number of reallocations, the bytes they moved and the peak capacity.
+ */
+template <typename T, typename LockPolicy, typename GrowthPolicy>
+SimpleVectorStats SimpleVector<T, LockPolicy, GrowthPolicy>::stats() const {
+    ReadLock lock(lockPolicy); // Shared lock for thread-safety
 
+    SimpleVectorStats current = statistics;
+    if (capacity > current.peakCapacity) {
+        current.peakCapacity = capacity;
+    }
+    return current;
+}
 
+/**
+ * @brief Reset the allocation counters. The peak capacity restarts from the current capacity.
+ */
+template <typename T, typename LockPolicy, typename GrowthPolicy>
+void SimpleVector<T, LockPolicy, GrowthPolicy>::resetStats() {
+    WriteLock lock(lockPolicy); // Lock for thread-safety
 
+    statistics = SimpleVectorStats();
+}
 
+// Bit-packed specialization for SimpleVector<bool>.
+#include "SimpleVectorBool.h"
 
+// Fixed-capacity, heap-free variant shared with the Arduino build.
+#include "StaticSimpleVector.h"
 
 #endif // SIMPLEVECTOR_H
\ No newline at end of file
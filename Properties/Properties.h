@@ -649,18 +649,19 @@ public:
     
 
     // The Properties object needs to be compatible with STL-style iteration
+    // Entries are handed out as references into the hash table, iterating copies no strings
     class PropertiesIterator {
     private:
-        HashTable<std::string, std::string>::HashtableIterator iterator;    
+        HashTable<std::string, std::string>::ConstHashtableIterator iterator;    
 
     public:
-        PropertiesIterator(HashTable<std::string, std::string>::HashtableIterator it)
+        PropertiesIterator(HashTable<std::string, std::string>::ConstHashtableIterator it)
         : iterator(std::move(it)) {}
 
 
-        std::pair<std::string, std::string> operator*() {
+        std::pair<const std::string&, const std::string&> operator*() const {
             auto kv = *iterator;
-            return std::make_pair(kv.key, kv.value);
+            return std::pair<const std::string&, const std::string&>(kv.key, kv.value);
         }   
 
         PropertiesIterator& operator++() {
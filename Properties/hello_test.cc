@@ -124,6 +124,16 @@ TEST_F(PropertiesTest, StoreAndLoadJSON) {
     EXPECT_EQ(newProps.getProperty("key3"), "value3");
 }
 
+TEST_F(PropertiesTest, StoreYAMLWritesEveryEntry) {
+    std::stringstream ss;
+    EXPECT_TRUE(props.store(ss, Properties::FileTypes::YAML));
+
+    std::string output = ss.str();
+    EXPECT_NE(output.find("key1: value1"), std::string::npos);
+    EXPECT_NE(output.find("key2: value2"), std::string::npos);
+    EXPECT_NE(output.find("key3: value3"), std::string::npos);
+}
+
 int main(int argc, char **argv) {
     ::testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();
@@ -0,0 +1,491 @@
+#ifndef CONCURRENTSIMPLEVECTOR_H
+#define CONCURRENTSIMPLEVECTOR_H
+
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <iostream>
+#include <iterator>
+#include <new>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+//#define DEBUG
+
+//==============================================================================|
+
+#ifndef INDEXOUTOFBOUNDSEXCEPTION
+#define INDEXOUTOFBOUNDSEXCEPTION
+class IndexOutOfBoundsException : public std::exception {
+public:
+    explicit IndexOutOfBoundsException(const std::string& message) : msg_(message) {}
+    virtual const char* what() const noexcept {
+        return msg_.c_str();
+    }
+private:
+    std::string msg_;
+};
+#endif
+
+//==============================================================================|
+
+/**
+ * @brief Append-only vector that many threads can push to and read from without locks.
+ *
+ * @details Elements live in segments whose sizes double: 32, 64, 128, ... Segments are allocated on demand and
+ * never move, so a reference to an element stays valid for the lifetime of the vector, even while other threads append.
+ *
+ * push_back claims a slot with a single fetch_add. The first thread to reach an unallocated segment installs it
+ * with a compare-and-swap. After constructing its element, a writer marks the slot ready. It then advances the
+ * published count over every ready slot that directly follows it. A writer never waits for another writer: if an earlier
+ * slot is still being filled, its writer publishes both when it finishes. Readers only see the published prefix,
+ * and reads never lock and never wait.
+ *
+ * Elements cannot be removed. T must be nothrow move constructible, because the element is built before a slot is
+ * claimed and then moved into place. This guarantees that every claimed slot is eventually filled.
+ *
+ * @tparam T The type of the elements.
+ */
+template <typename T>
+class ConcurrentSimpleVector {
+    static_assert(std::is_nothrow_move_constructible<T>::value, "ConcurrentSimpleVector requires a nothrow move constructor");
+
+private:
+    static const unsigned int FIRST_SEGMENT_BITS = 5; // The first segment holds 1 << FIRST_SEGMENT_BITS elements
+    static const unsigned int MAX_SEGMENTS = sizeof(size_t) * 8 - FIRST_SEGMENT_BITS; // Enough segments to address every size_t index
+
+    std::atomic<T*> segments[MAX_SEGMENTS]; // Segment k holds 1 << (k + FIRST_SEGMENT_BITS) elements, followed by one ready flag per element
+    std::atomic<size_t> claimed; // Number of slots handed out to writers
+    std::atomic<size_t> published; // Number of slots that are constructed and visible to readers
+
+    static unsigned int highestBit(size_t value); // Index of the highest set bit of a non-zero value
+    static unsigned int segmentOf(size_t index); // Segment that holds the given index
+    static size_t segmentStart(unsigned int segment); // Index of the first element of the given segment
+    static size_t segmentCapacity(unsigned int segment); // Number of elements in the given segment
+    static T* allocateSegment(unsigned int segment); // Allocate raw element storage and cleared ready flags for a segment
+    static void deallocateSegment(T* storage); // Release storage obtained from allocateSegment()
+    static std::atomic<bool>* readyFlags(T* storage, unsigned int segment); // Ready flags stored behind the elements of a segment
+    T* segmentFor(unsigned int segment) noexcept; // Get a segment, allocating it if no other writer has yet
+    T& slotAt(size_t index) const; // Get the element at index without checking that it is published
+    void advancePublished() noexcept; // Move the published count over every ready slot
+    T& store(T&& item) noexcept; // Claim a slot, move item into it and publish it
+
+public:
+    class ConcurrentSimpleVectorIterator; // Forward declaration of the iterator class
+
+    ConcurrentSimpleVector(); // Default constructor
+    ~ConcurrentSimpleVector(); // Destructor
+
+    ConcurrentSimpleVector(const ConcurrentSimpleVector&) = delete;
+    ConcurrentSimpleVector& operator=(const ConcurrentSimpleVector&) = delete;
+
+    void push_back(const T& item); // Add an element to the vector
+    void push_back(T&& item); // Add an element to the vector by moving it
+    template<typename... Args>
+    T& emplace_back(Args&&... args); // Construct an element and add it to the vector
+
+    T& operator[](size_t index); // Get the element at the specified index
+    const T& operator[](size_t index) const; // Get the element at the specified index
+    T& back(); // Get the last published element
+    size_t elements() const; // Get the number of published elements
+    bool isEmpty() const; // Check if the vector has no published elements
+
+    ConcurrentSimpleVectorIterator begin(); // Get an iterator pointing to the first element
+    ConcurrentSimpleVectorIterator end(); // Get an iterator pointing one past the last element published when end() was called
+
+    typedef ConcurrentSimpleVectorIterator iterator; // Define the iterator type
+};
+
+//==============================================================================|
+
+/**
+ * @brief Constructs an empty ConcurrentSimpleVector object.
+ *
+ * @details No memory is allocated until the first element is added.
+ */
+template <typename T>
+ConcurrentSimpleVector<T>::ConcurrentSimpleVector() : claimed(0), published(0) {
+    for (unsigned int i = 0; i < MAX_SEGMENTS; i++) {
+        segments[i].store(nullptr, std::memory_order_relaxed);
+    }
+}
+
+/**
+ * @brief Destroys the ConcurrentSimpleVector object.
+ *
+ * @details No other thread may use the vector while it is destroyed.
+ */
+template <typename T>
+ConcurrentSimpleVector<T>::~ConcurrentSimpleVector() {
+    size_t total = published.load(std::memory_order_acquire);
+    for (unsigned int segment = 0; segment < MAX_SEGMENTS; segment++) {
+        T* storage = segments[segment].load(std::memory_order_relaxed);
+        if (storage == nullptr) {
+            continue;
+        }
+        size_t start = segmentStart(segment);
+        if (!std::is_trivially_destructible<T>::value) {
+            for (size_t i = start; i < total && i < start + segmentCapacity(segment); i++) {
+                storage[i - start].~T();
+            }
+        }
+        deallocateSegment(storage);
+    }
+}
+
+/**
+ * @brief Get the index of the highest set bit of a non-zero value.
+ */
+template <typename T>
+unsigned int ConcurrentSimpleVector<T>::highestBit(size_t value) {
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<unsigned int>(sizeof(unsigned long long) * 8 - 1 - __builtin_clzll(static_cast<unsigned long long>(value)));
+#else
+    unsigned int bit = 0;
+    while (value >>= 1) {
+        bit++;
+    }
+    return bit;
+#endif
+}
+
+/**
+ * @brief Get the segment that holds the given index.
+ *
+ * @details Shifting the index by the size of the first segment turns the segment boundaries into powers of two.
+ */
+template <typename T>
+unsigned int ConcurrentSimpleVector<T>::segmentOf(size_t index) {
+    return highestBit(index + (static_cast<size_t>(1) << FIRST_SEGMENT_BITS)) - FIRST_SEGMENT_BITS;
+}
+
+/**
+ * @brief Get the index of the first element of the given segment.
+ */
+template <typename T>
+size_t ConcurrentSimpleVector<T>::segmentStart(unsigned int segment) {
+    return (static_cast<size_t>(1) << (segment + FIRST_SEGMENT_BITS)) - (static_cast<size_t>(1) << FIRST_SEGMENT_BITS);
+}
+
+/**
+ * @brief Get the number of elements in the given segment.
+ */
+template <typename T>
+size_t ConcurrentSimpleVector<T>::segmentCapacity(unsigned int segment) {
+    return static_cast<size_t>(1) << (segment + FIRST_SEGMENT_BITS);
+}
+
+/**
+ * @brief Allocate storage for a segment.
+ *
+ * @details The elements are left unconstructed. The ready flags behind them are all cleared before
+ * the segment is installed, so other threads never see uninitialized flags.
+ *
+ * @param segment The segment to allocate.
+ *
+ * @return Pointer to the element storage.
+ */
+template <typename T>
+T* ConcurrentSimpleVector<T>::allocateSegment(unsigned int segment) {
+    size_t slots = segmentCapacity(segment);
+    size_t bytes = slots * sizeof(T) + slots * sizeof(std::atomic<bool>);
+    T* storage;
+    if (alignof(T) > __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+        storage = static_cast<T*>(::operator new(bytes, std::align_val_t(alignof(T))));
+    } else {
+        storage = static_cast<T*>(::operator new(bytes));
+    }
+    std::atomic<bool>* flags = readyFlags(storage, segment);
+    for (size_t i = 0; i < slots; i++) {
+        new (flags + i) std::atomic<bool>(false);
+    }
+    return storage;
+}
+
+/**
+ * @brief Get the ready flags stored behind the elements of a segment.
+ */
+template <typename T>
+std::atomic<bool>* ConcurrentSimpleVector<T>::readyFlags(T* storage, unsigned int segment) {
+    return reinterpret_cast<std::atomic<bool>*>(storage + segmentCapacity(segment));
+}
+
+/**
+ * @brief Release storage obtained from allocateSegment().
+ */
+template <typename T>
+void ConcurrentSimpleVector<T>::deallocateSegment(T* storage) {
+    if (alignof(T) > __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+        ::operator delete(storage, std::align_val_t(alignof(T)));
+    } else {
+        ::operator delete(storage);
+    }
+}
+
+/**
+ * @brief Get a segment, allocating it if it does not exist yet.
+ *
+ * @details Several writers may race to allocate the same segment. Each allocates its own storage and tries to
+ * install it with a compare-and-swap; the losers free theirs and use the winner's. Existing segments are never touched.
+ * The function is noexcept because it runs after a slot has been claimed: if the segment cannot be allocated,
+ * the slot can never be filled and the program terminates instead of stalling every later writer.
+ *
+ * @param segment The segment to get.
+ *
+ * @return Pointer to the segment storage.
+ */
+template <typename T>
+T* ConcurrentSimpleVector<T>::segmentFor(unsigned int segment) noexcept {
+    T* storage = segments[segment].load(std::memory_order_acquire);
+    if (storage != nullptr) {
+        return storage;
+    }
+    T* fresh = allocateSegment(segment);
+    if (segments[segment].compare_exchange_strong(storage, fresh, std::memory_order_acq_rel, std::memory_order_acquire)) {
+        #ifdef DEBUG
+        std::cout << "Allocated segment " << segment << std::endl;
+        #endif
+        return fresh;
+    }
+    deallocateSegment(fresh);
+    return storage;
+}
+
+/**
+ * @brief Get the element at the specified index without checking that it has been published.
+ */
+template <typename T>
+T& ConcurrentSimpleVector<T>::slotAt(size_t index) const {
+    unsigned int segment = segmentOf(index);
+    return segments[segment].load(std::memory_order_acquire)[index - segmentStart(segment)];
+}
+
+/**
+ * @brief Move the published count over every ready slot that follows it.
+ *
+ * @details Any writer may advance the count on behalf of others. The ready flags and the count use sequentially
+ * consistent operations: a writer that marks its slot ready just after another writer stopped at that slot will
+ * then see the advanced count and carry on from there, so no ready slot is left unpublished.
+ */
+template <typename T>
+void ConcurrentSimpleVector<T>::advancePublished() noexcept {
+    size_t current = published.load();
+    while (true) {
+        unsigned int segment = segmentOf(current);
+        if (segment >= MAX_SEGMENTS) {
+            return;
+        }
+        T* storage = segments[segment].load(std::memory_order_acquire);
+        if (storage == nullptr || !readyFlags(storage, segment)[current - segmentStart(segment)].load()) {
+            return;
+        }
+        // On failure current is reloaded, and the loop continues from wherever another writer got to.
+        if (published.compare_exchange_weak(current, current + 1)) {
+            current++;
+        }
+    }
+}
+
+/**
+ * @brief Claim a slot, move the item into it and publish it.
+ *
+ * @details The slot is claimed with fetch_add, so writers never wait for each other. The element becomes visible to
+ * readers once every earlier slot is filled as well, which keeps the published elements a gap-free prefix.
+ *
+ * @param item The item to move into the vector.
+ *
+ * @return Reference to the stored element.
+ */
+template <typename T>
+T& ConcurrentSimpleVector<T>::store(T&& item) noexcept {
+    size_t index = claimed.fetch_add(1, std::memory_order_relaxed);
+    unsigned int segment = segmentOf(index);
+    T* storage = segmentFor(segment);
+    size_t offset = index - segmentStart(segment);
+    T* slot = new (storage + offset) T(std::move(item));
+
+    // Fast path: every earlier slot is already published, so publish this one directly without touching its flag.
+    size_t expected = index;
+    if (!published.compare_exchange_strong(expected, index + 1)) {
+        readyFlags(storage, segment)[offset].store(true);
+    }
+    advancePublished();
+    return *slot;
+}
+
+/**
+ * @brief Add an element to the vector.
+ *
+ * @param item The item to be added to the vector.
+ */
+template <typename T>
+void ConcurrentSimpleVector<T>::push_back(const T& item) {
+    T copy(item); // Copy before claiming a slot, so a throwing copy constructor cannot leave a hole
+    store(std::move(copy));
+}
+
+/**
+ * @brief Add an element to the vector by moving it.
+ *
+ * @param item The item to be moved into the vector.
+ */
+template <typename T>
+void ConcurrentSimpleVector<T>::push_back(T&& item) {
+    store(std::move(item));
+}
+
+/**
+ * @brief Construct an element and add it to the vector.
+ *
+ * @details The element is constructed first and then moved into its slot. The returned reference stays valid
+ * for the lifetime of the vector.
+ *
+ * @param args The arguments forwarded to the constructor of T.
+ *
+ * @return Reference to the new element.
+ */
+template <typename T>
+template<typename... Args>
+T& ConcurrentSimpleVector<T>::emplace_back(Args&&... args) {
+    T item(std::forward<Args>(args)...);
+    return store(std::move(item));
+}
+
+/**
+ * @brief Get the element at the specified index.
+ *
+ * @param index The index of the element to be accessed.
+ *
+ * @return The element at the specified index.
+ *
+ * @throw IndexOutOfBoundsException if the element has not been published.
+ */
+template <typename T>
+T& ConcurrentSimpleVector<T>::operator[](size_t index) {
+    if (index >= published.load(std::memory_order_acquire)) {
+        throw IndexOutOfBoundsException("Error: Index out of bounds.");
+    }
+    return slotAt(index);
+}
+
+/**
+ * @brief Get the element at the specified index.
+ *
+ * @param index The index of the element to be accessed.
+ *
+ * @return The element at the specified index.
+ *
+ * @throw IndexOutOfBoundsException if the element has not been published.
+ */
+template <typename T>
+const T& ConcurrentSimpleVector<T>::operator[](size_t index) const {
+    if (index >= published.load(std::memory_order_acquire)) {
+        throw IndexOutOfBoundsException("Error: Index out of bounds.");
+    }
+    return slotAt(index);
+}
+
+/**
+ * @brief Get the last published element.
+ *
+ * @return The last published element.
+ *
+ * @throw IndexOutOfBoundsException if the vector is empty.
+ */
+template <typename T>
+T& ConcurrentSimpleVector<T>::back() {
+    size_t total = published.load(std::memory_order_acquire);
+    if (total == 0) {
+        throw IndexOutOfBoundsException("Array is empty.");
+    }
+    return slotAt(total - 1);
+}
+
+/**
+ * @brief Get the number of published elements.
+ *
+ * @details Elements that are still being added by other threads are not counted.
+ *
+ * @return The number of elements readers can access.
+ */
+template <typename T>
+size_t ConcurrentSimpleVector<T>::elements() const {
+    return published.load(std::memory_order_acquire);
+}
+
+/**
+ * @brief Check if the vector has no published elements.
+ *
+ * @return True if the vector is empty, false otherwise.
+ */
+template <typename T>
+bool ConcurrentSimpleVector<T>::isEmpty() const {
+    return published.load(std::memory_order_acquire) == 0;
+}
+
+/**
+ * @brief Forward iterator over the published elements of a ConcurrentSimpleVector.
+ *
+ * @details Elements added after end() was called are not visited. Appends from other threads never invalidate the iterator.
+ */
+template <typename T>
+class ConcurrentSimpleVector<T>::ConcurrentSimpleVectorIterator {
+private:
+    const ConcurrentSimpleVector* vector;
+    size_t index;
+
+public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = T;
+    using difference_type = std::ptrdiff_t;
+    using pointer = T*;
+    using reference = T&;
+
+    ConcurrentSimpleVectorIterator(const ConcurrentSimpleVector* vec, size_t position) : vector(vec), index(position) {}
+
+    T& operator*() const {
+        return vector->slotAt(index);
+    }
+
+    T* operator->() const {
+        return &vector->slotAt(index);
+    }
+
+    ConcurrentSimpleVectorIterator& operator++() {
+        ++index;
+        return *this;
+    }
+
+    ConcurrentSimpleVectorIterator operator++(int) {
+        ConcurrentSimpleVectorIterator previous = *this;
+        ++index;
+        return previous;
+    }
+
+    bool operator==(const ConcurrentSimpleVectorIterator& other) const {
+        return index == other.index;
+    }
+
+    bool operator!=(const ConcurrentSimpleVectorIterator& other) const {
+        return index != other.index;
+    }
+};
+
+/**
+ * @brief Get an iterator pointing to the first element.
+ */
+template <typename T>
+typename ConcurrentSimpleVector<T>::ConcurrentSimpleVectorIterator ConcurrentSimpleVector<T>::begin() {
+    return ConcurrentSimpleVectorIterator(this, 0);
+}
+
+/**
+ * @brief Get an iterator pointing one past the last element published when end() was called.
+ */
+template <typename T>
+typename ConcurrentSimpleVector<T>::ConcurrentSimpleVectorIterator ConcurrentSimpleVector<T>::end() {
+    return ConcurrentSimpleVectorIterator(this, published.load(std::memory_order_acquire));
+}
+
+#endif // CONCURRENTSIMPLEVECTOR_H
@@ -2,10 +2,21 @@
 #define HASHTABLE_H
 
 #include <exception>
+#include <iterator>
 #include <iostream>
 #include <string>
 #include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
 #include "SimpleVector.h"
+#include "SmallSimpleVector.h"
 #include <sstream>
 
 
@@ -47,19 +58,26 @@ struct KeyHash<bool> {
     }
 };
 
+// Floating point keys hash their bit pattern. 0.0 and -0.0 compare equal, so both hash like 0.0.
 template <>
 struct KeyHash<float> {
     unsigned long operator()(const float& key) const {
-        unsigned long hash = *reinterpret_cast<const unsigned long*>(&key);
-        return hash;
+        uint32_t bits = 0;
+        if (key != 0.0f) {
+            std::memcpy(&bits, &key, sizeof(bits));
+        }
+        return static_cast<unsigned long>(bits);
     }
 };
 
 template <>
 struct KeyHash<double> {
     unsigned long operator()(const double& key) const {
-        unsigned long hash = *reinterpret_cast<const unsigned long*>(&key);
-        return hash;
+        uint64_t bits = 0;
+        if (key != 0.0) {
+            std::memcpy(&bits, &key, sizeof(bits));
+        }
+        return static_cast<unsigned long>(bits ^ (bits >> 32));
     }
 };
 
@@ -126,9 +144,875 @@ struct KeyHash<short> {
     }
 };
 
-template <typename K, typename V, typename Hash = KeyHash<K>>
+//===============================================================
+
+/**
+ * @brief Building blocks of FastHash, after wyhash: 64-bit reads folded together with a 64x64->128 bit multiply.
+ */
+namespace HashMixing {
+    static const uint64_t SECRET[4] = {0xa0761d6478bd642fULL, 0xe7037ed1a0b428dbULL, 0x8ebc6af09c88c6e3ULL, 0x589965cc75374cc3ULL};
+
+    // Multiply a and b to 128 bits, leaving the low half in a and the high half in b
+    inline void multiply(uint64_t& a, uint64_t& b) {
+    #if defined(__SIZEOF_INT128__)
+        __uint128_t product = static_cast<__uint128_t>(a) * b;
+        a = static_cast<uint64_t>(product);
+        b = static_cast<uint64_t>(product >> 64);
+    #else
+        uint64_t aHigh = a >> 32, aLow = static_cast<uint32_t>(a);
+        uint64_t bHigh = b >> 32, bLow = static_cast<uint32_t>(b);
+        uint64_t lowLow = aLow * bLow, highLow = aHigh * bLow, lowHigh = aLow * bHigh, highHigh = aHigh * bHigh;
+        uint64_t cross = (lowLow >> 32) + static_cast<uint32_t>(highLow) + lowHigh;
+        b = highHigh + (highLow >> 32) + (cross >> 32);
+        a = (cross << 32) | static_cast<uint32_t>(lowLow);
+    #endif
+    }
+
+    // Multiply a and b to 128 bits and fold the high half into the low half
+    inline uint64_t mix(uint64_t a, uint64_t b) {
+        multiply(a, b);
+        return a ^ b;
+    }
+
+    inline uint64_t read64(const unsigned char* p) {
+        uint64_t value;
+        std::memcpy(&value, p, sizeof(value));
+        return value;
+    }
+
+    inline uint64_t read32(const unsigned char* p) {
+        uint32_t value;
+        std::memcpy(&value, p, sizeof(value));
+        return value;
+    }
+
+    /**
+     * @brief Hash a byte range, reading 8 to 48 bytes per step.
+     *
+     * @details Keys of up to 16 bytes are covered by at most four overlapping reads and no loop. Longer keys are
+     * consumed 48 bytes at a time in three independent lanes, then 16 bytes at a time.
+     */
+    inline uint64_t hashBytes(const void* data, size_t length, uint64_t seed = 0) {
+        const unsigned char* p = static_cast<const unsigned char*>(data);
+        seed ^= mix(seed ^ SECRET[0], SECRET[1]);
+        uint64_t a, b;
+        if (length <= 16) {
+            if (length >= 4) {
+                size_t middle = (length >> 3) << 2;
+                a = (read32(p) << 32) | read32(p + middle);
+                b = (read32(p + length - 4) << 32) | read32(p + length - 4 - middle);
+            } else if (length > 0) {
+                a = (static_cast<uint64_t>(p[0]) << 16) | (static_cast<uint64_t>(p[length >> 1]) << 8) | p[length - 1];
+                b = 0;
+            } else {
+                a = b = 0;
+            }
+        } else {
+            size_t remaining = length;
+            if (remaining > 48) {
+                uint64_t lane1 = seed, lane2 = seed;
+                do {
+                    seed = mix(read64(p) ^ SECRET[1], read64(p + 8) ^ seed);
+                    lane1 = mix(read64(p + 16) ^ SECRET[2], read64(p + 24) ^ lane1);
+                    lane2 = mix(read64(p + 32) ^ SECRET[3], read64(p + 40) ^ lane2);
+                    p += 48;
+                    remaining -= 48;
+                } while (remaining > 48);
+                seed ^= lane1 ^ lane2;
+            }
+            while (remaining > 16) {
+                seed = mix(read64(p) ^ SECRET[1], read64(p + 8) ^ seed);
+                p += 16;
+                remaining -= 16;
+            }
+            a = read64(p + remaining - 16);
+            b = read64(p + remaining - 8);
+        }
+        a ^= SECRET[1];
+        b ^= seed;
+        multiply(a, b);
+        return mix(a ^ SECRET[0] ^ length, b ^ SECRET[1]);
+    }
+
+    // Spread every input bit over the whole result, so the low bits alone are a usable bucket index
+    inline uint64_t hashInteger(uint64_t key) {
+        return mix(key ^ SECRET[0], SECRET[1]);
+    }
+
+    /**
+     * @brief One multiply and shift applied by HashTable to every hash before masking off a bucket index.
+     *
+     * @details Bucket counts are powers of two, so only the low bits of a hash pick the bucket. The identity hashes in
+     * KeyHash would put keys that differ only in their high bits, such as multiples of 4096, into a single bucket.
+     */
+    inline size_t spread(uint64_t hash) {
+        hash *= 0x9e3779b97f4a7c15ULL;
+        return static_cast<size_t>(hash ^ (hash >> 32));
+    }
+}
+
+/**
+ * @brief Faster and better distributed alternative to KeyHash, selected through the Hash parameter of HashTable.
+ *
+ * @details Strings are hashed eight bytes at a time in the style of wyhash instead of one byte at a time, integers
+ * go through a multiplicative mixer instead of the identity so sequential or strided keys do not share buckets, and
+ * floating point keys hash their bit pattern with 0.0 and -0.0 hashing alike. The full 64-bit result is returned, also
+ * where unsigned long is 32 bits wide.
+ *
+ * @code
+ * HashTable<std::string, int, FastHash<std::string>> table;
+ * @endcode
+ */
+template <typename K, typename Enable = void>
+struct FastHash;
+
+template <>
+struct FastHash<std::string> {
+    uint64_t operator()(const std::string& key) const {
+        return HashMixing::hashBytes(key.data(), key.size());
+    }
+};
+
+template <typename K>
+struct FastHash<K, typename std::enable_if<std::is_integral<K>::value>::type> {
+    uint64_t operator()(const K& key) const {
+        return HashMixing::hashInteger(static_cast<uint64_t>(key));
+    }
+};
+
+template <typename K>
+struct FastHash<K, typename std::enable_if<std::is_same<K, float>::value || std::is_same<K, double>::value>::type> {
+    uint64_t operator()(const K& key) const {
+        if (key == K(0)) {
+            return HashMixing::hashInteger(0);
+        }
+        return HashMixing::hashBytes(&key, sizeof(K));
+    }
+};
+
+//===============================================================
+    #ifndef KEYNOTFOUNDEXCEPTION
+    #define KEYNOTFOUNDEXCEPTION
+        class KeyNotFoundException : public std::exception {
+        public:
+            explicit KeyNotFoundException(const std::string& message) : msg_(message) {}
+            virtual const char* what() const noexcept {
+                return msg_.c_str();
+            }
+        private:
+            std::string msg_;
+        };
+    #endif // KEYNOTFOUNDEXCEPTION
+
+    #ifndef HASHTABLEEXCEPTION
+    #define HASHTABLEEXCEPTION
+        class HashtableException : public std::exception {
+        public:
+            explicit HashtableException(const std::string& message) : msg_(message) {}
+            virtual const char* what() const noexcept {
+                return msg_.c_str();
+            }
+        private:
+            std::string msg_;
+        };
+    #endif // HASHTABLEEXCEPTION
+
+    #ifndef INDEXOUTOFBOUNDSEXCEPTION
+    #define INDEXOUTOFBOUNDSEXCEPTION
+        class IndexOutOfBoundsException : public std::exception {
+        public:
+            explicit IndexOutOfBoundsException(const std::string& message) : msg_(message) {}
+            virtual const char* what() const noexcept {
+                return msg_.c_str();
+            }
+        private:
+            std::string msg_;
+        };
+
+    #endif // INDEXOUTOFBOUNDSEXCEPTION
+
+//===============================================================
+
+/**
+ * @brief Node allocation policy that allocates every chained entry with new and frees it with delete.
+ */
+struct HeapNodeAllocator {
+    template <typename Node>
+    class Pool {
+    public:
+        static const bool RELEASES_ALL_NODES = false; // release() does not free nodes, each one must be destroyed
+
+        template <typename... Args>
+        Node* create(Args&&... args) { return new Node(std::forward<Args>(args)...); }
+        void destroy(Node* node) { delete node; }
+        void release() {}
+        void swap(Pool&) noexcept {}
+    };
+};
+
+/**
+ * @brief Node allocation policy that carves chained entries out of slabs of NodesPerSlab nodes owned by the table.
+ *
+ * @details A destroyed node goes onto a free list and is handed out again by the next insert, so a table under
+ * insert/remove churn stops calling the general-purpose allocator once it has enough slabs. Slabs are only returned
+ * when the table is cleared or destroyed, which frees all of them in O(slabs). A copied table starts with its own
+ * empty pool.
+ *
+ * @tparam NodesPerSlab The number of nodes allocated at once.
+ */
+template <size_t NodesPerSlab = 256>
+struct PooledNodeAllocator {
+    template <typename Node>
+    class Pool {
+    private:
+        union Slot {
+            Slot* nextFree;
+            alignas(Node) unsigned char storage[sizeof(Node)];
+        };
+
+        struct Slab {
+            Slab* next;
+            Slot slots[NodesPerSlab];
+        };
+
+        Slab* slabs; // Newest slab first
+        Slot* freeList; // Slots of destroyed nodes, reused before the newest slab is consumed further
+        size_t used; // Slots of the newest slab handed out so far
+
+    public:
+        static const bool RELEASES_ALL_NODES = true; // release() frees every node at once
+
+        Pool() : slabs(nullptr), freeList(nullptr), used(NodesPerSlab) {}
+        Pool(const Pool&) : Pool() {}
+        Pool& operator=(const Pool&) = delete;
+        ~Pool() { release(); }
+
+        template <typename... Args>
+        Node* create(Args&&... args) {
+            Slot* slot = freeList;
+            if (slot != nullptr) {
+                freeList = slot->nextFree;
+            } else {
+                if (used == NodesPerSlab) {
+                    Slab* slab = new Slab;
+                    slab->next = slabs;
+                    slabs = slab;
+                    used = 0;
+                }
+                slot = &slabs->slots[used++];
+            }
+            try {
+                return ::new (static_cast<void*>(slot->storage)) Node(std::forward<Args>(args)...);
+            } catch (...) {
+                slot->nextFree = freeList;
+                freeList = slot;
+                throw;
+            }
+        }
+
+        void destroy(Node* node) {
+            node->~Node();
+            Slot* slot = reinterpret_cast<Slot*>(node);
+            slot->nextFree = freeList;
+            freeList = slot;
+        }
+
+        // Frees every slab, nodes still in them must not have destructors left to run
+        void release() {
+            while (slabs != nullptr) {
+                Slab* next = slabs->next;
+                delete slabs;
+                slabs = next;
+            }
+            freeList = nullptr;
+            used = NodesPerSlab;
+        }
+
+        void swap(Pool& other) noexcept {
+            std::swap(slabs, other.slabs);
+            std::swap(freeList, other.freeList);
+            std::swap(used, other.used);
+        }
+    };
+};
+
+/**
+ * @brief Storage policy that keeps every entry in its own node, chained per bucket.
+ *
+ * @details This is the layout HashTable has always used and stays the default. Entries never move once inserted, so
+ * a reference to a value stays valid until its key is removed, but every insert allocates a node and every probe
+ * follows a pointer to wherever that node landed. The NodeAllocator policy decides where nodes come from.
+ *
+ * By default a resize moves every entry into the doubled bucket array at once, so the insert that crosses the load
+ * factor pays for the whole table. With a RehashStep above zero the table rehashes incrementally, like the Redis
+ * dict: the old and the new bucket array coexist, lookups check both, and every insert or remove moves at most
+ * RehashStep chains from the old array to the new one until the old array is empty.
+ *
+ * @tparam NodeAllocator HeapNodeAllocator (default) or PooledNodeAllocator.
+ * @tparam RehashStep The number of chains moved per insert or remove while rehashing, 0 to rehash all at once.
+ */
+template <typename NodeAllocator = HeapNodeAllocator, size_t RehashStep = 0>
+struct BasicChainedStorage {
+    template <typename K, typename V, typename Hash>
+    class Table {
+    public:
+        struct Entry {
+            K key;
+            V value;
+            Entry* next;
+            size_t hash; // Spread hash of the key, kept so resizing never calls the hash function again
+            Entry(K k, V v, size_t h) : key(k), value(v), next(nullptr), hash(h) {}
+        };
+
+        /**
+         * @brief Position of an entry. Buckets of the old array come first while rehashing, the end position has no
+         * entry.
+         */
+        struct Cursor {
+            size_t bucket;
+            Entry* entry;
+            bool operator==(const Cursor& other) const { return bucket == other.bucket && entry == other.entry; }
+        };
+
+        Table()
+            : buckets(allocateBuckets(INITIAL_TABLE_SIZE)), bucketCount(INITIAL_TABLE_SIZE),
+              oldBuckets(nullptr), oldBucketCount(0), rehashIndex(0), count(0), hashFunction() {}
+
+        // The copy gets the final bucket array only, entries still waiting in the old array are copied straight into it
+        Table(const Table& other)
+            : buckets(other.buckets != nullptr ? allocateBuckets(other.bucketCount) : nullptr), bucketCount(other.bucketCount),
+              oldBuckets(nullptr), oldBucketCount(0), rehashIndex(0), count(0), hashFunction(other.hashFunction) {
+            try {
+                for (size_t i = 0; i < other.oldBucketCount + other.bucketCount; ++i) {
+                    for (Entry* entry = other.headAt(i); entry != nullptr; entry = entry->next) {
+                        Entry*& head = buckets[entry->hash & (bucketCount - 1)];
+                        Entry* copy = pool.create(entry->key, entry->value, entry->hash);
+                        copy->next = head;
+                        head = copy;
+                        count++;
+                    }
+                }
+            } catch (...) {
+                clear();
+                std::free(buckets);
+                throw;
+            }
+        }
+
+        // The moved-from table has no bucket array and allocates one on its next insert, so moving never allocates
+        Table(Table&& other) noexcept
+            : buckets(nullptr), bucketCount(0), oldBuckets(nullptr), oldBucketCount(0), rehashIndex(0), count(0),
+              hashFunction() {
+            swap(other);
+        }
+
+        Table& operator=(Table other) noexcept {
+            swap(other);
+            return *this;
+        }
+
+        ~Table() {
+            clear();
+            std::free(buckets);
+        }
+
+        V* find(const K& key) const {
+            Entry* entry = findEntry(key, hashOf(key));
+            return entry ? &entry->value : nullptr;
+        }
+
+        // Returns true when a new entry was added, false when an existing value was overwritten
+        bool insertOrAssign(const K& key, const V& value) {
+            if (oldBuckets != nullptr) {
+                rehashStep(RehashStep);
+            }
+            size_t hash = hashOf(key);
+            if (Entry* existing = findEntry(key, hash)) {
+                existing->value = value;
+                return false;
+            }
+            if (count >= bucketCount * loadFactorThreshold) {
+                resize();
+            }
+            Entry*& head = buckets[hash & (bucketCount - 1)];
+            Entry* newEntry = pool.create(key, value, hash);
+            newEntry->next = head;
+            head = newEntry;
+            count++;
+            return true;
+        }
+
+        bool erase(const K& key) {
+            if (count == 0) {
+                return false;
+            }
+            if (oldBuckets != nullptr) {
+                rehashStep(RehashStep);
+            }
+            size_t hash = hashOf(key);
+            if (unlink(buckets[hash & (bucketCount - 1)], key, hash)) {
+                return true;
+            }
+            return oldBuckets != nullptr && unlink(oldBuckets[hash & (oldBucketCount - 1)], key, hash);
+        }
+
+        void clear() {
+            // A pool that frees all nodes at once only needs the walk to run destructors
+            bool destroyEach = !NodePool::RELEASES_ALL_NODES || !std::is_trivially_destructible<Entry>::value;
+            for (size_t i = 0; i < oldBucketCount + bucketCount; ++i) {
+                Entry*& head = i < oldBucketCount ? oldBuckets[i] : buckets[i - oldBucketCount];
+                Entry* current = head;
+                while (destroyEach && current != nullptr) {
+                    Entry* next = current->next;
+                    pool.destroy(current);
+                    current = next;
+                }
+                head = nullptr;
+            }
+            std::free(oldBuckets);
+            oldBuckets = nullptr;
+            oldBucketCount = 0;
+            rehashIndex = 0;
+            pool.release();
+            count = 0;
+        }
+
+        size_t size() const { return count; }
+        size_t capacity() const { return bucketCount; }
+        bool isRehashing() const { return oldBuckets != nullptr; }
+
+        Cursor first() const {
+            if (count == 0) {
+                return last();
+            }
+            Cursor cursor{0, headAt(0)};
+            if (cursor.entry == nullptr) {
+                advance(cursor);
+            }
+            return cursor;
+        }
+
+        Cursor last() const { return Cursor{oldBucketCount + bucketCount, nullptr}; }
+
+        void advance(Cursor& cursor) const {
+            if (cursor.entry && cursor.entry->next) {
+                cursor.entry = cursor.entry->next;
+                return;
+            }
+            do {
+                if (++cursor.bucket >= oldBucketCount + bucketCount) {
+                    cursor = last();
+                    return;
+                }
+                cursor.entry = headAt(cursor.bucket);
+            } while (!cursor.entry);
+        }
+
+        Cursor locate(const K& key) const {
+            if (count == 0) {
+                return last();
+            }
+            size_t hash = hashOf(key);
+            for (size_t i = oldBucketCount + (hash & (bucketCount - 1)); ; i = hash & (oldBucketCount - 1)) {
+                for (Entry* entry = headAt(i); entry != nullptr; entry = entry->next) {
+                    if (entry->hash == hash && entry->key == key) {
+                        return Cursor{i, entry};
+                    }
+                }
+                if (i < oldBucketCount || oldBuckets == nullptr) {
+                    return last();
+                }
+            }
+        }
+
+        bool atEnd(const Cursor& cursor) const { return cursor.entry == nullptr; }
+        const K& keyAt(const Cursor& cursor) const { return cursor.entry->key; }
+        V& valueAt(const Cursor& cursor) const { return cursor.entry->value; }
+
+    private:
+        static const size_t INITIAL_TABLE_SIZE = 16; // The initial number of buckets, a power of two
+        static const size_t EMPTY_VISITS_PER_STEP = 10; // Empty old buckets skipped per chain a rehash step may move
+        typedef typename NodeAllocator::template Pool<Entry> NodePool;
+
+        Entry** buckets; // One chain per bucket, new entries always go here
+        size_t bucketCount; // The current number of buckets, always a power of two
+        Entry** oldBuckets; // The bucket array being rehashed into buckets, nullptr when not rehashing
+        size_t oldBucketCount; // The number of old buckets, 0 when not rehashing
+        size_t rehashIndex; // Old buckets below this index have been moved and are empty
+        size_t count; // The number of elements in the table
+        float loadFactorThreshold = 0.7f; // The load factor threshold for resizing
+        Hash hashFunction; // The hash function to use
+        NodePool pool; // Where the entries are allocated
+
+        size_t hashOf(const K& key) const { return HashMixing::spread(hashFunction(key)); }
+
+        // calloc hands out large arrays as untouched zero pages, so a new bucket array costs no O(n) clearing up front
+        static Entry** allocateBuckets(size_t count) {
+            Entry** array = static_cast<Entry**>(std::calloc(count, sizeof(Entry*)));
+            if (array == nullptr) {
+                throw std::bad_alloc();
+            }
+            return array;
+        }
+
+        // Chain i of the old buckets followed by the new ones
+        Entry* headAt(size_t i) const { return i < oldBucketCount ? oldBuckets[i] : buckets[i - oldBucketCount]; }
+
+        // Comparing the cached hashes first skips the key comparison for nearly every other entry in the chain
+        Entry* findEntry(const K& key, size_t hash) const {
+            if (count == 0) {
+                return nullptr; // Also covers a moved-from table without buckets
+            }
+            for (Entry* entry = buckets[hash & (bucketCount - 1)]; entry != nullptr; entry = entry->next) {
+                if (entry->hash == hash && entry->key == key) {
+                    return entry;
+                }
+            }
+            if (oldBuckets != nullptr) {
+                for (Entry* entry = oldBuckets[hash & (oldBucketCount - 1)]; entry != nullptr; entry = entry->next) {
+                    if (entry->hash == hash && entry->key == key) {
+                        return entry;
+                    }
+                }
+            }
+            return nullptr;
+        }
+
+        bool unlink(Entry*& head, const K& key, size_t hash) {
+            Entry* prev = nullptr;
+            for (Entry* current = head; current != nullptr; prev = current, current = current->next) {
+                if (current->hash == hash && current->key == key) {
+                    if (prev != nullptr) {
+                        prev->next = current->next;
+                    } else {
+                        head = current->next;
+                    }
+                    pool.destroy(current);
+                    count--;
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        void swap(Table& other) noexcept {
+            std::swap(buckets, other.buckets);
+            std::swap(bucketCount, other.bucketCount);
+            std::swap(oldBuckets, other.oldBuckets);
+            std::swap(oldBucketCount, other.oldBucketCount);
+            std::swap(rehashIndex, other.rehashIndex);
+            std::swap(count, other.count);
+            std::swap(hashFunction, other.hashFunction);
+            pool.swap(other.pool);
+        }
+
+        void resize() {
+            if (bucketCount >= static_cast<size_t>(std::numeric_limits<int>::max() / 2)) {
+                throw HashtableException("Cannot resize: maximum table size reached.");
+            }
+            if (buckets == nullptr) {
+                buckets = allocateBuckets(INITIAL_TABLE_SIZE);
+                bucketCount = INITIAL_TABLE_SIZE;
+                return;
+            }
+            Entry** newBuckets = allocateBuckets(bucketCount * 2);
+            // A rehash still running when the table fills up again is finished before the next one starts
+            if (oldBuckets != nullptr) {
+                rehashStep(oldBucketCount);
+            }
+            oldBuckets = buckets;
+            oldBucketCount = bucketCount;
+            rehashIndex = 0;
+            buckets = newBuckets;
+            bucketCount *= 2;
+            if (RehashStep == 0) {
+                rehashStep(oldBucketCount);
+            }
+        }
+
+        // Move up to chains non-empty old buckets into the new array, frees the old array once all are moved
+        void rehashStep(size_t chains) {
+            size_t emptyVisits = chains * EMPTY_VISITS_PER_STEP;
+            while (chains > 0 && rehashIndex < oldBucketCount) {
+                Entry* entry = oldBuckets[rehashIndex];
+                oldBuckets[rehashIndex++] = nullptr;
+                if (entry == nullptr) {
+                    if (--emptyVisits == 0) {
+                        return;
+                    }
+                    continue;
+                }
+                while (entry != nullptr) {
+                    Entry* next = entry->next;
+                    Entry*& head = buckets[entry->hash & (bucketCount - 1)];
+                    entry->next = head;
+                    head = entry;
+                    entry = next;
+                }
+                chains--;
+            }
+            if (rehashIndex == oldBucketCount) {
+                std::free(oldBuckets);
+                oldBuckets = nullptr;
+                oldBucketCount = 0;
+                rehashIndex = 0;
+            }
+        }
+    };
+};
+
+typedef BasicChainedStorage<> ChainedStorage; // Chained entries allocated one by one, the default
+typedef BasicChainedStorage<PooledNodeAllocator<>> PooledChainedStorage; // Chained entries allocated from slabs
+typedef BasicChainedStorage<HeapNodeAllocator, 4> IncrementalChainedStorage; // Chained entries, rehashed 4 chains per operation
+
+/**
+ * @brief Storage policy for an open-addressing Robin Hood table with keys and values stored inline.
+ *
+ * @details All entries live in one contiguous slot array, so a lookup reads neighbouring slots instead of chasing
+ * nodes and an insert only allocates when the table grows. Each slot records how far it sits from its home slot.
+ * An insert that meets an entry closer to home than itself takes that slot and carries the displaced entry further
+ * along, which keeps probe sequences short and lets a lookup stop as soon as it meets an entry closer to home than
+ * the key would be. Removal shifts the following entries back by one instead of leaving tombstones.
+ *
+ * Entries move when the table grows or a neighbour is removed, so a reference to a value is only valid until the
+ * next insert or remove.
+ */
+struct RobinHoodStorage {
+    template <typename K, typename V, typename Hash>
+    class Table {
+    public:
+        struct Entry {
+            K key;
+            V value;
+            size_t hash; // Spread hash of the key, kept so resizing never calls the hash function again
+            Entry(const K& k, const V& v, size_t h) : key(k), value(v), hash(h) {}
+        };
+
+        /**
+         * @brief Position of an entry, the end position has slot == capacity().
+         */
+        struct Cursor {
+            size_t slot;
+            bool operator==(const Cursor& other) const { return slot == other.slot; }
+        };
+
+        Table() : slots(nullptr), distances(nullptr), slotCount(0), count(0), hashFunction() {
+            allocate(INITIAL_TABLE_SIZE);
+        }
+
+        Table(const Table& other) : slots(nullptr), distances(nullptr), slotCount(0), count(0), hashFunction(other.hashFunction) {
+            if (other.slotCount == 0) {
+                return;
+            }
+            allocate(other.slotCount);
+            try {
+                for (size_t i = 0; i < slotCount; ++i) {
+                    if (other.distances[i] != 0) {
+                        ::new (static_cast<void*>(slots + i)) Entry(other.slots[i]);
+                        distances[i] = other.distances[i];
+                        count++;
+                    }
+                }
+            } catch (...) {
+                clear();
+                deallocate(slots, distances, slotCount);
+                throw;
+            }
+        }
+
+        // The moved-from table has no slots and allocates them on its next insert, so moving never allocates
+        Table(Table&& other) noexcept : slots(nullptr), distances(nullptr), slotCount(0), count(0), hashFunction() {
+            swap(other);
+        }
+
+        Table& operator=(Table other) noexcept {
+            swap(other);
+            return *this;
+        }
+
+        ~Table() {
+            clear();
+            deallocate(slots, distances, slotCount);
+        }
+
+        V* find(const K& key) const {
+            size_t index = indexOf(key, hashOf(key));
+            return index == slotCount ? nullptr : &slots[index].value;
+        }
+
+        // Returns true when a new entry was added, false when an existing value was overwritten
+        bool insertOrAssign(const K& key, const V& value) {
+            size_t hash = hashOf(key);
+            size_t index = indexOf(key, hash);
+            if (index != slotCount) {
+                slots[index].value = value;
+                return false;
+            }
+            if (count + 1 > slotCount * loadFactorThreshold) {
+                resize();
+            }
+            place(Entry(key, value, hash));
+            count++;
+            return true;
+        }
+
+        bool erase(const K& key) {
+            size_t index = indexOf(key, hashOf(key));
+            if (index == slotCount) {
+                return false;
+            }
+            slots[index].~Entry();
+            distances[index] = 0;
+            // Backward shift: pull every following entry that is not in its home slot one step closer to home
+            for (size_t next = nextSlot(index); distances[next] > 1; index = next, next = nextSlot(next)) {
+                ::new (static_cast<void*>(slots + index)) Entry(std::move(slots[next]));
+                distances[index] = distances[next] - 1;
+                slots[next].~Entry();
+                distances[next] = 0;
+            }
+            count--;
+            return true;
+        }
+
+        void clear() {
+            for (size_t i = 0; i < slotCount; ++i) {
+                if (distances[i] != 0) {
+                    slots[i].~Entry();
+                    distances[i] = 0;
+                }
+            }
+            count = 0;
+        }
+
+        size_t size() const { return count; }
+        size_t capacity() const { return slotCount; }
+
+        Cursor first() const { return skipEmpty(0); }
+        Cursor last() const { return Cursor{slotCount}; }
+        void advance(Cursor& cursor) const { cursor = skipEmpty(cursor.slot + 1); }
+        Cursor locate(const K& key) const { return Cursor{indexOf(key, hashOf(key))}; }
+
+        bool atEnd(const Cursor& cursor) const { return cursor.slot >= slotCount; }
+        const K& keyAt(const Cursor& cursor) const { return slots[cursor.slot].key; }
+        V& valueAt(const Cursor& cursor) const { return slots[cursor.slot].value; }
+
+    private:
+        static const size_t INITIAL_TABLE_SIZE = 16; // The initial number of slots, a power of two
+        Entry* slots; // Slot i holds a constructed entry only while distances[i] != 0
+        uint32_t* distances; // Distance of each slot from its entry's home slot plus one, 0 marks an empty slot
+        size_t slotCount; // The current number of slots, always a power of two
+        size_t count; // The number of elements in the table
+        float loadFactorThreshold = 0.8f; // The load factor threshold for resizing
+        Hash hashFunction; // The hash function to use
+
+        size_t hashOf(const K& key) const { return HashMixing::spread(hashFunction(key)); }
+        size_t nextSlot(size_t index) const { return (index + 1) & (slotCount - 1); }
+
+        // Slot holding key, or slotCount when the key is absent
+        size_t indexOf(const K& key, size_t hash) const {
+            if (count == 0) {
+                return slotCount; // Also covers a moved-from table without slots
+            }
+            size_t index = hash & (slotCount - 1);
+            // An entry closer to its home than the key would be at this point proves the key is absent
+            for (uint32_t distance = 1; distances[index] >= distance; ++distance) {
+                if (slots[index].hash == hash && slots[index].key == key) {
+                    return index;
+                }
+                index = nextSlot(index);
+            }
+            return slotCount;
+        }
+
+        Cursor skipEmpty(size_t index) const {
+            while (index < slotCount && distances[index] == 0) {
+                ++index;
+            }
+            return Cursor{index};
+        }
+
+        // Put an entry known to be absent into the table, displacing entries that are closer to home
+        void place(Entry&& incoming) {
+            size_t index = incoming.hash & (slotCount - 1);
+            uint32_t distance = 1;
+            while (distances[index] != 0) {
+                if (distances[index] < distance) {
+                    std::swap(slots[index], incoming);
+                    std::swap(distances[index], distance);
+                }
+                index = nextSlot(index);
+                distance++;
+            }
+            ::new (static_cast<void*>(slots + index)) Entry(std::move(incoming));
+            distances[index] = distance;
+        }
+
+        void allocate(size_t capacity) {
+            distances = new uint32_t[capacity]();
+            try {
+                slots = std::allocator<Entry>().allocate(capacity);
+            } catch (...) {
+                delete[] distances;
+                distances = nullptr;
+                throw;
+            }
+            slotCount = capacity;
+        }
+
+        static void deallocate(Entry* oldSlots, uint32_t* oldDistances, size_t capacity) {
+            if (oldSlots != nullptr) {
+                std::allocator<Entry>().deallocate(oldSlots, capacity);
+            }
+            delete[] oldDistances;
+        }
+
+        void swap(Table& other) noexcept {
+            std::swap(slots, other.slots);
+            std::swap(distances, other.distances);
+            std::swap(slotCount, other.slotCount);
+            std::swap(count, other.count);
+            std::swap(hashFunction, other.hashFunction);
+        }
+
+        void resize() {
+            if (slotCount >= static_cast<size_t>(std::numeric_limits<int>::max() / 2)) {
+                throw HashtableException("Cannot resize: maximum table size reached.");
+            }
+            Entry* oldSlots = slots;
+            uint32_t* oldDistances = distances;
+            size_t oldCount = slotCount;
+            allocate(slotCount == 0 ? INITIAL_TABLE_SIZE : slotCount * 2);
+            for (size_t i = 0; i < oldCount; ++i) {
+                if (oldDistances[i] != 0) {
+                    place(std::move(oldSlots[i]));
+                    oldSlots[i].~Entry();
+                }
+            }
+            deallocate(oldSlots, oldDistances, oldCount);
+        }
+    };
+};
+
+//===============================================================
+
+/**
+ * @brief Hash table mapping unique keys to values.
+ *
+ * @details Both storage policies keep a power-of-two number of buckets and select one by masking the low bits of
+ * the spread hash, so no operation divides. Every entry caches that hash: growing the table moves entries without
+ * hashing their keys again, and a probe only compares keys when the cached hashes match.
+ *
+ * @tparam K The type of the keys.
+ * @tparam V The type of the values.
+ * @tparam Hash The hash function, KeyHash<K> by default.
+ * @tparam Storage The storage policy: ChainedStorage (default), PooledChainedStorage, IncrementalChainedStorage or
+ * RobinHoodStorage.
+ */
+template <typename K, typename V, typename Hash = KeyHash<K>, typename Storage = ChainedStorage>
 class HashTable {
 public:
+    typedef typename Storage::template Table<K, V, Hash> StorageTable; // The storage backend selected by Storage
+
     HashTable();
     ~HashTable();
     void insert(const K& key, const V& value);
@@ -151,24 +1035,23 @@ public:
     //operators
     V& operator[](const K& key);
     const V& operator[](const K& key) const;
-    bool operator==(const HashTable<K, V, Hash>& other) const;
-    bool operator!=(const HashTable<K, V, Hash>& other) const;
+    bool operator==(const HashTable<K, V, Hash, Storage>& other) const;
+    bool operator!=(const HashTable<K, V, Hash, Storage>& other) const;
 
 
     int getTableSize() const {
-        return TABLE_SIZE;
+        return static_cast<int>(storage.capacity());
     }
-    SimpleVector<K> getKeys();
-    SimpleVector<V> getValues();
-    SimpleVector<K> getKeys() const;
-    SimpleVector<V> getValues() const;
+    // Key and value lists keep up to 8 elements inline, so listing a small table does not allocate.
+    typedef SmallSimpleVector<K, 8> KeyList;
+    typedef SmallSimpleVector<V, 8> ValueList;
 
-    struct Entry {
-        K key;
-        V value;
-        Entry* next;
-        Entry(K k, V v) : key(k), value(v), next(nullptr) {}
-    };
+    KeyList getKeys();
+    ValueList getValues();
+    KeyList getKeys() const;
+    ValueList getValues() const;
+
+    typedef typename StorageTable::Entry Entry;
 
     #ifndef KEYVALUE
     #define KEYVALUE
@@ -217,537 +1100,359 @@ public:
     };
     #endif // KEYVALUE
 
-    class HashtableIterator{
-    private:
-        const HashTable<K, V, Hash>* hashtable;
-        int currentBucket;
-        Entry* currentEntry;
-        
-        void goToNextEntry() {
-            if (currentEntry && currentEntry->next) {
-                currentEntry = currentEntry->next;
-            } else {
-                do {
-                    currentBucket++;
-                    if (currentBucket >= hashtable->TABLE_SIZE) {
-                        currentEntry = nullptr;
-                        return;
-                    }
-                    currentEntry = hashtable->table[currentBucket];
-                } while (!currentEntry);
-            }
+
+    /**
+     * @brief Reference to an entry inside the table, returned by iterators instead of a KeyValuePair copy.
+     *
+     * @details key and value refer to the stored entry, so reading them copies nothing and writing value through a
+     * mutable iterator changes the table. Convert to KeyValuePair to keep a copy.
+     */
+    template <bool Const>
+    struct EntryReference {
+        typedef typename std::conditional<Const, const V&, V&>::type ValueReference;
+
+        const K& key;
+        ValueReference value;
+
+        const K& first() const { return key; }
+        ValueReference second() const { return value; }
+
+        operator KeyValuePair() const { return KeyValuePair{key, value}; }
+
+        friend std::ostream& operator<<(std::ostream& os, const EntryReference& kv) {
+            os << kv.key << ": " << kv.value;
+            return os;
         }
+    };
+
+    /**
+     * @brief Iterator over the entries. HashtableIterator may modify values, ConstHashtableIterator may not.
+     */
+    template <bool Const>
+    class BasicIterator {
+    private:
+        typedef typename StorageTable::Cursor Cursor;
+        const HashTable<K, V, Hash, Storage>* hashtable;
+        Cursor cursor;
+
+        template <bool> friend class BasicIterator;
+
+        // Keeps the reference alive for the duration of an it->member expression
+        struct ArrowProxy {
+            EntryReference<Const> entry;
+            const EntryReference<Const>* operator->() const { return &entry; }
+        };
+
     public:
-        HashtableIterator(const HashTable<K, V, Hash>* ht, int bucket, Entry* entry)
-            : hashtable(ht), currentBucket(bucket), currentEntry(entry) {
-            if (currentEntry == nullptr && bucket < hashtable->TABLE_SIZE) {
-                goToNextEntry();
-            }
-        }
-        KeyValuePair operator*() {
-            if (currentEntry == nullptr) {
+        typedef std::forward_iterator_tag iterator_category;
+        typedef KeyValuePair value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef EntryReference<Const> reference;
+        typedef ArrowProxy pointer;
+
+        BasicIterator(const HashTable<K, V, Hash, Storage>* ht, Cursor position)
+            : hashtable(ht), cursor(position) {}
+
+        // A mutable iterator converts to a const one
+        template <bool OtherConst, typename = typename std::enable_if<Const && !OtherConst>::type>
+        BasicIterator(const BasicIterator<OtherConst>& other) : hashtable(other.hashtable), cursor(other.cursor) {}
+
+        reference operator*() const {
+            if (hashtable->storage.atEnd(cursor)) {
                 throw std::runtime_error("Dereferencing end iterator");
             }
-            return KeyValuePair{currentEntry->key, currentEntry->value};
+            return reference{hashtable->storage.keyAt(cursor), hashtable->storage.valueAt(cursor)};
         }
-        
-        HashtableIterator& operator++() {
-            goToNextEntry();
+
+        pointer operator->() const {
+            return ArrowProxy{**this};
+        }
+
+        BasicIterator& operator++() {
+            hashtable->storage.advance(cursor);
             return *this;
         }
-        
-        bool operator!=(const HashtableIterator& other) {
-            return currentBucket != other.currentBucket || currentEntry != other.currentEntry;
+
+        BasicIterator operator++(int) {
+            BasicIterator previous = *this;
+            ++*this;
+            return previous;
         }
 
-        const bool operator==(const HashtableIterator& other) const {
-            return currentBucket == other.currentBucket && currentEntry == other.currentEntry;
+        bool operator==(const BasicIterator& other) const {
+            return cursor == other.cursor;
         }
 
-        const bool operator!=(const HashtableIterator& other) const {
+        bool operator!=(const BasicIterator& other) const {
             return !(*this == other);
         }
 
-        HashtableIterator find(const K& key){
-            int index = hashtable->hash(key);
-            currentBucket = index;
-            currentEntry = hashtable->table[index];
-            while (currentEntry != nullptr) {
-                if (currentEntry->key == key) {
-                    return *this;
-                }
-                currentEntry = currentEntry->next;
-            }
-            goToNextEntry();
+        // Moves to the entry with the given key, or to the end when the key is absent
+        BasicIterator find(const K& key){
+            cursor = hashtable->storage.locate(key);
             return *this;
         }
 
-        SimpleVector<K> getKeys() const {
-            SimpleVector<K> keys;
-            for (int i = 0; i < hashtable->TABLE_SIZE; ++i) {
-                for (Entry* entry = hashtable->table[i]; entry != nullptr; entry = entry->next) {
-                    keys.push_back(entry->key);
-                }
-            }
-            return keys;
+        KeyList getKeys() const {
+            return hashtable->getKeys();
         }
 
-        SimpleVector<V> getValues() const {
-            SimpleVector<V> values;
-            for (int i = 0; i < hashtable->TABLE_SIZE; ++i) {
-                for (Entry* entry = hashtable->table[i]; entry != nullptr; entry = entry->next) {
-                    values.push_back(entry->value);
-                }
-            }
-            return values;
+        ValueList getValues() const {
+            return hashtable->getValues();
         }
+    };
 
-        const KeyValuePair* operator->() const {
-            if (currentEntry == nullptr) {
-                throw std::runtime_error("Dereferencing end iterator");
-            }
-            static KeyValuePair temp{currentEntry->key, currentEntry->value};
-            return &temp;
-        }
+    typedef BasicIterator<false> HashtableIterator;
+    typedef BasicIterator<true> ConstHashtableIterator;
 
-        // Optionally, add a non-const version if needed
-        KeyValuePair* operator->() {
-            if (currentEntry == nullptr) {
-                throw std::runtime_error("Dereferencing end iterator");
-            }
-            static KeyValuePair temp{currentEntry->key, currentEntry->value};
-            return &temp;
-        }
-        
-    };
     HashtableIterator begin();
     HashtableIterator end();
-    HashtableIterator cbegin() const;
-    HashtableIterator cend() const;
+    ConstHashtableIterator begin() const;
+    ConstHashtableIterator end() const;
+    ConstHashtableIterator cbegin() const;
+    ConstHashtableIterator cend() const;
+
+    // Lookups that report a missing key through their result instead of KeyNotFoundException and never allocate
+    HashtableIterator find(const K& key);
+    ConstHashtableIterator find(const K& key) const;
+    V* tryGet(const K& key);
+    const V* tryGet(const K& key) const;
+    bool erase(const K& key);
+
 
-    
     private:
-    static const int INITIAL_TABLE_SIZE = 16; // The initial size of the table
-    Entry** table; // The table itself
-    int TABLE_SIZE; // The current size of the table
-    int count;  // The number of elements in the table
-    float loadFactorThreshold = 0.7; // The load factor threshold for resizing
-    Hash hashFunction; // The hash function to use
-    
-    void resize();
-    void clear(Entry** table, int capacity);
-    int hash(const K& key);
+    StorageTable storage; // Entries, laid out by the storage policy
 };
 
 //===============================================================
-    #ifndef KEYNOTFOUNDEXCEPTION
-    #define KEYNOTFOUNDEXCEPTION
-        class KeyNotFoundException : public std::exception {
-        public:
-            explicit KeyNotFoundException(const std::string& message) : msg_(message) {}
-            virtual const char* what() const noexcept {
-                return msg_.c_str();
-            }
-        private:
-            std::string msg_;
-        };
-    #endif // KEYNOTFOUNDEXCEPTION
 
-    #ifndef HASHTABLEEXCEPTION
-    #define HASHTABLEEXCEPTION
-        class HashtableException : public std::exception {
-        public:
-            explicit HashtableException(const std::string& message) : msg_(message) {}
-            virtual const char* what() const noexcept {
-                return msg_.c_str();
-            }
-        private:
-            std::string msg_;
-        };
-    #endif // HASHTABLEEXCEPTION
-
-    #ifndef INDEXOUTOFBOUNDSEXCEPTION
-    #define INDEXOUTOFBOUNDSEXCEPTION
-        class IndexOutOfBoundsException : public std::exception {
-        public:
-            explicit IndexOutOfBoundsException(const std::string& message) : msg_(message) {}
-            virtual const char* what() const noexcept {
-                return msg_.c_str();
-            }
-        private:
-            std::string msg_;
-        };
 
-    #endif // INDEXOUTOFBOUNDSEXCEPTION
+template <typename K, typename V, typename Hash, typename Storage>
+HashTable<K, V, Hash, Storage>::HashTable() : storage() {
+}
 
-//===============================================================
+template <typename K, typename V, typename Hash, typename Storage>
+HashTable<K, V, Hash, Storage>::~HashTable() {
+}
 
+template <typename K, typename V, typename Hash, typename Storage>
+void HashTable<K, V, Hash, Storage>::insert(const K& key, const V& value) {
+    storage.insertOrAssign(key, value);
+}
 
-template <typename K, typename V, typename Hash>
-HashTable<K, V, Hash>::HashTable() : TABLE_SIZE(INITIAL_TABLE_SIZE), count(0), hashFunction() {
-    table = new Entry*[TABLE_SIZE]();
-    if (!table) {
-        throw HashtableException("Memory allocation failed.");
+template <typename K, typename V, typename Hash, typename Storage>
+void HashTable<K, V, Hash, Storage>::remove(const K& key) {
+    if (!storage.erase(key)) {
+        throw KeyNotFoundException("Key not found in hash table. Key: " + to_string_helper(key));
     }
-    for (int i = 0; i < TABLE_SIZE; ++i) {
-        table[i] = nullptr;
+}
+
+template <typename K, typename V, typename Hash, typename Storage>
+V& HashTable<K, V, Hash, Storage>::get(const K& key) {
+    V* value = storage.find(key);
+    if (value == nullptr) {
+        throw KeyNotFoundException("Key not found in hash table. Key: " + to_string_helper(key));
     }
+    return *value;
 }
 
-template <typename K, typename V, typename Hash>
-HashTable<K, V, Hash>::~HashTable() {
-    clear();
-    delete[] table;
+template <typename K, typename V, typename Hash, typename Storage>
+bool HashTable<K, V, Hash, Storage>::contains(const K& key) const {
+    return storage.find(key) != nullptr;
 }
 
-template <typename K, typename V, typename Hash>
-void HashTable<K, V, Hash>::insert(const K& key, const V& value) {
-    if (count >= TABLE_SIZE * loadFactorThreshold) {
-        resize();
-    }
-    
-    int index = hashFunction(key) % TABLE_SIZE;
-    Entry* current = table[index];
-    while (current != nullptr) {
-        if (current->key == key) {
-            current->value = value;  // Update existing entry
-            return;
-        }
-        current = current->next;
-    }
-    
-    // If we reach here, the key doesn't exist, so we insert a new entry
-    Entry* newEntry = new Entry(key, value);
-    newEntry->next = table[index];
-    table[index] = newEntry;
-    count++;
+
+template <typename K, typename V, typename Hash, typename Storage>
+bool HashTable<K, V, Hash, Storage>::isEmpty() {
+    return storage.size() == 0;
 }
 
-template <typename K, typename V, typename Hash>
-void HashTable<K, V, Hash>::remove(const K& key) {
-    int index = hashFunction(key) % TABLE_SIZE;
-    Entry* current = table[index];
-    Entry* prev = nullptr;
-    while (current != nullptr) {
-        if (current->key == key) {
-            if (prev != nullptr) {
-                prev->next = current->next;
-            } else {
-                table[index] = current->next;
-            }
-            delete current;
-            count--;
-            return;
-        }
-        prev = current;
-        current = current->next;
-    }
-    throw KeyNotFoundException("Key not found in hash table. Key: " + to_string_helper(key));
+template <typename K, typename V, typename Hash, typename Storage>
+int HashTable<K, V, Hash, Storage>::size() {
+    return static_cast<int>(storage.size());
 }
 
-template <typename K, typename V, typename Hash>
-V& HashTable<K, V, Hash>::get(const K& key) {
-    int index = hashFunction(key) % TABLE_SIZE;
-    Entry* entry = table[index];
-    while (entry != nullptr) {
-        if (entry->key == key) {
-            return entry->value;
-        }
-        entry = entry->next;
-    }
-    throw KeyNotFoundException("Key not found in hash table. Key: " + to_string_helper(key));
+template <typename K, typename V, typename Hash, typename Storage>
+void HashTable<K, V, Hash, Storage>::clear() {
+    storage.clear();
 }
 
-template <typename K, typename V, typename Hash>
-bool HashTable<K, V, Hash>::contains(const K& key) const {
-    int index = hashFunction(key) % TABLE_SIZE;
-    Entry* current = table[index];
-    while (current != nullptr) {
-        if (current->key == key) {
-            return true;
-        }
-        current = current->next;
-    }
-    return false;
+template <typename K, typename V, typename Hash, typename Storage>
+void HashTable<K, V, Hash, Storage>::print() {
+    static_cast<const HashTable&>(*this).print();
 }
 
 
-template <typename K, typename V, typename Hash>
-bool HashTable<K, V, Hash>::isEmpty() {
-    return count == 0;
+template <typename K, typename V, typename Hash, typename Storage>
+typename HashTable<K, V, Hash, Storage>::HashtableIterator HashTable<K, V, Hash, Storage>::begin() {
+    return HashtableIterator(this, storage.first());
 }
 
-template <typename K, typename V, typename Hash>
-int HashTable<K, V, Hash>::size() {
-    return count;
+template <typename K, typename V, typename Hash, typename Storage>
+typename HashTable<K, V, Hash, Storage>::HashtableIterator HashTable<K, V, Hash, Storage>::end()  {
+    return HashtableIterator(this, storage.last());
 }
 
-template <typename K, typename V, typename Hash>
-void HashTable<K, V, Hash>::clear() {
-    for (int i = 0; i < TABLE_SIZE; ++i) {
-        Entry* current = table[i];
-        while (current != nullptr) {
-            Entry* next = current->next;
-            delete current;
-            current = next;
-        }
-        table[i] = nullptr;
-    }
-    count = 0;
+template <typename K, typename V, typename Hash, typename Storage>
+typename HashTable<K, V, Hash, Storage>::ConstHashtableIterator HashTable<K, V, Hash, Storage>::begin() const {
+    return ConstHashtableIterator(this, storage.first());
 }
 
-template <typename K, typename V, typename Hash>
-void HashTable<K, V, Hash>::print() {
-    for (int i = 0; i < TABLE_SIZE; ++i) {
-        Entry* entry = table[i];
-        while (entry != nullptr) {
-            entry = entry->next;
-        }
-    }
+template <typename K, typename V, typename Hash, typename Storage>
+typename HashTable<K, V, Hash, Storage>::ConstHashtableIterator HashTable<K, V, Hash, Storage>::end() const {
+    return ConstHashtableIterator(this, storage.last());
 }
 
-template <typename K, typename V, typename Hash>
-void HashTable<K, V, Hash>::resize() {
-    if (TABLE_SIZE >= std::numeric_limits<int>::max() / 2) {
-        throw HashtableException("Cannot resize: maximum table size reached.");
-    }
-    int newSize = TABLE_SIZE * 2;
-    Entry** newTable = new Entry*[newSize]();
-    if (!newTable) {
-        throw HashtableException("Memory allocation failed during resize.");
-    }
-    for (int i = 0; i < newSize; ++i) {
-        newTable[i] = nullptr;
-    }
-    for (int i = 0; i < TABLE_SIZE; ++i) {
-        Entry* entry = table[i];
-        while (entry != nullptr) {
-            Entry* next = entry->next;
-            int newIndex = hashFunction(entry->key) % newSize;
-            entry->next = newTable[newIndex];
-            newTable[newIndex] = entry;
-            entry = next;
-        }
-    }
-    delete[] table;
-    table = newTable;
-    TABLE_SIZE = newSize;
+template <typename K, typename V, typename Hash, typename Storage>
+typename HashTable<K, V, Hash, Storage>::ConstHashtableIterator HashTable<K, V, Hash, Storage>::cbegin() const {
+    return ConstHashtableIterator(this, storage.first());
 }
 
-template <typename K, typename V, typename Hash>
-int HashTable<K, V, Hash>::hash(const K& key) {
-    return hashFunction(key) % TABLE_SIZE;
+template <typename K, typename V, typename Hash, typename Storage>
+typename HashTable<K, V, Hash, Storage>::ConstHashtableIterator HashTable<K, V, Hash, Storage>::cend() const {
+    return ConstHashtableIterator(this, storage.last());
 }
 
+/**
+ * @brief Find the entry of a key.
+ *
+ * @return An iterator to the entry, or end() if the key is absent.
+ */
+template <typename K, typename V, typename Hash, typename Storage>
+typename HashTable<K, V, Hash, Storage>::HashtableIterator HashTable<K, V, Hash, Storage>::find(const K& key) {
+    return HashtableIterator(this, storage.locate(key));
+}
 
-template <typename K, typename V, typename Hash>
-typename HashTable<K, V, Hash>::HashtableIterator HashTable<K, V, Hash>::begin() {
-    return HashtableIterator(this, 0, nullptr);
+template <typename K, typename V, typename Hash, typename Storage>
+typename HashTable<K, V, Hash, Storage>::ConstHashtableIterator HashTable<K, V, Hash, Storage>::find(const K& key) const {
+    return ConstHashtableIterator(this, storage.locate(key));
 }
 
-template <typename K, typename V, typename Hash>
-typename HashTable<K, V, Hash>::HashtableIterator HashTable<K, V, Hash>::end()  {
-    return HashtableIterator(this, TABLE_SIZE, nullptr);
+/**
+ * @brief Get a pointer to the value of a key.
+ *
+ * @return The value, or nullptr if the key is absent. The pointer is valid until the key is removed, or with
+ * RobinHoodStorage until the next insert or remove.
+ */
+template <typename K, typename V, typename Hash, typename Storage>
+V* HashTable<K, V, Hash, Storage>::tryGet(const K& key) {
+    return storage.find(key);
 }
 
-template <typename K, typename V, typename Hash>
-typename HashTable<K, V, Hash>::HashtableIterator HashTable<K, V, Hash>::cbegin() const {
-    return HashtableIterator(this, 0, nullptr);
+template <typename K, typename V, typename Hash, typename Storage>
+const V* HashTable<K, V, Hash, Storage>::tryGet(const K& key) const {
+    return storage.find(key);
 }
 
-template <typename K, typename V, typename Hash>
-typename HashTable<K, V, Hash>::HashtableIterator HashTable<K, V, Hash>::cend() const {
-    return HashtableIterator(this, TABLE_SIZE, nullptr);
+/**
+ * @brief Remove a key if it is present.
+ *
+ * @return true if the key was removed, false if it was absent.
+ */
+template <typename K, typename V, typename Hash, typename Storage>
+bool HashTable<K, V, Hash, Storage>::erase(const K& key) {
+    return storage.erase(key);
 }
 
-template <typename K, typename V, typename Hash>
-const void HashTable<K, V, Hash>::insert(const K& key, const V& value) const {
-    if (count >= TABLE_SIZE * loadFactorThreshold) {
-        resize();
-    }
-    
-    int index = hashFunction(key) % TABLE_SIZE;
-    Entry* current = table[index];
-    while (current != nullptr) {
-        if (current->key == key) {
-            current->value = value;  // Update existing entry
-            return;
-        }
-        current = current->next;
-    }
-    
-    // If we reach here, the key doesn't exist, so we insert a new entry
-    Entry* newEntry = new Entry(key, value);
-    newEntry->next = table[index];
-    table[index] = newEntry;
-    count++;
+// The const-qualified mutators are kept for source compatibility and modify the table like their non-const versions.
+template <typename K, typename V, typename Hash, typename Storage>
+const void HashTable<K, V, Hash, Storage>::insert(const K& key, const V& value) const {
+    const_cast<HashTable*>(this)->insert(key, value);
 }
 
-template <typename K, typename V, typename Hash>
-const void HashTable<K, V, Hash>::remove(const K& key) const {
-    int index = hashFunction(key) % TABLE_SIZE;
-    Entry* current = table[index];
-    Entry* prev = nullptr;
-    while (current != nullptr) {
-        if (current->key == key) {
-            if (prev != nullptr) {
-                prev->next = current->next;
-            } else {
-                table[index] = current->next;
-            }
-            delete current;
-            count--;
-            return;
-        }
-        prev = current;
-        current = current->next;
-    }
-    throw KeyNotFoundException("Key not found in hash table. Key: " + to_string_helper(key));
+template <typename K, typename V, typename Hash, typename Storage>
+const void HashTable<K, V, Hash, Storage>::remove(const K& key) const {
+    const_cast<HashTable*>(this)->remove(key);
 }
 
-template <typename K, typename V, typename Hash>
-const V& HashTable<K, V, Hash>::get(const K& key) const {
-    int index = hashFunction(key) % TABLE_SIZE;
-    Entry* entry = table[index];
-    while (entry != nullptr) {
-        if (entry->key == key) {
-            return entry->value;
-        }
-        entry = entry->next;
+template <typename K, typename V, typename Hash, typename Storage>
+const V& HashTable<K, V, Hash, Storage>::get(const K& key) const {
+    const V* value = storage.find(key);
+    if (value == nullptr) {
+        throw KeyNotFoundException("Key not found in hash table. Key: " + to_string_helper(key));
     }
-    throw KeyNotFoundException("Key not found in hash table. Key: " + to_string_helper(key));
+    return *value;
 }
 
-template <typename K, typename V, typename Hash>
-const bool HashTable<K, V, Hash>::isEmpty() const {
-    return count == 0;
+template <typename K, typename V, typename Hash, typename Storage>
+const bool HashTable<K, V, Hash, Storage>::isEmpty() const {
+    return storage.size() == 0;
 }
 
-template <typename K, typename V, typename Hash>
-const int HashTable<K, V, Hash>::size() const {
-    return count;
+template <typename K, typename V, typename Hash, typename Storage>
+const int HashTable<K, V, Hash, Storage>::size() const {
+    return static_cast<int>(storage.size());
 }
 
-template <typename K, typename V, typename Hash>
-const void HashTable<K, V, Hash>::clear() const {
-    for (int i = 0; i < TABLE_SIZE; ++i) {
-        Entry* current = table[i];
-        while (current != nullptr) {
-            Entry* next = current->next;
-            delete current;
-            current = next;
-        }
-        table[i] = nullptr;
-    }
-    count = 0;
+template <typename K, typename V, typename Hash, typename Storage>
+const void HashTable<K, V, Hash, Storage>::clear() const {
+    const_cast<HashTable*>(this)->clear();
 }
 
-template <typename K, typename V, typename Hash>
-const void HashTable<K, V, Hash>::print() const {
-    for (int i = 0; i < TABLE_SIZE; ++i) {
-        Entry* entry = table[i];
-        while (entry != nullptr) {
-            entry = entry->next;
-        }
+template <typename K, typename V, typename Hash, typename Storage>
+const void HashTable<K, V, Hash, Storage>::print() const {
+    for (auto cursor = storage.first(); !storage.atEnd(cursor); storage.advance(cursor)) {
+        #ifdef DEBUG
+        std::cout << storage.keyAt(cursor) << ": " << storage.valueAt(cursor) << std::endl;
+        #endif
     }
 }
 
-template <typename K, typename V, typename Hash>
-SimpleVector<K> HashTable<K, V, Hash>::getKeys() {
-    SimpleVector<K> keys;
-    for (int i = 0; i < TABLE_SIZE; ++i) {
-        for (Entry* entry = table[i]; entry != nullptr; entry = entry->next) {
-            keys.push_back(entry->key);
-        }
-    }
-    return keys;
+template <typename K, typename V, typename Hash, typename Storage>
+typename HashTable<K, V, Hash, Storage>::KeyList HashTable<K, V, Hash, Storage>::getKeys() {
+    return static_cast<const HashTable&>(*this).getKeys();
 }
 
-template <typename K, typename V, typename Hash>
-SimpleVector<V> HashTable<K, V, Hash>::getValues() {
-    SimpleVector<V> values;
-    for (int i = 0; i < TABLE_SIZE; ++i) {
-        for (Entry* entry = table[i]; entry != nullptr; entry = entry->next) {
-            values.push_back(entry->value);
-        }
-    }
-    return values;
+template <typename K, typename V, typename Hash, typename Storage>
+typename HashTable<K, V, Hash, Storage>::ValueList HashTable<K, V, Hash, Storage>::getValues() {
+    return static_cast<const HashTable&>(*this).getValues();
 }
 
-template <typename K, typename V, typename Hash>
-SimpleVector<K> HashTable<K, V, Hash>::getKeys() const {
-    SimpleVector<K> keys;
-    for (int i = 0; i < TABLE_SIZE; ++i) {
-        for (Entry* entry = table[i]; entry != nullptr; entry = entry->next) {
-            keys.push_back(entry->key);
-        }
+template <typename K, typename V, typename Hash, typename Storage>
+typename HashTable<K, V, Hash, Storage>::KeyList HashTable<K, V, Hash, Storage>::getKeys() const {
+    KeyList keys;
+    for (auto cursor = storage.first(); !storage.atEnd(cursor); storage.advance(cursor)) {
+        keys.push_back(storage.keyAt(cursor));
     }
     return keys;
 }
 
-template <typename K, typename V, typename Hash>
-SimpleVector<V> HashTable<K, V, Hash>::getValues() const {
-    SimpleVector<V> values;
-    for (int i = 0; i < TABLE_SIZE; ++i) {
-        for (Entry* entry = table[i]; entry != nullptr; entry = entry->next) {
-            values.push_back(entry->value);
-        }
+template <typename K, typename V, typename Hash, typename Storage>
+typename HashTable<K, V, Hash, Storage>::ValueList HashTable<K, V, Hash, Storage>::getValues() const {
+    ValueList values;
+    for (auto cursor = storage.first(); !storage.atEnd(cursor); storage.advance(cursor)) {
+        values.push_back(storage.valueAt(cursor));
     }
     return values;
 }
 
-template <typename K, typename V, typename Hash>
-V& HashTable<K, V, Hash>::operator[](const K& key) {
-    int index = hashFunction(key) % TABLE_SIZE;
-    Entry* entry = table[index];
-    while (entry != nullptr) {
-        if (entry->key == key) {
-            return entry->value;
-        }
-        entry = entry->next;
-    }
-    throw KeyNotFoundException("Key not found in hash table. Key: " + to_string_helper(key));
+template <typename K, typename V, typename Hash, typename Storage>
+V& HashTable<K, V, Hash, Storage>::operator[](const K& key) {
+    return get(key);
 }
 
-template <typename K, typename V, typename Hash>
-const V& HashTable<K, V, Hash>::operator[](const K& key) const {
-    int index = hashFunction(key) % TABLE_SIZE;
-    Entry* entry = table[index];
-    while (entry != nullptr) {
-        if (entry->key == key) {
-            return entry->value;
-        }
-        entry = entry->next;
-    }
-    throw KeyNotFoundException("Key not found in hash table. Key: " + to_string_helper(key));
+template <typename K, typename V, typename Hash, typename Storage>
+const V& HashTable<K, V, Hash, Storage>::operator[](const K& key) const {
+    return get(key);
 }
 
-template <typename K, typename V, typename Hash>
-bool HashTable<K, V, Hash>::operator==(const HashTable<K, V, Hash>& other) const {
-    if (count != other.count) {
+template <typename K, typename V, typename Hash, typename Storage>
+bool HashTable<K, V, Hash, Storage>::operator==(const HashTable<K, V, Hash, Storage>& other) const {
+    if (storage.size() != other.storage.size()) {
         return false;
     }
-    for (int i = 0; i < TABLE_SIZE; ++i) {
-        Entry* entry = table[i];
-        while (entry != nullptr) {
-            if (!other.contains(entry->key)) {
-                return false;
-            }
-            if (entry->value != other.get(entry->key)) {
-                return false;
-            }
-            entry = entry->next;
+    for (auto cursor = storage.first(); !storage.atEnd(cursor); storage.advance(cursor)) {
+        const V* value = other.storage.find(storage.keyAt(cursor));
+        if (value == nullptr || storage.valueAt(cursor) != *value) {
+            return false;
         }
     }
     return true;
 }
 
-template <typename K, typename V, typename Hash>
-bool HashTable<K, V, Hash>::operator!=(const HashTable<K, V, Hash>& other) const {
+template <typename K, typename V, typename Hash, typename Storage>
+bool HashTable<K, V, Hash, Storage>::operator!=(const HashTable<K, V, Hash, Storage>& other) const {
     return !(*this == other);
 }
 
-
-
-
-#endif // HASHTABLE_H
\ No newline at end of file
+#endif // HASHTABLE_H
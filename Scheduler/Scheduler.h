@@ -4,6 +4,7 @@
 #include <iostream>
 #include <functional>
 #include "SimpleVector.h"
+#include "ConcurrentSimpleVector.h"
 #include <chrono>
 #include <string>
 #include "Map.h"
@@ -287,13 +288,10 @@ public:
         if (interval <= 0) {
             throw SchedulerIntervalException("Invalid interval error");
         }
-        std::unique_lock<std::shared_mutex> lock(jobsMutex);
-        jobs.emplace_back(interval);
-        Job& job = jobs.back();
+        Job job(interval);
         job.setUnit(unit);  // Set the unit before scheduling the first run
-        job.scheduleNextRun();  // Schedule the first run as soon as the job is added
-        jobCount.fetch_add(1, std::memory_order_relaxed);
-        return job;
+        job.scheduleNextRun();  // Schedule the first run before the job becomes visible to the scheduler thread
+        return jobs.emplace_back(std::move(job));  // Jobs never move, so the reference stays valid
     }
 
     std::chrono::steady_clock::time_point getNextRunTime() {
@@ -320,29 +318,22 @@ private:
         while (running.load(std::memory_order_acquire)) {
             auto now = std::chrono::steady_clock::now();
             auto nextRun = now + std::chrono::nanoseconds(1);  // Check every 1ns
-            {
-                std::shared_lock<std::shared_mutex> lock(jobsMutex);
-                unsigned int count = jobCount.load(std::memory_order_relaxed);
-                for (unsigned int i = 0; i < count; ++i) {
-                    if (jobs[i].shouldRun()) {
-                        Job* job = &jobs[i];
-                        lock.unlock();
-                        job->run();  // Run the job
-                        job->scheduleNextRun();  // Schedule its next run
-                        lock.lock();
-                    }
-                    nextRun = std::min(nextRun, jobs[i].getNextRun());
+            std::size_t count = jobs.elements();  // Jobs added while this pass runs are picked up by the next one
+            for (std::size_t i = 0; i < count; ++i) {
+                Job& job = jobs[i];
+                if (job.shouldRun()) {
+                    job.run();  // Run the job
+                    job.scheduleNextRun();  // Schedule its next run
                 }
+                nextRun = std::min(nextRun, job.getNextRun());
             }
             std::this_thread::sleep_until(nextRun);
         }
     }
-    SimpleVector<Job> jobs;
+    ConcurrentSimpleVector<Job> jobs;  // Append-only and lock-free, so every() never blocks the scheduler thread
     std::thread schedulerThread;
     std::atomic<bool> running{false};
     std::condition_variable_any cv;  // Changed this line
-    mutable std::shared_mutex jobsMutex;
-    std::atomic<size_t> jobCount{0};
 };
 
 #endif // SCHEDULER_H
\ No newline at end of file
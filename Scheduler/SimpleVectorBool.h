@@ -0,0 +1,1000 @@
+#ifndef SIMPLEVECTORBOOL_H
+#define SIMPLEVECTORBOOL_H
+
+#include "SimpleVector.h"
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <mutex>
+#include <shared_mutex>
+#include <type_traits>
+
+//==============================================================================|
+
+/**
+ * @brief Bit-packed SimpleVector of flags.
+ *
+ * @details Flags are stored 64 to a 64-bit word, using an eighth of the memory of one bool per byte. Bulk queries
+ * work on whole words: popcount and count use the POPCNT instruction, findFirstSet/findNextSet skip 64 clear flags
+ * per step, and AND/OR/XOR between vectors combine 256 bits at a time with AVX2 (see BitKernels).
+ *
+ * A flag cannot be addressed directly, so operator[], get, front, back and the mutable iterator return a
+ * BitReference proxy, which converts to bool and can be assigned. Const access returns plain bool values.
+ * Proxies and iterators are invalidated when the vector grows, just like references to elements of other SimpleVectors.
+ *
+ * The words themselves live in an unlocked SimpleVector, so the growth policy, huge page allocation and
+ * allocation statistics apply to them. Flags past the last element are always kept clear.
+ *
+ * @tparam LockPolicy The locking policy, see SimpleVector.
+ * @tparam GrowthPolicy The growth policy of the word array, see SimpleVector.
+ */
+template <typename LockPolicy, typename GrowthPolicy>
+class SimpleVector<bool, LockPolicy, GrowthPolicy> {
+public:
+    typedef uint64_t Word; // Storage unit holding 64 flags
+    static constexpr size_t WORD_BITS = 64; // Number of flags per word
+
+private:
+    /**
+     * @brief Word array that exposes the storage hooks of SimpleVector to the packed vector.
+     */
+    class WordStorage : public SimpleVector<Word, NoLockPolicy, GrowthPolicy> {
+        typedef SimpleVector<Word, NoLockPolicy, GrowthPolicy> Base;
+
+    public:
+        WordStorage() : Base(nullptr, 0) {} // No storage until the first flag is added
+        WordStorage(Word* buffer, size_t bufferWords) : Base(buffer, bufferWords) {}
+        WordStorage(const WordStorage& other) : Base(nullptr, 0) { this->copyFrom(other); }
+
+        using Base::copyFrom;
+        using Base::moveFrom;
+        using Base::releaseStorage;
+        using Base::storageIsInline;
+        using Base::truncate;
+    };
+
+    WordStorage words; // The packed flags; bit i of the vector is bit i % 64 of word i / 64
+    size_t elementCount; // Number of flags in the vector
+    mutable LockPolicy lockPolicy; // Locking policy used for synchronization
+
+    typedef std::lock_guard<LockPolicy> WriteLock; // Exclusive lock for methods that modify the vector
+    typedef std::shared_lock<LockPolicy> ReadLock; // Shared lock for read-only methods
+
+    // The private helpers below expect the caller to already hold the lock.
+    static size_t wordsFor(size_t bits) { return bits / WORD_BITS + (bits % WORD_BITS != 0); } // Words needed for bits flags
+    static Word maskOf(size_t index) { return Word(1) << (index % WORD_BITS); } // Mask of a flag within its word
+    Word* wordPointer() { return words.data(); }
+    const Word* wordPointer() const { return words.data(); }
+    void pushUnlocked(bool value); // Add a flag at the end
+    void reserveUnlocked(size_t bits); // Make room for at least bits flags
+    void resetUnlocked(size_t count, bool value); // Replace the contents with count copies of value
+    ptrdiff_t findUnlocked(size_t from, bool value) const; // Index of the first flag equal to value at or after from, or -1
+    template <BitKernels::Operation Op>
+    SimpleVector& combine(const SimpleVector& other); // Combine the words of other into this vector
+
+protected:
+    SimpleVector(Word* buffer, size_t bufferWords); // Constructor used by SmallSimpleVector to supply inline words
+    void copyFrom(const SimpleVector& other); // Copy the flags of other into this empty vector
+    void moveFrom(SimpleVector& other); // Take over the flags of other; this vector must be empty
+    void replaceStorage(SimpleVector& other); // Replace the flags with those of other, which no other thread may use
+    void releaseStorage(); // Drop all flags and free any heap storage
+    bool storageIsInline() const; // Check if the words live in the inline storage
+
+public:
+    class BitReference; // Assignable proxy for one flag
+    template <bool Const>
+    class BasicIterator; // Random access iterator over the flags
+    typedef BasicIterator<false> SimpleVectorIterator; // Iterator yielding BitReference proxies
+    typedef BasicIterator<true> ConstSimpleVectorIterator; // Iterator yielding bool values
+
+    typedef bool value_type; // Define the element type
+    typedef BitReference reference; // Define the reference type
+    typedef bool const_reference; // Define the const reference type
+
+    SimpleVector(); // Default constructor, allocates nothing
+    SimpleVector(size_t initialCapacity); // Constructor with initial capacity in flags
+    SimpleVector(const SimpleVector& other); // Copy constructor
+    SimpleVector(SimpleVector&& other) noexcept; // Move constructor
+    template <unsigned int N>
+    SimpleVector(SmallSimpleVector<bool, N, LockPolicy, GrowthPolicy>&& other); // Move from a SmallSimpleVector, may allocate
+    SimpleVector(std::initializer_list<bool> initList); // Constructor with initializer list
+
+    SimpleVector& operator=(const SimpleVector& other); // Copy assignment operator
+    SimpleVector& operator=(SimpleVector&& other) noexcept; // Move assignment operator
+    template <unsigned int N>
+    SimpleVector& operator=(SmallSimpleVector<bool, N, LockPolicy, GrowthPolicy>&& other); // Move-assign from a SmallSimpleVector, may allocate
+
+    void releaseMemory(); // Release the memory used by the array
+    bool shrinkToFit(); // Shrink the word array to the flags in use
+    void clear(); // Remove all flags, keeping the capacity
+    void push_back(bool item); // Add a flag
+    void put(bool item); // Add a flag
+    template<typename... Args>
+    void bulk_add(Args&&... args); // Add multiple flags
+    BitReference emplace_back(bool item); // Add a flag and return a proxy for it
+    void reserve(size_t n); // Make room for at least n flags
+    void append(const bool* first, size_t n); // Add n flags copied from an array
+    template<typename InputIt>
+    void append(InputIt first, InputIt last); // Add the flags of the range [first, last)
+    BitReference back(); // Get the last flag
+    BitReference front(); // Get the first flag
+    void remove(bool item); // Remove every flag equal to item
+    BitReference operator[](size_t index); // Access a flag of a non-const vector
+    bool operator[](size_t index) const; // Read a flag of a const vector
+    BitReference at_unchecked(size_t index); // Access a flag without locking or bounds checking
+    bool at_unchecked(size_t index) const; // Read a flag without locking or bounds checking
+    BitReference get(size_t index); // Access the flag at the specified index
+    size_t size() const; // Get the capacity in flags
+    size_t elements() const; // Get the number of flags
+    bool isEmpty() const; // Check if the vector is empty
+    ptrdiff_t indexOf(bool element) const; // Get the index of the first flag equal to element, or -1
+    bool contains(bool element) const; // Check if any flag equals element
+    size_t count(bool element) const; // Count the flags equal to element
+
+    size_t popcount() const; // Count the set flags
+    ptrdiff_t findFirstSet() const; // Get the index of the first set flag, or -1
+    ptrdiff_t findNextSet(size_t index) const; // Get the index of the first set flag after index, or -1
+    void flip(); // Invert every flag
+    SimpleVector& operator&=(const SimpleVector& other); // Keep the flags set in both vectors
+    SimpleVector& operator|=(const SimpleVector& other); // Set the flags set in either vector
+    SimpleVector& operator^=(const SimpleVector& other); // Set the flags set in exactly one vector
+    const Word* wordData() const; // Get a pointer to the packed words
+    size_t wordCount() const; // Get the number of words in use
+    SimpleVectorStats stats() const; // Get the allocation counters of the word array
+    void resetStats(); // Reset the allocation counters
+
+    friend SimpleVector operator&(SimpleVector lhs, const SimpleVector& rhs) { return std::move(lhs &= rhs); }
+    friend SimpleVector operator|(SimpleVector lhs, const SimpleVector& rhs) { return std::move(lhs |= rhs); }
+    friend SimpleVector operator^(SimpleVector lhs, const SimpleVector& rhs) { return std::move(lhs ^= rhs); }
+
+    SimpleVectorIterator begin(); // Get an iterator pointing to the first flag
+    SimpleVectorIterator end(); // Get an iterator pointing to one past the last flag
+    ConstSimpleVectorIterator begin() const; // Get a const iterator pointing to the first flag
+    ConstSimpleVectorIterator end() const; // Get a const iterator pointing to one past the last flag
+    ConstSimpleVectorIterator cbegin() const; // Get a const iterator pointing to the first flag
+    ConstSimpleVectorIterator cend() const; // Get a const iterator pointing to one past the last flag
+
+    typedef SimpleVectorIterator iterator; // Define the iterator type
+    typedef ConstSimpleVectorIterator const_iterator; // Define the const iterator type
+};
+
+//==============================================================================|
+
+/**
+ * @brief Proxy for one flag of a packed SimpleVector<bool>.
+ */
+template <typename LockPolicy, typename GrowthPolicy>
+class SimpleVector<bool, LockPolicy, GrowthPolicy>::BitReference {
+private:
+    Word* word;
+    Word mask;
+
+public:
+    BitReference(Word* flagWord, Word flagMask) : word(flagWord), mask(flagMask) {}
+
+    operator bool() const { return (*word & mask) != 0; }
+
+    BitReference& operator=(bool value) {
+        if (value) {
+            *word |= mask;
+        } else {
+            *word &= ~mask;
+        }
+        return *this;
+    }
+
+    BitReference& operator=(const BitReference& other) { return *this = static_cast<bool>(other); }
+
+    bool operator~() const { return (*word & mask) == 0; }
+
+    void flip() { *word ^= mask; }
+};
+
+/**
+ * @brief Random access iterator over the flags of a packed SimpleVector<bool>.
+ *
+ * @details The mutable iterator yields BitReference proxies and the const iterator yields bool values,
+ * so the iterators satisfy the random access requirements but are not contiguous.
+ *
+ * @tparam Const True for the const iterator.
+ */
+template <typename LockPolicy, typename GrowthPolicy>
+template <bool Const>
+class SimpleVector<bool, LockPolicy, GrowthPolicy>::BasicIterator {
+    template <bool>
+    friend class BasicIterator;
+
+    typedef typename std::conditional<Const, const Word*, Word*>::type WordPointer;
+
+    WordPointer words;
+    size_t index;
+
+public:
+    typedef std::random_access_iterator_tag iterator_category;
+    typedef bool value_type;
+    typedef ptrdiff_t difference_type;
+    typedef typename std::conditional<Const, bool, BitReference>::type reference;
+    typedef void pointer;
+
+    BasicIterator() : words(nullptr), index(0) {}
+    BasicIterator(WordPointer start, size_t position) : words(start), index(position) {}
+
+    // A mutable iterator converts to a const iterator, but not the other way around.
+    template <bool OtherConst, typename = typename std::enable_if<Const && !OtherConst>::type>
+    BasicIterator(const BasicIterator<OtherConst>& other) : words(other.words), index(other.index) {}
+
+    reference operator*() const {
+        if constexpr (Const) {
+            return (words[index / WORD_BITS] & maskOf(index)) != 0;
+        } else {
+            return BitReference(words + index / WORD_BITS, maskOf(index));
+        }
+    }
+
+    reference operator[](difference_type offset) const { return *(*this + offset); }
+
+    BasicIterator& operator++() { ++index; return *this; }
+    BasicIterator operator++(int) { BasicIterator previous = *this; ++index; return previous; }
+    BasicIterator& operator--() { --index; return *this; }
+    BasicIterator operator--(int) { BasicIterator previous = *this; --index; return previous; }
+    BasicIterator& operator+=(difference_type offset) { index += offset; return *this; }
+    BasicIterator& operator-=(difference_type offset) { index -= offset; return *this; }
+
+    friend BasicIterator operator+(BasicIterator it, difference_type offset) { return it += offset; }
+    friend BasicIterator operator+(difference_type offset, BasicIterator it) { return it += offset; }
+    friend BasicIterator operator-(BasicIterator it, difference_type offset) { return it -= offset; }
+    friend difference_type operator-(const BasicIterator& lhs, const BasicIterator& rhs) {
+        return static_cast<difference_type>(lhs.index) - static_cast<difference_type>(rhs.index);
+    }
+
+    friend bool operator==(const BasicIterator& lhs, const BasicIterator& rhs) { return lhs.index == rhs.index; }
+    friend bool operator!=(const BasicIterator& lhs, const BasicIterator& rhs) { return lhs.index != rhs.index; }
+    friend bool operator<(const BasicIterator& lhs, const BasicIterator& rhs) { return lhs.index < rhs.index; }
+    friend bool operator>(const BasicIterator& lhs, const BasicIterator& rhs) { return lhs.index > rhs.index; }
+    friend bool operator<=(const BasicIterator& lhs, const BasicIterator& rhs) { return lhs.index <= rhs.index; }
+    friend bool operator>=(const BasicIterator& lhs, const BasicIterator& rhs) { return lhs.index >= rhs.index; }
+};
+
+//==============================================================================|
+
+/**
+ * @brief Constructs an empty packed vector. No memory is allocated until the first flag is added.
+ */
+template <typename LockPolicy, typename GrowthPolicy>
+SimpleVector<bool, LockPolicy, GrowthPolicy>::SimpleVector() : words(), elementCount(0) {
+}
+
+/**
+ * @brief Constructs an empty packed vector with room for the specified number of flags.
+ *
+ * @param initialCapacity The number of flags to make room for.
+ *
+ * @throw SimpleVectorException if the initial capacity is 0.
+ */
+template <typename LockPolicy, typename GrowthPolicy>
+SimpleVector<bool, LockPolicy, GrowthPolicy>::SimpleVector(size_t initialCapacity) : words(), elementCount(0) {
+    if (initialCapacity == 0) {
+        throw SimpleVectorException("Initial capacity must be greater than 0.");
+    }
+    reserveUnlocked(initialCapacity);
+}
+
+/**
+ * @brief Constructs a packed vector by copying another one.
+ *
+ * @param other The vector to copy.
+ */
+template <typename LockPolicy, typename GrowthPolicy>
+SimpleVector<bool, LockPolicy, GrowthPolicy>::SimpleVector(const SimpleVector& other) : words(), elementCount(0) {
+    copyFrom(other);
+}
+
+/**
+ * @brief Constructs a packed vector by taking over the words of another one.
+ *
+ * @details A SmallSimpleVector is moved by the constructor below instead, since its inline words need a heap array here.
+ *
+ * @param other The vector to move from. It is left empty.
+ */
+template <typename LockPolicy, typename GrowthPolicy>
+SimpleVector<bool, LockPolicy, GrowthPolicy>::SimpleVector(SimpleVector&& other) noexcept : words(), elementCount(0) {
+    moveFrom(other);
+}
+
+/**
+ * @brief Constructs a packed vector by taking over the words of a SmallSimpleVector.
+ *
+ * @param other The vector to move from. It is left empty.
+ * @throw std::bad_alloc if its inline words cannot be moved to the heap.
+ */
+template <typename LockPolicy, typename GrowthPolicy>
+template <unsigned int N>
+SimpleVector<bool, LockPolicy, GrowthPolicy>::SimpleVector(SmallSimpleVector<bool, N, LockPolicy, GrowthPolicy>&& other) : words(), elementCount(0) {
+    moveFrom(other);
+}
+
+/**
+ * @brief Constructs a packed vector from an initializer list.
+ *
+ * @param initList The flags to start with.
+ *
+ * @throw SimpleVectorException if the initializer list is empty.
+ */
+template <typename LockPolicy, typename GrowthPolicy>
+SimpleVector<bool, LockPolicy, GrowthPolicy>::SimpleVector(std::initializer_list<bool> initList) : words(), elementCount(0) {
+    if (initList.size() == 0) {
+        throw SimpleVectorException("Initializer list must not be empty.");
+    }
+    reserveUnlocked(initList.size());
+    for (bool value : initList) {
+        pushUnlocked(value);
+    }
+}
+
+/**
+ * @brief Constructs an empty packed vector that stores its first words in caller-supplied inline storage.
+ *
+ * @param buffer Storage for at least bufferWords words. It must outlive this object.
+ * @param bufferWords The number of words the buffer can hold.
+ */
+template <typename LockPolicy, typename GrowthPolicy>
+SimpleVector<bool, LockPolicy, GrowthPolicy>::SimpleVector(Word* buffer, size_t bufferWords) : words(buffer, bufferWords), elementCount(0) {
+}
+
+/**
+ * @brief Copy the flags of another vector into this empty vector. The other vector is read-locked meanwhile.
+ */
+template <typename LockPolicy, typename GrowthPolicy>
+void SimpleVector<bool, LockPolicy, GrowthPolicy>::copyFrom(const SimpleVector& other) {
+    ReadLock otherLock(other.lockPolicy); // Hold the source steady while it is copied
+    words.copyFrom(other.words);
+    elementCount = other.elementCount;
+}
+
+/**
+ * @brief Take over the flags of another vector. This vector must be empty; the other vector is write-locked and left empty.
+ */
+template <typename LockPolicy, typename GrowthPolicy>
+void SimpleVector<bool, LockPolicy, GrowthPolicy>::moveFrom(SimpleVector& other) {
+    WriteLock otherLock(other.lockPolicy); // The source is modified, so take its exclusive lock
+    words.moveFrom(other.words);
+    elementCount = other.elementCount;
+    other.elementCount = 0;
+}
+
+/**
+ * @brief Replace the flags with those of another vector. Only this vector is locked, so other must be a temporary.
+ */
+template <typename LockPolicy, typename GrowthPolicy>
+void SimpleVector<bool, LockPolicy, GrowthPolicy>::replaceStorage(SimpleVector& other) {
+    WriteLock lock(lockPolicy); // Lock for thread-safety
+    releaseStorage();
+    words.moveFrom(other.words);
+    elementCount = other.elementCount;
+    other.elementCount = 0;
+}
+
+/**
+ * @brief Drop all flags and free any heap storage, falling back to the inline words if there are any.
+ */
+template <typename LockPolicy, typename GrowthPolicy>
+void SimpleVector<bool, LockPolicy, GrowthPolicy>::releaseStorage() {
+    words.releaseStorage();
+    elementCount = 0;
+}
+
+/**
+ * @brief Check if the words live in the inline storage supplied by SmallSimpleVector.
+ */
+template <typename LockPolicy, typename GrowthPolicy>
+bool SimpleVector<bool, LockPolicy, GrowthPolicy>::storageIsInline() const {
+    ReadLock lock(lockPolicy); // Lock for thread-safety
+    return words.storageIsInline();
+}
+
+/**
+ * @brief Replaces the contents of this vector with a copy of another vector.
+ *
+ * @param other The vector to copy.
+ * @return Reference to this vector.
+ */
+template <typename LockPolicy, typename GrowthPolicy>
+SimpleVector<bool, LockPolicy, GrowthPolicy>& SimpleVector<bool, LockPolicy, GrowthPolicy>::operator=(const SimpleVector& other) {
+    if (this != &other) {
+        SimpleVector copy(other);
+        WriteLock lock(lockPolicy); // Lock for thread-safety
+        releaseStorage();
+        words.moveFrom(copy.words);
+        elementCount = copy.elementCount;
+    }
+    return *this;
+}
+
+/**
+ * @brief Replaces the contents of this vector by taking over the words of another vector.
+ *
+ * @param other The vector to move from. It is left empty.
+ * @return Reference to this vector.
+ */
+template <typename LockPolicy, typename GrowthPolicy>
+SimpleVector<bool, LockPolicy, GrowthPolicy>& SimpleVector<bool, LockPolicy, GrowthPolicy>::operator=(SimpleVector&& other) noexcept {
+    if (this != &other) {
+        SimpleVector moved(std::move(other));
+        replaceStorage(moved);
+    }
+    return *this;
+}
+
+/**
+ * @brief Replaces the contents of this vector by taking over the words of a SmallSimpleVector.
+ *
+ * @param other The vector to move from. It is left empty.
+ * @return Reference to this vector.
+ * @throw std::bad_alloc if its inline words cannot be moved to the heap.
+ */
+template <typename LockPolicy, typename GrowthPolicy>
+template <unsigned int N>
+SimpleVector<bool, LockPolicy, GrowthPolicy>& SimpleVector<bool, LockPolicy, GrowthPolicy>::operator=(SmallSimpleVector<bool, N, LockPolicy, GrowthPolicy>&& other) {
+    SimpleVector moved(std::move(other));
+    replaceStorage(moved);
+    return *this;
+}
+
+/**
+ * @brief Add a flag at the end, appending a cleared word when the last one is full.
+ */
+template <typename LockPolicy, typename GrowthPolicy>
+void SimpleVector<bool, LockPolicy, GrowthPolicy>::pushUnlocked(bool value) {
+    if (elementCount % WORD_BITS == 0) {
+        words.push_back(Word(0));
+    }
+    if (value) {
+        wordPointer()[elementCount / WORD_BITS] |= maskOf(elementCount);
+    }
+    elementCount++;
+}
+
+/**
+ * @brief Make room for at least the specified number of flags.
+ */
+template <typename LockPolicy, typename GrowthPolicy>
+void SimpleVector<bool, LockPolicy, GrowthPolicy>::reserveUnlocked(size_t bits) {
+    words.reserve(wordsFor(bits));
+}
+
+/**
+ * @brief Replace the contents with count copies of value, keeping the capacity.
+ *
+ * @param count The new number of flags. Must not exceed the current number.
+ * @param value The value of every flag.
+ */
+template <typename LockPolicy, typename GrowthPolicy>
+void SimpleVector<bool, LockPolicy, GrowthPolicy>::resetUnlocked(size_t count, bool value) {
+    size_t used = wordsFor(count);
+    words.truncate(used);
+    Word* data = wordPointer();
+    for (size_t i = 0; i < used; i++) {
+        data[i] = value ? ~Word(0) : Word(0);
+    }
+    if (value && count % WORD_BITS != 0) {
+        data[used - 1] = maskOf(count) - 1; // Keep the flags past the end clear
+    }
+    elementCount = count;
+}
+
+/**
+ * @brief Find the first flag equal to value at or after the specified index.
+ *
+ * @details Whole words without a match are skipped with a single comparison. When searching for clear flags the
+ * words are inverted, so the clear padding past the last element could match; such hits are discarded.
+ *
+ * @return The index of the flag, or -1 if there is none.
+ */
+template <typename LockPolicy, typename GrowthPolicy>
+ptrdiff_t SimpleVector<bool, LockPolicy, GrowthPolicy>::findUnlocked(size_t from, bool value) const {
+    if (from >= elementCount) {
+        return -1;
+    }
+    const Word* data = wordPointer();
+    size_t wordIndex = from / WORD_BITS;
+    size_t lastWord = wordsFor(elementCount);
+    Word word = (value ? data[wordIndex] : ~data[wordIndex]) & (~Word(0) << (from % WORD_BITS));
+    while (word == 0) {
+        if (++wordIndex == lastWord) {
+            return -1;
+        }
+        word = value ? data[wordIndex] : ~data[wordIndex];
+    }
+    size_t index = wordIndex * WORD_BITS + BitKernels::countTrailingZeros(word);
+    return index < elementCount ? static_cast<ptrdiff_t>(index) : -1;
+}
+
+/**
+ * @brief Combine the words of another vector of the same length into this one.
+ *
+ * @details The two vectors are always locked in address order, so a &= b and b &= a running on two threads cannot deadlock.
+ *
+ * @throw SimpleVectorException if the vectors have different lengths.
+ */
+template <typename LockPolicy, typename GrowthPolicy>
+template <BitKernels::Operation Op>
+SimpleVector<bool, LockPolicy, GrowthPolicy>& SimpleVector<bool, LockPolicy, GrowthPolicy>::combine(const SimpleVector& other) {
+    if (this == &other) {
+        WriteLock lock(lockPolicy); // Lock for thread-safety
+        if (Op == BitKernels::Xor) {
+            resetUnlocked(elementCount, false);
+        }
+        return *this;
+    }
+
+    std::unique_lock<LockPolicy> writeLock(lockPolicy, std::defer_lock);
+    std::shared_lock<LockPolicy> readLock(other.lockPolicy, std::defer_lock);
+    if (std::less<const void*>()(this, &other)) {
+        writeLock.lock();
+        readLock.lock();
+    } else {
+        readLock.lock();
+        writeLock.lock();
+    }
+    if (elementCount != other.elementCount) {
+        throw SimpleVectorException("Bit vectors must have the same number of elements.");
+    }
+    BitKernels::combine<Op>(wordPointer(), other.wordPointer(), wordsFor(elementCount));
+    return *this;
+}
+
+/**
+ * @brief Release the memory used by the array.
+ */
+template <typename LockPolicy, typename GrowthPolicy>
+void SimpleVector<bool, LockPolicy, GrowthPolicy>::releaseMemory() {
+    WriteLock lock(lockPolicy); // Lock for thread-safety
+    releaseStorage();
+}
+
+/**
+ * @brief Shrink the word array to the flags in use, subject to the growth policy's shrink hysteresis.
+ *
+ * @return True if the array was shrunk, false if it was kept as is.
+ */
+template <typename LockPolicy, typename GrowthPolicy>
+bool SimpleVector<bool, LockPolicy, GrowthPolicy>::shrinkToFit() {
+    WriteLock lock(lockPolicy); // Lock for thread-safety
+    return words.shrinkToFit();
+}
+
+/**
+ * @brief Remove all flags, keeping the capacity.
+ */
+template <typename LockPolicy, typename GrowthPolicy>
+void SimpleVector<bool, LockPolicy, GrowthPolicy>::clear() {
+    WriteLock lock(lockPolicy); // Lock for thread-safety
+    words.clear();
+    elementCount = 0;
+}
+
+/**
+ * @brief Add a flag.
+ *
+ * @param item The flag to be added.
+ */
+template <typename LockPolicy, typename GrowthPolicy>
+void SimpleVector<bool, LockPolicy, GrowthPolicy>::push_back(bool item) {
+    WriteLock lock(lockPolicy); // Lock for thread-safety
+    pushUnlocked(item);
+}
+
+/**
+ * @brief Add a flag.
+ *
+ * @param item The flag to be added.
+ */
+template <typename LockPolicy, typename GrowthPolicy>
+void SimpleVector<bool, LockPolicy, GrowthPolicy>::put(bool item) {
+    WriteLock lock(lockPolicy); // Lock for thread-safety
+    pushUnlocked(item);
+}
+
+/**
+ * @brief Add multiple flags, growing at most once.
+ *
+ * @param args The flags to be added. Each is converted to bool.
+ *
+ * @throw SimpleVectorException if no flags are given.
+ */
+template <typename LockPolicy, typename GrowthPolicy>
+template<typename... Args>
+void SimpleVector<bool, LockPolicy, GrowthPolicy>::bulk_add(Args&&... args) {
+    WriteLock lock(lockPolicy); // Lock for thread-safety
+
+    constexpr size_t argsCount = sizeof...(args);
+    if (argsCount == 0) {
+        throw SimpleVectorException("No elements to add.");
+    }
+    reserveUnlocked(elementCount + argsCount);
+    int dummy[] = { (pushUnlocked(static_cast<bool>(args)), 0)... };
+    (void)dummy; // To avoid unused variable warning
+}
+
+/**
+ * @brief Add a flag and return a proxy for it.
+ *
+ * @param item The flag to be added.
+ * @return Proxy for the new flag.
+ */
+template <typename LockPolicy, typename GrowthPolicy>
+typename SimpleVector<bool, LockPolicy, GrowthPolicy>::BitReference SimpleVector<bool, LockPolicy, GrowthPolicy>::emplace_back(bool item) {
+    WriteLock lock(lockPolicy); // Lock for thread-safety
+    pushUnlocked(item);
+    return BitReference(wordPointer() + (elementCount - 1) / WORD_BITS, maskOf(elementCount - 1));
+}
+
+/**
+ * @brief Make room for at least the specified number of flags. The array is never shrunk.
+ *
+ * @param n The number of flags the vector must be able to hold.
+ */
+template <typename LockPolicy, typename GrowthPolicy>
+void SimpleVector<bool, LockPolicy, GrowthPolicy>::reserve(size_t n) {
+    WriteLock lock(lockPolicy); // Lock for thread-safety
+    reserveUnlocked(n);
+}
+
+/**
+ * @brief Add flags copied from an array of bool.
+ *
+ * @details Once the last word is full, the flags are packed 64 at a time and appended as whole words.
+ *
+ * @param first Pointer to the first flag to copy.
+ * @param n The number of flags to copy.
+ */
+template <typename LockPolicy, typename GrowthPolicy>
+void SimpleVector<bool, LockPolicy, GrowthPolicy>::append(const bool* first, size_t n) {
+    WriteLock lock(lockPolicy); // Lock for thread-safety
+
+    reserveUnlocked(elementCount + n);
+    size_t i = 0;
+    for (; i < n && elementCount % WORD_BITS != 0; i++) {
+        pushUnlocked(first[i]);
+    }
+    for (; i + WORD_BITS <= n; i += WORD_BITS) {
+        Word word = 0;
+        for (size_t bit = 0; bit < WORD_BITS; bit++) {
+            word |= static_cast<Word>(first[i + bit]) << bit;
+        }
+        words.push_back(word);
+        elementCount += WORD_BITS;
+    }
+    for (; i < n; i++) {
+        pushUnlocked(first[i]);
+    }
+}
+
+/**
+ * @brief Add the flags of a range.
+ *
+ * @details Forward ranges are measured first so the word array grows at most once.
+ *
+ * @tparam InputIt The iterator type of the range. Its values are converted to bool.
+ */
+template <typename LockPolicy, typename GrowthPolicy>
+template<typename InputIt>
+void SimpleVector<bool, LockPolicy, GrowthPolicy>::append(InputIt first, InputIt last) {
+    WriteLock lock(lockPolicy); // Lock for thread-safety
+
+    typedef typename std::iterator_traits<InputIt>::iterator_category Category;
+    if constexpr (std::is_base_of<std::forward_iterator_tag, Category>::value) {
+        reserveUnlocked(elementCount + static_cast<size_t>(std::distance(first, last)));
+    }
+    for (; first != last; ++first) {
+        pushUnlocked(static_cast<bool>(*first));
+    }
+}
+
+/**
+ * @brief Get the last flag.
+ *
+ * @throw IndexOutOfBoundsException if the vector is empty.
+ */
+template <typename LockPolicy, typename GrowthPolicy>
+typename SimpleVector<bool, LockPolicy, GrowthPolicy>::BitReference SimpleVector<bool, LockPolicy, GrowthPolicy>::back() {
+    ReadLock lock(lockPolicy); // Shared lock for thread-safety
+    if (elementCount == 0) {
+        throw IndexOutOfBoundsException("Array is empty.");
+    }
+    return BitReference(wordPointer() + (elementCount - 1) / WORD_BITS, maskOf(elementCount - 1));
+}
+
+/**
+ * @brief Get the first flag.
+ *
+ * @throw IndexOutOfBoundsException if the vector is empty.
+ */
+template <typename LockPolicy, typename GrowthPolicy>
+typename SimpleVector<bool, LockPolicy, GrowthPolicy>::BitReference SimpleVector<bool, LockPolicy, GrowthPolicy>::front() {
+    ReadLock lock(lockPolicy); // Shared lock for thread-safety
+    if (elementCount == 0) {
+        throw IndexOutOfBoundsException("Array is empty.");
+    }
+    return BitReference(wordPointer(), maskOf(0));
+}
+
+/**
+ * @brief Remove every flag equal to item.
+ *
+ * @details Only flags of the other value remain, so the result is rebuilt from the popcount in O(n / 64).
+ *
+ * @param item The value to remove.
+ */
+template <typename LockPolicy, typename GrowthPolicy>
+void SimpleVector<bool, LockPolicy, GrowthPolicy>::remove(bool item) {
+    WriteLock lock(lockPolicy); // Lock for thread-safety
+    size_t ones = BitKernels::popcount(wordPointer(), wordsFor(elementCount));
+    resetUnlocked(item ? elementCount - ones : ones, !item);
+}
+
+/**
+ * @brief Access a flag of a non-const vector.
+ *
+ * @param index The index of the flag.
+ * @return Proxy for the flag.
+ *
+ * @throw IndexOutOfBoundsException if the index is out of bounds.
+ */
+template <typename LockPolicy, typename GrowthPolicy>
+typename SimpleVector<bool, LockPolicy, GrowthPolicy>::BitReference SimpleVector<bool, LockPolicy, GrowthPolicy>::operator[](size_t index) {
+    ReadLock lock(lockPolicy); // Shared lock for thread-safety
+    if (index >= elementCount) {
+        throw IndexOutOfBoundsException("Error: Index out of bounds.");
+    }
+    return BitReference(wordPointer() + index / WORD_BITS, maskOf(index));
+}
+
+/**
+ * @brief Read a flag of a const vector.
+ *
+ * @param index The index of the flag.
+ * @return The value of the flag.
+ *
+ * @throw IndexOutOfBoundsException if the index is out of bounds.
+ */
+template <typename LockPolicy, typename GrowthPolicy>
+bool SimpleVector<bool, LockPolicy, GrowthPolicy>::operator[](size_t index) const {
+    ReadLock lock(lockPolicy); // Shared lock for thread-safety
+    if (index >= elementCount) {
+        throw IndexOutOfBoundsException("Error: Index out of bounds.");
+    }
+    return (wordPointer()[index / WORD_BITS] & maskOf(index)) != 0;
+}
+
+/**
+ * @brief Access a flag without locking or bounds checking.
+ */
+template <typename LockPolicy, typename GrowthPolicy>
+typename SimpleVector<bool, LockPolicy, GrowthPolicy>::BitReference SimpleVector<bool, LockPolicy, GrowthPolicy>::at_unchecked(size_t index) {
+    return BitReference(wordPointer() + index / WORD_BITS, maskOf(index));
+}
+
+/**
+ * @brief Read a flag without locking or bounds checking.
+ */
+template <typename LockPolicy, typename GrowthPolicy>
+bool SimpleVector<bool, LockPolicy, GrowthPolicy>::at_unchecked(size_t index) const {
+    return (wordPointer()[index / WORD_BITS] & maskOf(index)) != 0;
+}
+
+/**
+ * @brief Access the flag at the specified index.
+ *
+ * @throw IndexOutOfBoundsException if the index is out of bounds.
+ */
+template <typename LockPolicy, typename GrowthPolicy>
+typename SimpleVector<bool, LockPolicy, GrowthPolicy>::BitReference SimpleVector<bool, LockPolicy, GrowthPolicy>::get(size_t index) {
+    return (*this)[index];
+}
+
+/**
+ * @brief Get the capacity of the vector in flags.
+ */
+template <typename LockPolicy, typename GrowthPolicy>
+size_t SimpleVector<bool, LockPolicy, GrowthPolicy>::size() const {
+    ReadLock lock(lockPolicy); // Shared lock for thread-safety
+    return words.size() * WORD_BITS;
+}
+
+/**
+ * @brief Get the number of flags.
+ */
+template <typename LockPolicy, typename GrowthPolicy>
+size_t SimpleVector<bool, LockPolicy, GrowthPolicy>::elements() const {
+    ReadLock lock(lockPolicy); // Shared lock for thread-safety
+    return elementCount;
+}
+
+/**
+ * @brief Check if the vector is empty.
+ */
+template <typename LockPolicy, typename GrowthPolicy>
+bool SimpleVector<bool, LockPolicy, GrowthPolicy>::isEmpty() const {
+    ReadLock lock(lockPolicy); // Shared lock for thread-safety
+    return elementCount == 0;
+}
+
+/**
+ * @brief Get the index of the first flag equal to element.
+ *
+ * @return The index, or -1 if no flag has that value.
+ */
+template <typename LockPolicy, typename GrowthPolicy>
+ptrdiff_t SimpleVector<bool, LockPolicy, GrowthPolicy>::indexOf(bool element) const {
+    ReadLock lock(lockPolicy); // Shared lock for thread-safety
+    return findUnlocked(0, element);
+}
+
+/**
+ * @brief Check if any flag equals element.
+ */
+template <typename LockPolicy, typename GrowthPolicy>
+bool SimpleVector<bool, LockPolicy, GrowthPolicy>::contains(bool element) const {
+    return indexOf(element) != -1;
+}
+
+/**
+ * @brief Count the flags equal to element.
+ */
+template <typename LockPolicy, typename GrowthPolicy>
+size_t SimpleVector<bool, LockPolicy, GrowthPolicy>::count(bool element) const {
+    ReadLock lock(lockPolicy); // Shared lock for thread-safety
+    size_t ones = BitKernels::popcount(wordPointer(), wordsFor(elementCount));
+    return element ? ones : elementCount - ones;
+}
+
+/**
+ * @brief Count the set flags.
+ */
+template <typename LockPolicy, typename GrowthPolicy>
+size_t SimpleVector<bool, LockPolicy, GrowthPolicy>::popcount() const {
+    return count(true);
+}
+
+/**
+ * @brief Get the index of the first set flag.
+ *
+ * @return The index, or -1 if no flag is set.
+ */
+template <typename LockPolicy, typename GrowthPolicy>
+ptrdiff_t SimpleVector<bool, LockPolicy, GrowthPolicy>::findFirstSet() const {
+    ReadLock lock(lockPolicy); // Shared lock for thread-safety
+    return findUnlocked(0, true);
+}
+
+/**
+ * @brief Get the index of the first set flag after the specified index.
+ *
+ * @details Together with findFirstSet() this visits every set flag:
+ * for (ptrdiff_t i = v.findFirstSet(); i != -1; i = v.findNextSet(i)).
+ *
+ * @param index The index to continue after.
+ * @return The index, or -1 if no later flag is set.
+ */
+template <typename LockPolicy, typename GrowthPolicy>
+ptrdiff_t SimpleVector<bool, LockPolicy, GrowthPolicy>::findNextSet(size_t index) const {
+    ReadLock lock(lockPolicy); // Shared lock for thread-safety
+    return findUnlocked(index + 1, true);
+}
+
+/**
+ * @brief Invert every flag.
+ */
+template <typename LockPolicy, typename GrowthPolicy>
+void SimpleVector<bool, LockPolicy, GrowthPolicy>::flip() {
+    WriteLock lock(lockPolicy); // Lock for thread-safety
+    Word* data = wordPointer();
+    size_t used = wordsFor(elementCount);
+    for (size_t i = 0; i < used; i++) {
+        data[i] = ~data[i];
+    }
+    if (elementCount % WORD_BITS != 0) {
+        data[used - 1] &= maskOf(elementCount) - 1; // Keep the flags past the end clear
+    }
+}
+
+/**
+ * @brief Keep only the flags that are also set in other.
+ *
+ * @throw SimpleVectorException if the vectors have different lengths.
+ */
+template <typename LockPolicy, typename GrowthPolicy>
+SimpleVector<bool, LockPolicy, GrowthPolicy>& SimpleVector<bool, LockPolicy, GrowthPolicy>::operator&=(const SimpleVector& other) {
+    return combine<BitKernels::And>(other);
+}
+
+/**
+ * @brief Also set the flags that are set in other.
+ *
+ * @throw SimpleVectorException if the vectors have different lengths.
+ */
+template <typename LockPolicy, typename GrowthPolicy>
+SimpleVector<bool, LockPolicy, GrowthPolicy>& SimpleVector<bool, LockPolicy, GrowthPolicy>::operator|=(const SimpleVector& other) {
+    return combine<BitKernels::Or>(other);
+}
+
+/**
+ * @brief Toggle the flags that are set in other.
+ *
+ * @throw SimpleVectorException if the vectors have different lengths.
+ */
+template <typename LockPolicy, typename GrowthPolicy>
+SimpleVector<bool, LockPolicy, GrowthPolicy>& SimpleVector<bool, LockPolicy, GrowthPolicy>::operator^=(const SimpleVector& other) {
+    return combine<BitKernels::Xor>(other);
+}
+
+/**
+ * @brief Get a pointer to the packed words, for example to hand them to a custom kernel.
+ *
+ * @details Flag i is bit i % 64 of word i / 64. Bits past the last flag are clear. The pointer is invalidated when the vector grows.
+ */
+template <typename LockPolicy, typename GrowthPolicy>
+const typename SimpleVector<bool, LockPolicy, GrowthPolicy>::Word* SimpleVector<bool, LockPolicy, GrowthPolicy>::wordData() const {
+    ReadLock lock(lockPolicy); // Shared lock for thread-safety
+    return wordPointer();
+}
+
+/**
+ * @brief Get the number of words that hold flags.
+ */
+template <typename LockPolicy, typename GrowthPolicy>
+size_t SimpleVector<bool, LockPolicy, GrowthPolicy>::wordCount() const {
+    ReadLock lock(lockPolicy); // Shared lock for thread-safety
+    return wordsFor(elementCount);
+}
+
+/**
+ * @brief Get the allocation counters of the word array.
+ */
+template <typename LockPolicy, typename GrowthPolicy>
+SimpleVectorStats SimpleVector<bool, LockPolicy, GrowthPolicy>::stats() const {
+    ReadLock lock(lockPolicy); // Shared lock for thread-safety
+    return words.stats();
+}
+
+/**
+ * @brief Reset the allocation counters of the word array.
+ */
+template <typename LockPolicy, typename GrowthPolicy>
+void SimpleVector<bool, LockPolicy, GrowthPolicy>::resetStats() {
+    WriteLock lock(lockPolicy); // Lock for thread-safety
+    words.resetStats();
+}
+
+template <typename LockPolicy, typename GrowthPolicy>
+typename SimpleVector<bool, LockPolicy, GrowthPolicy>::SimpleVectorIterator SimpleVector<bool, LockPolicy, GrowthPolicy>::begin() {
+    return SimpleVectorIterator(wordPointer(), 0);
+}
+
+template <typename LockPolicy, typename GrowthPolicy>
+typename SimpleVector<bool, LockPolicy, GrowthPolicy>::SimpleVectorIterator SimpleVector<bool, LockPolicy, GrowthPolicy>::end() {
+    return SimpleVectorIterator(wordPointer(), elementCount);
+}
+
+template <typename LockPolicy, typename GrowthPolicy>
+typename SimpleVector<bool, LockPolicy, GrowthPolicy>::ConstSimpleVectorIterator SimpleVector<bool, LockPolicy, GrowthPolicy>::begin() const {
+    return ConstSimpleVectorIterator(wordPointer(), 0);
+}
+
+template <typename LockPolicy, typename GrowthPolicy>
+typename SimpleVector<bool, LockPolicy, GrowthPolicy>::ConstSimpleVectorIterator SimpleVector<bool, LockPolicy, GrowthPolicy>::end() const {
+    return ConstSimpleVectorIterator(wordPointer(), elementCount);
+}
+
+template <typename LockPolicy, typename GrowthPolicy>
+typename SimpleVector<bool, LockPolicy, GrowthPolicy>::ConstSimpleVectorIterator SimpleVector<bool, LockPolicy, GrowthPolicy>::cbegin() const {
+    return begin();
+}
+
+template <typename LockPolicy, typename GrowthPolicy>
+typename SimpleVector<bool, LockPolicy, GrowthPolicy>::ConstSimpleVectorIterator SimpleVector<bool, LockPolicy, GrowthPolicy>::cend() const {
+    return end();
+}
+
+#endif // SIMPLEVECTORBOOL_H
@@ -0,0 +1,587 @@
+#ifndef SIMPLEVECTORSIMD_H
+#define SIMPLEVECTORSIMD_H
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include "TypeTraits.h"
+
+// SIMD search and reduction kernels used by SimpleVector for arithmetic element types.
+// Define SIMPLEVECTOR_NO_SIMD to force the scalar loops everywhere.
+
+#if !defined(SIMPLEVECTOR_NO_SIMD) && (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define SIMPLEVECTOR_SIMD_X86 1
+#include <immintrin.h>
+#else
+#define SIMPLEVECTOR_SIMD_X86 0
+#endif
+
+//==============================================================================|
+
+/**
+ * @brief Instruction set detected at runtime.
+ *
+ * @details The CPU is queried once, on first use. Builds that do not target x86 with GCC or Clang always report Scalar.
+ */
+struct SimdSupport {
+    enum Level { Scalar = 0, Sse42 = 1, Avx2 = 2 };
+
+    static Level level() {
+        static const Level detected = detect();
+        return detected;
+    }
+
+private:
+    static Level detect() {
+#if SIMPLEVECTOR_SIMD_X86
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2")) {
+            return Avx2;
+        }
+        if (__builtin_cpu_supports("sse4.2")) {
+            return Sse42;
+        }
+#endif
+        return Scalar;
+    }
+};
+
+/**
+ * @brief Plain loops over an array, used for every element type without a SIMD kernel and as the fallback on old CPUs.
+ *
+ * @details Sums of integers are accumulated in long long and sums of floating point values in double,
+ * so summing a large vector of int or float does not overflow or lose most of its precision.
+ */
+template <typename T>
+struct ScalarKernels {
+    typedef typename std::conditional<std::is_integral<T>::value, long long,
+        typename std::conditional<std::is_floating_point<T>::value, double, T>::type>::type SumType;
+
+    static size_t find(const T* data, size_t n, const T& value) {
+        for (size_t i = 0; i < n; i++) {
+            if (data[i] == value) {
+                return i;
+            }
+        }
+        return n;
+    }
+
+    static size_t count(const T* data, size_t n, const T& value) {
+        size_t matches = 0;
+        for (size_t i = 0; i < n; i++) {
+            if (data[i] == value) {
+                matches++;
+            }
+        }
+        return matches;
+    }
+
+    // min and max expect n >= 1
+    static T min(const T* data, size_t n) {
+        T result = data[0];
+        for (size_t i = 1; i < n; i++) {
+            if (data[i] < result) {
+                result = data[i];
+            }
+        }
+        return result;
+    }
+
+    static T max(const T* data, size_t n) {
+        T result = data[0];
+        for (size_t i = 1; i < n; i++) {
+            if (result < data[i]) {
+                result = data[i];
+            }
+        }
+        return result;
+    }
+
+    static SumType sum(const T* data, size_t n) {
+        SumType total = SumType();
+        for (size_t i = 0; i < n; i++) {
+            total += static_cast<SumType>(data[i]);
+        }
+        return total;
+    }
+};
+
+/**
+ * @brief Kernels used by SimpleVector for elements of type T.
+ *
+ * @details Types that TypeTraits.h marks as arithmetic and that have a vector implementation (int, char, float, double)
+ * are specialized below to dispatch to AVX2 or SSE4.2 at runtime. Everything else uses the scalar loops.
+ */
+template <typename T, bool Arithmetic = is_arithmetic<T>::value>
+struct SimdKernels : ScalarKernels<T> {};
+
+#if SIMPLEVECTOR_SIMD_X86
+
+#define SIMPLEVECTOR_AVX2 __attribute__((target("avx2"), always_inline)) inline
+#define SIMPLEVECTOR_SSE42 __attribute__((target("sse4.2"), always_inline)) inline
+
+// Each Ops struct wraps the intrinsics for one element type and one instruction set, so that the loops
+// in Avx2Loops and Sse42Loops can be written once. eqMask returns one bit per element.
+
+struct Avx2Int32 {
+    typedef int Element;
+    typedef long long Sum;
+    typedef __m256i Reg;
+    typedef __m256i Acc;
+    static const size_t lanes = 8;
+
+    SIMPLEVECTOR_AVX2 static Reg load(const int* p) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)); }
+    SIMPLEVECTOR_AVX2 static Reg set1(int v) { return _mm256_set1_epi32(v); }
+    SIMPLEVECTOR_AVX2 static void store(int* p, Reg r) { _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), r); }
+    SIMPLEVECTOR_AVX2 static unsigned int eqMask(Reg a, Reg b) {
+        return static_cast<unsigned int>(_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(a, b))));
+    }
+    SIMPLEVECTOR_AVX2 static Reg min(Reg a, Reg b) { return _mm256_min_epi32(a, b); }
+    SIMPLEVECTOR_AVX2 static Reg max(Reg a, Reg b) { return _mm256_max_epi32(a, b); }
+    SIMPLEVECTOR_AVX2 static Acc accZero() { return _mm256_setzero_si256(); }
+    SIMPLEVECTOR_AVX2 static Acc accAdd(Acc acc, Reg r) {
+        acc = _mm256_add_epi64(acc, _mm256_cvtepi32_epi64(_mm256_castsi256_si128(r)));
+        return _mm256_add_epi64(acc, _mm256_cvtepi32_epi64(_mm256_extracti128_si256(r, 1)));
+    }
+    SIMPLEVECTOR_AVX2 static Sum accReduce(Acc acc, size_t) {
+        long long parts[4];
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(parts), acc);
+        return parts[0] + parts[1] + parts[2] + parts[3];
+    }
+};
+
+struct Avx2Int8 {
+    typedef char Element;
+    typedef long long Sum;
+    typedef __m256i Reg;
+    typedef __m256i Acc;
+    static const size_t lanes = 32;
+
+    SIMPLEVECTOR_AVX2 static Reg load(const char* p) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)); }
+    SIMPLEVECTOR_AVX2 static Reg set1(char v) { return _mm256_set1_epi8(v); }
+    SIMPLEVECTOR_AVX2 static void store(char* p, Reg r) { _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), r); }
+    SIMPLEVECTOR_AVX2 static unsigned int eqMask(Reg a, Reg b) {
+        return static_cast<unsigned int>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(a, b)));
+    }
+    SIMPLEVECTOR_AVX2 static Reg min(Reg a, Reg b) { return std::is_signed<char>::value ? _mm256_min_epi8(a, b) : _mm256_min_epu8(a, b); }
+    SIMPLEVECTOR_AVX2 static Reg max(Reg a, Reg b) { return std::is_signed<char>::value ? _mm256_max_epi8(a, b) : _mm256_max_epu8(a, b); }
+    SIMPLEVECTOR_AVX2 static Acc accZero() { return _mm256_setzero_si256(); }
+    // Sum of absolute differences against zero adds up groups of 8 unsigned bytes. Signed chars are biased by 128 first.
+    SIMPLEVECTOR_AVX2 static Acc accAdd(Acc acc, Reg r) {
+        if (std::is_signed<char>::value) {
+            r = _mm256_xor_si256(r, _mm256_set1_epi8(static_cast<char>(0x80)));
+        }
+        return _mm256_add_epi64(acc, _mm256_sad_epu8(r, _mm256_setzero_si256()));
+    }
+    SIMPLEVECTOR_AVX2 static Sum accReduce(Acc acc, size_t processed) {
+        long long parts[4];
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(parts), acc);
+        long long total = parts[0] + parts[1] + parts[2] + parts[3];
+        return std::is_signed<char>::value ? total - 128 * static_cast<long long>(processed) : total;
+    }
+};
+
+struct Avx2Float {
+    typedef float Element;
+    typedef double Sum;
+    typedef __m256 Reg;
+    typedef __m256d Acc;
+    static const size_t lanes = 8;
+
+    SIMPLEVECTOR_AVX2 static Reg load(const float* p) { return _mm256_loadu_ps(p); }
+    SIMPLEVECTOR_AVX2 static Reg set1(float v) { return _mm256_set1_ps(v); }
+    SIMPLEVECTOR_AVX2 static void store(float* p, Reg r) { _mm256_storeu_ps(p, r); }
+    SIMPLEVECTOR_AVX2 static unsigned int eqMask(Reg a, Reg b) {
+        return static_cast<unsigned int>(_mm256_movemask_ps(_mm256_cmp_ps(a, b, _CMP_EQ_OQ)));
+    }
+    SIMPLEVECTOR_AVX2 static Reg min(Reg a, Reg b) { return _mm256_min_ps(a, b); }
+    SIMPLEVECTOR_AVX2 static Reg max(Reg a, Reg b) { return _mm256_max_ps(a, b); }
+    SIMPLEVECTOR_AVX2 static Acc accZero() { return _mm256_setzero_pd(); }
+    SIMPLEVECTOR_AVX2 static Acc accAdd(Acc acc, Reg r) {
+        acc = _mm256_add_pd(acc, _mm256_cvtps_pd(_mm256_castps256_ps128(r)));
+        return _mm256_add_pd(acc, _mm256_cvtps_pd(_mm256_extractf128_ps(r, 1)));
+    }
+    SIMPLEVECTOR_AVX2 static Sum accReduce(Acc acc, size_t) {
+        double parts[4];
+        _mm256_storeu_pd(parts, acc);
+        return (parts[0] + parts[1]) + (parts[2] + parts[3]);
+    }
+};
+
+struct Avx2Double {
+    typedef double Element;
+    typedef double Sum;
+    typedef __m256d Reg;
+    typedef __m256d Acc;
+    static const size_t lanes = 4;
+
+    SIMPLEVECTOR_AVX2 static Reg load(const double* p) { return _mm256_loadu_pd(p); }
+    SIMPLEVECTOR_AVX2 static Reg set1(double v) { return _mm256_set1_pd(v); }
+    SIMPLEVECTOR_AVX2 static void store(double* p, Reg r) { _mm256_storeu_pd(p, r); }
+    SIMPLEVECTOR_AVX2 static unsigned int eqMask(Reg a, Reg b) {
+        return static_cast<unsigned int>(_mm256_movemask_pd(_mm256_cmp_pd(a, b, _CMP_EQ_OQ)));
+    }
+    SIMPLEVECTOR_AVX2 static Reg min(Reg a, Reg b) { return _mm256_min_pd(a, b); }
+    SIMPLEVECTOR_AVX2 static Reg max(Reg a, Reg b) { return _mm256_max_pd(a, b); }
+    SIMPLEVECTOR_AVX2 static Acc accZero() { return _mm256_setzero_pd(); }
+    SIMPLEVECTOR_AVX2 static Acc accAdd(Acc acc, Reg r) { return _mm256_add_pd(acc, r); }
+    SIMPLEVECTOR_AVX2 static Sum accReduce(Acc acc, size_t) {
+        double parts[4];
+        _mm256_storeu_pd(parts, acc);
+        return (parts[0] + parts[1]) + (parts[2] + parts[3]);
+    }
+};
+
+struct Sse42Int32 {
+    typedef int Element;
+    typedef long long Sum;
+    typedef __m128i Reg;
+    typedef __m128i Acc;
+    static const size_t lanes = 4;
+
+    SIMPLEVECTOR_SSE42 static Reg load(const int* p) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)); }
+    SIMPLEVECTOR_SSE42 static Reg set1(int v) { return _mm_set1_epi32(v); }
+    SIMPLEVECTOR_SSE42 static void store(int* p, Reg r) { _mm_storeu_si128(reinterpret_cast<__m128i*>(p), r); }
+    SIMPLEVECTOR_SSE42 static unsigned int eqMask(Reg a, Reg b) {
+        return static_cast<unsigned int>(_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(a, b))));
+    }
+    SIMPLEVECTOR_SSE42 static Reg min(Reg a, Reg b) { return _mm_min_epi32(a, b); }
+    SIMPLEVECTOR_SSE42 static Reg max(Reg a, Reg b) { return _mm_max_epi32(a, b); }
+    SIMPLEVECTOR_SSE42 static Acc accZero() { return _mm_setzero_si128(); }
+    SIMPLEVECTOR_SSE42 static Acc accAdd(Acc acc, Reg r) {
+        acc = _mm_add_epi64(acc, _mm_cvtepi32_epi64(r));
+        return _mm_add_epi64(acc, _mm_cvtepi32_epi64(_mm_srli_si128(r, 8)));
+    }
+    SIMPLEVECTOR_SSE42 static Sum accReduce(Acc acc, size_t) {
+        long long parts[2];
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(parts), acc);
+        return parts[0] + parts[1];
+    }
+};
+
+struct Sse42Int8 {
+    typedef char Element;
+    typedef long long Sum;
+    typedef __m128i Reg;
+    typedef __m128i Acc;
+    static const size_t lanes = 16;
+
+    SIMPLEVECTOR_SSE42 static Reg load(const char* p) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)); }
+    SIMPLEVECTOR_SSE42 static Reg set1(char v) { return _mm_set1_epi8(v); }
+    SIMPLEVECTOR_SSE42 static void store(char* p, Reg r) { _mm_storeu_si128(reinterpret_cast<__m128i*>(p), r); }
+    SIMPLEVECTOR_SSE42 static unsigned int eqMask(Reg a, Reg b) {
+        return static_cast<unsigned int>(_mm_movemask_epi8(_mm_cmpeq_epi8(a, b)));
+    }
+    SIMPLEVECTOR_SSE42 static Reg min(Reg a, Reg b) { return std::is_signed<char>::value ? _mm_min_epi8(a, b) : _mm_min_epu8(a, b); }
+    SIMPLEVECTOR_SSE42 static Reg max(Reg a, Reg b) { return std::is_signed<char>::value ? _mm_max_epi8(a, b) : _mm_max_epu8(a, b); }
+    SIMPLEVECTOR_SSE42 static Acc accZero() { return _mm_setzero_si128(); }
+    SIMPLEVECTOR_SSE42 static Acc accAdd(Acc acc, Reg r) {
+        if (std::is_signed<char>::value) {
+            r = _mm_xor_si128(r, _mm_set1_epi8(static_cast<char>(0x80)));
+        }
+        return _mm_add_epi64(acc, _mm_sad_epu8(r, _mm_setzero_si128()));
+    }
+    SIMPLEVECTOR_SSE42 static Sum accReduce(Acc acc, size_t processed) {
+        long long parts[2];
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(parts), acc);
+        long long total = parts[0] + parts[1];
+        return std::is_signed<char>::value ? total - 128 * static_cast<long long>(processed) : total;
+    }
+};
+
+struct Sse42Float {
+    typedef float Element;
+    typedef double Sum;
+    typedef __m128 Reg;
+    typedef __m128d Acc;
+    static const size_t lanes = 4;
+
+    SIMPLEVECTOR_SSE42 static Reg load(const float* p) { return _mm_loadu_ps(p); }
+    SIMPLEVECTOR_SSE42 static Reg set1(float v) { return _mm_set1_ps(v); }
+    SIMPLEVECTOR_SSE42 static void store(float* p, Reg r) { _mm_storeu_ps(p, r); }
+    SIMPLEVECTOR_SSE42 static unsigned int eqMask(Reg a, Reg b) {
+        return static_cast<unsigned int>(_mm_movemask_ps(_mm_cmpeq_ps(a, b)));
+    }
+    SIMPLEVECTOR_SSE42 static Reg min(Reg a, Reg b) { return _mm_min_ps(a, b); }
+    SIMPLEVECTOR_SSE42 static Reg max(Reg a, Reg b) { return _mm_max_ps(a, b); }
+    SIMPLEVECTOR_SSE42 static Acc accZero() { return _mm_setzero_pd(); }
+    SIMPLEVECTOR_SSE42 static Acc accAdd(Acc acc, Reg r) {
+        acc = _mm_add_pd(acc, _mm_cvtps_pd(r));
+        return _mm_add_pd(acc, _mm_cvtps_pd(_mm_movehl_ps(r, r)));
+    }
+    SIMPLEVECTOR_SSE42 static Sum accReduce(Acc acc, size_t) {
+        double parts[2];
+        _mm_storeu_pd(parts, acc);
+        return parts[0] + parts[1];
+    }
+};
+
+struct Sse42Double {
+    typedef double Element;
+    typedef double Sum;
+    typedef __m128d Reg;
+    typedef __m128d Acc;
+    static const size_t lanes = 2;
+
+    SIMPLEVECTOR_SSE42 static Reg load(const double* p) { return _mm_loadu_pd(p); }
+    SIMPLEVECTOR_SSE42 static Reg set1(double v) { return _mm_set1_pd(v); }
+    SIMPLEVECTOR_SSE42 static void store(double* p, Reg r) { _mm_storeu_pd(p, r); }
+    SIMPLEVECTOR_SSE42 static unsigned int eqMask(Reg a, Reg b) {
+        return static_cast<unsigned int>(_mm_movemask_pd(_mm_cmpeq_pd(a, b)));
+    }
+    SIMPLEVECTOR_SSE42 static Reg min(Reg a, Reg b) { return _mm_min_pd(a, b); }
+    SIMPLEVECTOR_SSE42 static Reg max(Reg a, Reg b) { return _mm_max_pd(a, b); }
+    SIMPLEVECTOR_SSE42 static Acc accZero() { return _mm_setzero_pd(); }
+    SIMPLEVECTOR_SSE42 static Acc accAdd(Acc acc, Reg r) { return _mm_add_pd(acc, r); }
+    SIMPLEVECTOR_SSE42 static Sum accReduce(Acc acc, size_t) {
+        double parts[2];
+        _mm_storeu_pd(parts, acc);
+        return parts[0] + parts[1];
+    }
+};
+
+// The loops are identical for both instruction sets; only the target attribute differs, and it has to be on the
+// loop itself so the Ops functions are inlined into it.
+#define SIMPLEVECTOR_SIMD_LOOPS(Name, Target)                                                       \
+struct Name {                                                                                       \
+    template <typename Ops>                                                                         \
+    Target static size_t find(const typename Ops::Element* data, size_t n, typename Ops::Element value) { \
+        typename Ops::Reg needle = Ops::set1(value);                                                \
+        size_t i = 0;                                                                               \
+        for (; i + Ops::lanes <= n; i += Ops::lanes) {                                              \
+            unsigned int mask = Ops::eqMask(Ops::load(data + i), needle);                           \
+            if (mask != 0) {                                                                        \
+                return i + static_cast<size_t>(__builtin_ctz(mask));                                \
+            }                                                                                       \
+        }                                                                                           \
+        for (; i < n; i++) {                                                                        \
+            if (data[i] == value) {                                                                 \
+                return i;                                                                           \
+            }                                                                                       \
+        }                                                                                           \
+        return n;                                                                                   \
+    }                                                                                               \
+                                                                                                    \
+    template <typename Ops>                                                                         \
+    Target static size_t count(const typename Ops::Element* data, size_t n, typename Ops::Element value) { \
+        typename Ops::Reg needle = Ops::set1(value);                                                \
+        size_t matches = 0;                                                                         \
+        size_t i = 0;                                                                               \
+        for (; i + Ops::lanes <= n; i += Ops::lanes) {                                              \
+            matches += static_cast<size_t>(__builtin_popcount(Ops::eqMask(Ops::load(data + i), needle))); \
+        }                                                                                           \
+        for (; i < n; i++) {                                                                        \
+            matches += (data[i] == value) ? 1 : 0;                                                  \
+        }                                                                                           \
+        return matches;                                                                             \
+    }                                                                                               \
+                                                                                                    \
+    template <typename Ops, bool Minimum>                                                           \
+    Target static typename Ops::Element extreme(const typename Ops::Element* data, size_t n) {      \
+        typedef typename Ops::Element Element;                                                      \
+        if (n < Ops::lanes) {                                                                       \
+            return Minimum ? ScalarKernels<Element>::min(data, n) : ScalarKernels<Element>::max(data, n); \
+        }                                                                                           \
+        typename Ops::Reg best = Ops::load(data);                                                   \
+        size_t i = Ops::lanes;                                                                      \
+        for (; i + Ops::lanes <= n; i += Ops::lanes) {                                              \
+            best = Minimum ? Ops::min(best, Ops::load(data + i)) : Ops::max(best, Ops::load(data + i)); \
+        }                                                                                           \
+        Element lanes[Ops::lanes];                                                                  \
+        Ops::store(lanes, best);                                                                    \
+        Element result = Minimum ? ScalarKernels<Element>::min(lanes, Ops::lanes)                   \
+                                 : ScalarKernels<Element>::max(lanes, Ops::lanes);                  \
+        for (; i < n; i++) {                                                                        \
+            if (Minimum ? (data[i] < result) : (result < data[i])) {                                \
+                result = data[i];                                                                   \
+            }                                                                                       \
+        }                                                                                           \
+        return result;                                                                              \
+    }                                                                                               \
+                                                                                                    \
+    template <typename Ops>                                                                         \
+    Target static typename Ops::Sum sum(const typename Ops::Element* data, size_t n) {              \
+        typename Ops::Acc acc = Ops::accZero();                                                     \
+        size_t i = 0;                                                                               \
+        for (; i + Ops::lanes <= n; i += Ops::lanes) {                                              \
+            acc = Ops::accAdd(acc, Ops::load(data + i));                                            \
+        }                                                                                           \
+        typename Ops::Sum total = Ops::accReduce(acc, i);                                           \
+        for (; i < n; i++) {                                                                        \
+            total += static_cast<typename Ops::Sum>(data[i]);                                       \
+        }                                                                                           \
+        return total;                                                                               \
+    }                                                                                               \
+};
+
+SIMPLEVECTOR_SIMD_LOOPS(Avx2Loops, __attribute__((target("avx2"))))
+SIMPLEVECTOR_SIMD_LOOPS(Sse42Loops, __attribute__((target("sse4.2"))))
+
+#undef SIMPLEVECTOR_SIMD_LOOPS
+#undef SIMPLEVECTOR_AVX2
+#undef SIMPLEVECTOR_SSE42
+
+/**
+ * @brief Runtime dispatch between the AVX2, SSE4.2 and scalar implementations.
+ */
+template <typename T, typename Avx2Ops, typename Sse42Ops>
+struct DispatchedKernels {
+    typedef typename ScalarKernels<T>::SumType SumType;
+
+    static size_t find(const T* data, size_t n, const T& value) {
+        switch (SimdSupport::level()) {
+            case SimdSupport::Avx2: return Avx2Loops::template find<Avx2Ops>(data, n, value);
+            case SimdSupport::Sse42: return Sse42Loops::template find<Sse42Ops>(data, n, value);
+            default: return ScalarKernels<T>::find(data, n, value);
+        }
+    }
+
+    static size_t count(const T* data, size_t n, const T& value) {
+        switch (SimdSupport::level()) {
+            case SimdSupport::Avx2: return Avx2Loops::template count<Avx2Ops>(data, n, value);
+            case SimdSupport::Sse42: return Sse42Loops::template count<Sse42Ops>(data, n, value);
+            default: return ScalarKernels<T>::count(data, n, value);
+        }
+    }
+
+    static T min(const T* data, size_t n) {
+        switch (SimdSupport::level()) {
+            case SimdSupport::Avx2: return Avx2Loops::template extreme<Avx2Ops, true>(data, n);
+            case SimdSupport::Sse42: return Sse42Loops::template extreme<Sse42Ops, true>(data, n);
+            default: return ScalarKernels<T>::min(data, n);
+        }
+    }
+
+    static T max(const T* data, size_t n) {
+        switch (SimdSupport::level()) {
+            case SimdSupport::Avx2: return Avx2Loops::template extreme<Avx2Ops, false>(data, n);
+            case SimdSupport::Sse42: return Sse42Loops::template extreme<Sse42Ops, false>(data, n);
+            default: return ScalarKernels<T>::max(data, n);
+        }
+    }
+
+    static SumType sum(const T* data, size_t n) {
+        switch (SimdSupport::level()) {
+            case SimdSupport::Avx2: return Avx2Loops::template sum<Avx2Ops>(data, n);
+            case SimdSupport::Sse42: return Sse42Loops::template sum<Sse42Ops>(data, n);
+            default: return ScalarKernels<T>::sum(data, n);
+        }
+    }
+};
+
+template <>
+struct SimdKernels<int, true> : DispatchedKernels<int, Avx2Int32, Sse42Int32> {};
+
+template <>
+struct SimdKernels<char, true> : DispatchedKernels<char, Avx2Int8, Sse42Int8> {};
+
+template <>
+struct SimdKernels<float, true> : DispatchedKernels<float, Avx2Float, Sse42Float> {};
+
+template <>
+struct SimdKernels<double, true> : DispatchedKernels<double, Avx2Double, Sse42Double> {};
+
+#endif // SIMPLEVECTOR_SIMD_X86
+
+//==============================================================================|
+
+/**
+ * @brief Word-level kernels for the bit-packed SimpleVector<bool>.
+ *
+ * @details Bits are stored 64 to a word. Population counts use the POPCNT instruction when the CPU has it, and the
+ * AND/OR/XOR loops use AVX2 when available. Trailing zero counts compile to BSF/TZCNT with GCC and Clang.
+ * Other compilers and CPUs use portable bit tricks.
+ */
+struct BitKernels {
+    enum Operation { And, Or, Xor };
+
+    static unsigned int popcount(uint64_t word) {
+#if defined(__GNUC__) || defined(__clang__)
+        return static_cast<unsigned int>(__builtin_popcountll(word));
+#else
+        word = word - ((word >> 1) & 0x5555555555555555ull);
+        word = (word & 0x3333333333333333ull) + ((word >> 2) & 0x3333333333333333ull);
+        word = (word + (word >> 4)) & 0x0F0F0F0F0F0F0F0Full;
+        return static_cast<unsigned int>((word * 0x0101010101010101ull) >> 56);
+#endif
+    }
+
+    // Index of the lowest set bit. word must not be 0.
+    static unsigned int countTrailingZeros(uint64_t word) {
+#if defined(__GNUC__) || defined(__clang__)
+        return static_cast<unsigned int>(__builtin_ctzll(word));
+#else
+        unsigned int bit = 0;
+        while ((word & 1) == 0) {
+            word >>= 1;
+            bit++;
+        }
+        return bit;
+#endif
+    }
+
+    static size_t popcount(const uint64_t* words, size_t n) {
+#if SIMPLEVECTOR_SIMD_X86
+        if (hasPopcnt()) {
+            return popcountHardware(words, n);
+        }
+#endif
+        size_t total = 0;
+        for (size_t i = 0; i < n; i++) {
+            total += popcount(words[i]);
+        }
+        return total;
+    }
+
+    template <Operation Op>
+    static void combine(uint64_t* dest, const uint64_t* src, size_t n) {
+        size_t i = 0;
+#if SIMPLEVECTOR_SIMD_X86
+        if (SimdSupport::level() == SimdSupport::Avx2) {
+            i = combineAvx2<Op>(dest, src, n);
+        }
+#endif
+        for (; i < n; i++) {
+            dest[i] = Op == And ? (dest[i] & src[i]) : Op == Or ? (dest[i] | src[i]) : (dest[i] ^ src[i]);
+        }
+    }
+
+private:
+#if SIMPLEVECTOR_SIMD_X86
+    static bool hasPopcnt() {
+        static const bool supported = (__builtin_cpu_init(), __builtin_cpu_supports("popcnt") != 0);
+        return supported;
+    }
+
+    __attribute__((target("popcnt"))) static size_t popcountHardware(const uint64_t* words, size_t n) {
+        // Four independent sums keep several POPCNT instructions in flight.
+        size_t a = 0, b = 0, c = 0, d = 0;
+        size_t i = 0;
+        for (; i + 4 <= n; i += 4) {
+            a += static_cast<size_t>(__builtin_popcountll(words[i]));
+            b += static_cast<size_t>(__builtin_popcountll(words[i + 1]));
+            c += static_cast<size_t>(__builtin_popcountll(words[i + 2]));
+            d += static_cast<size_t>(__builtin_popcountll(words[i + 3]));
+        }
+        for (; i < n; i++) {
+            a += static_cast<size_t>(__builtin_popcountll(words[i]));
+        }
+        return a + b + c + d;
+    }
+
+    // Combines whole 256-bit blocks and returns the number of words processed.
+    template <Operation Op>
+    __attribute__((target("avx2"))) static size_t combineAvx2(uint64_t* dest, const uint64_t* src, size_t n) {
+        size_t i = 0;
+        for (; i + 4 <= n; i += 4) {
+            __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(dest + i));
+            __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+            __m256i r = Op == And ? _mm256_and_si256(a, b) : Op == Or ? _mm256_or_si256(a, b) : _mm256_xor_si256(a, b);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(dest + i), r);
+        }
+        return i;
+    }
+#endif
+};
+
+#endif // SIMPLEVECTORSIMD_H
@@ -0,0 +1,487 @@
+#ifndef STATICSIMPLEVECTOR_H
+#define STATICSIMPLEVECTOR_H
+
+// This header is shared by the desktop SimpleVector.h and the Arduino SimpleVector.cpp. It uses no exceptions,
+// no heap and, on AVR boards, nothing from the C++ standard library.
+#if defined(ARDUINO_ARCH_AVR)
+    #include <Arduino.h>
+    #include <new.h>
+#else
+    #ifdef ARDUINO
+        #include <Arduino.h>
+    #endif
+    #include <cstddef>
+    #include <initializer_list>
+    #include <new>
+    #define STATICSIMPLEVECTOR_HAS_INIT_LIST
+#endif
+
+//==============================================================================|
+
+/**
+ * @brief Result of a StaticSimpleVector operation that can fail.
+ */
+enum class SimpleVectorStatus : unsigned char {
+    Ok, // The operation succeeded
+    Full, // The vector already holds N elements
+    Empty, // The vector holds no elements
+    IndexOutOfBounds // The index is not smaller than the number of elements
+};
+
+/**
+ * @brief A SimpleVector with a fixed capacity of N elements that never touches the heap.
+ *
+ * @details All elements live in storage embedded in the object, so adding and removing elements has a constant,
+ * allocator-free cost, which is what real-time paths such as control loops and interrupt handlers need.
+ * Operations that can fail return a SimpleVectorStatus instead of throwing, and the same source compiles on the
+ * desktop and on Arduino boards, including AVR boards without a C++ standard library.
+ *
+ * operator[] does not check the index, like at_unchecked on SimpleVector; use get/set or at() for checked access.
+ * The vector does no locking; share it between threads or with an interrupt handler only under an external lock.
+ *
+ * @tparam T The type of the elements.
+ * @tparam N The maximum number of elements.
+ */
+template <typename T, size_t N>
+class StaticSimpleVector {
+    static_assert(N > 0, "StaticSimpleVector needs room for at least one element");
+
+private:
+    alignas(T) unsigned char storage[N * sizeof(T)]; // Raw storage for the elements
+    size_t count; // Number of constructed elements
+
+    T* slots() { return reinterpret_cast<T*>(storage); }
+    const T* slots() const { return reinterpret_cast<const T*>(storage); }
+    void destroyFrom(size_t first); // Destroy the elements from first to the end
+
+public:
+    typedef T value_type; // Define the element type
+    typedef T* iterator; // Define the iterator type
+    typedef const T* const_iterator; // Define the const iterator type
+
+    StaticSimpleVector(); // Default constructor
+    StaticSimpleVector(const StaticSimpleVector& other); // Copy constructor
+    StaticSimpleVector(StaticSimpleVector&& other); // Move constructor
+#ifdef STATICSIMPLEVECTOR_HAS_INIT_LIST
+    StaticSimpleVector(std::initializer_list<T> initList); // Constructor with initializer list, keeps the first N values
+#endif
+    ~StaticSimpleVector(); // Destructor
+
+    StaticSimpleVector& operator=(const StaticSimpleVector& other); // Copy assignment operator
+    StaticSimpleVector& operator=(StaticSimpleVector&& other); // Move assignment operator
+
+    SimpleVectorStatus push_back(const T& item); // Add an element
+    SimpleVectorStatus push_back(T&& item); // Add an element by moving it
+    SimpleVectorStatus put(const T& item); // Add an element
+    template<typename... Args>
+    SimpleVectorStatus emplace_back(Args&&... args); // Construct an element in place at the end
+    SimpleVectorStatus pop_back(); // Destroy the last element
+    size_t remove(const T& item); // Remove every element equal to item
+    void clear(); // Destroy all elements
+
+    T& operator[](size_t index); // Access an element without bounds checking
+    const T& operator[](size_t index) const; // Access an element without bounds checking
+    T* at(size_t index); // Get a pointer to an element, or nullptr if the index is out of bounds
+    const T* at(size_t index) const; // Get a pointer to an element, or nullptr if the index is out of bounds
+    SimpleVectorStatus get(size_t index, T& out) const; // Copy an element into out
+    SimpleVectorStatus set(size_t index, const T& item); // Replace an element
+    T* back(); // Get the last element, or nullptr if the vector is empty
+    T* front(); // Get the first element, or nullptr if the vector is empty
+    T* data(); // Get a pointer to the elements
+    const T* data() const; // Get a pointer to the elements
+
+    static constexpr size_t size() { return N; } // Get the capacity of the vector
+    size_t elements() const; // Get the number of elements
+    bool isEmpty() const; // Check if the vector is empty
+    bool isFull() const; // Check if the vector holds N elements
+    ptrdiff_t indexOf(const T& element) const; // Get the index of the specified element, or -1
+    bool contains(const T& element) const; // Check if the vector contains the specified element
+
+    iterator begin(); // Get an iterator pointing to the first element
+    iterator end(); // Get an iterator pointing to one past the last element
+    const_iterator begin() const; // Get a const iterator pointing to the first element
+    const_iterator end() const; // Get a const iterator pointing to one past the last element
+};
+
+//==============================================================================|
+
+/**
+ * @brief Constructs an empty StaticSimpleVector object.
+ */
+template <typename T, size_t N>
+StaticSimpleVector<T, N>::StaticSimpleVector() : count(0) {
+}
+
+/**
+ * @brief Constructs a StaticSimpleVector object by copying another one.
+ *
+ * @param other The StaticSimpleVector object to copy.
+ */
+template <typename T, size_t N>
+StaticSimpleVector<T, N>::StaticSimpleVector(const StaticSimpleVector& other) : count(0) {
+    for (; count < other.count; count++) {
+        new (slots() + count) T(other.slots()[count]);
+    }
+}
+
+/**
+ * @brief Constructs a StaticSimpleVector object by moving the elements of another one.
+ *
+ * @details The elements live inline, so they are moved one by one. The other vector is left empty.
+ *
+ * @param other The StaticSimpleVector object to move from.
+ */
+template <typename T, size_t N>
+StaticSimpleVector<T, N>::StaticSimpleVector(StaticSimpleVector&& other) : count(0) {
+    for (; count < other.count; count++) {
+        new (slots() + count) T(static_cast<T&&>(other.slots()[count]));
+    }
+    other.clear();
+}
+
+#ifdef STATICSIMPLEVECTOR_HAS_INIT_LIST
+/**
+ * @brief Constructs a StaticSimpleVector object from an initializer list.
+ *
+ * @details Values beyond the capacity are ignored; compare elements() with the list size to detect that.
+ *
+ * @param initList The initializer list to initialize the vector with.
+ */
+template <typename T, size_t N>
+StaticSimpleVector<T, N>::StaticSimpleVector(std::initializer_list<T> initList) : count(0) {
+    for (const T& value : initList) {
+        if (push_back(value) != SimpleVectorStatus::Ok) {
+            break;
+        }
+    }
+}
+#endif
+
+/**
+ * @brief Destroys the StaticSimpleVector object and its elements.
+ */
+template <typename T, size_t N>
+StaticSimpleVector<T, N>::~StaticSimpleVector() {
+    destroyFrom(0);
+}
+
+/**
+ * @brief Destroy the elements from first to the end.
+ */
+template <typename T, size_t N>
+void StaticSimpleVector<T, N>::destroyFrom(size_t first) {
+    while (count > first) {
+        slots()[--count].~T();
+    }
+}
+
+/**
+ * @brief Replaces the contents of this vector with a copy of another vector.
+ *
+ * @param other The StaticSimpleVector object to copy.
+ * @return Reference to this vector.
+ */
+template <typename T, size_t N>
+StaticSimpleVector<T, N>& StaticSimpleVector<T, N>::operator=(const StaticSimpleVector& other) {
+    if (this != &other) {
+        destroyFrom(0);
+        for (; count < other.count; count++) {
+            new (slots() + count) T(other.slots()[count]);
+        }
+    }
+    return *this;
+}
+
+/**
+ * @brief Replaces the contents of this vector by moving the elements of another vector.
+ *
+ * @param other The StaticSimpleVector object to move from. It is left empty.
+ * @return Reference to this vector.
+ */
+template <typename T, size_t N>
+StaticSimpleVector<T, N>& StaticSimpleVector<T, N>::operator=(StaticSimpleVector&& other) {
+    if (this != &other) {
+        destroyFrom(0);
+        for (; count < other.count; count++) {
+            new (slots() + count) T(static_cast<T&&>(other.slots()[count]));
+        }
+        other.clear();
+    }
+    return *this;
+}
+
+/**
+ * @brief Add an element.
+ *
+ * @param item The item to be added.
+ * @return SimpleVectorStatus::Full if the vector already holds N elements, otherwise SimpleVectorStatus::Ok.
+ */
+template <typename T, size_t N>
+SimpleVectorStatus StaticSimpleVector<T, N>::push_back(const T& item) {
+    return emplace_back(item);
+}
+
+/**
+ * @brief Add an element by moving it.
+ *
+ * @param item The item to be moved into the vector. It is left untouched if the vector is full.
+ * @return SimpleVectorStatus::Full if the vector already holds N elements, otherwise SimpleVectorStatus::Ok.
+ */
+template <typename T, size_t N>
+SimpleVectorStatus StaticSimpleVector<T, N>::push_back(T&& item) {
+    return emplace_back(static_cast<T&&>(item));
+}
+
+/**
+ * @brief Add an element.
+ *
+ * @param item The item to be added.
+ * @return SimpleVectorStatus::Full if the vector already holds N elements, otherwise SimpleVectorStatus::Ok.
+ */
+template <typename T, size_t N>
+SimpleVectorStatus StaticSimpleVector<T, N>::put(const T& item) {
+    return emplace_back(item);
+}
+
+/**
+ * @brief Construct an element in place at the end.
+ *
+ * @param args The arguments forwarded to the constructor of T.
+ * @return SimpleVectorStatus::Full if the vector already holds N elements, otherwise SimpleVectorStatus::Ok.
+ */
+template <typename T, size_t N>
+template<typename... Args>
+SimpleVectorStatus StaticSimpleVector<T, N>::emplace_back(Args&&... args) {
+    if (count == N) {
+        return SimpleVectorStatus::Full;
+    }
+    new (slots() + count) T(static_cast<Args&&>(args)...);
+    count++;
+    return SimpleVectorStatus::Ok;
+}
+
+/**
+ * @brief Destroy the last element.
+ *
+ * @return SimpleVectorStatus::Empty if there is no element, otherwise SimpleVectorStatus::Ok.
+ */
+template <typename T, size_t N>
+SimpleVectorStatus StaticSimpleVector<T, N>::pop_back() {
+    if (count == 0) {
+        return SimpleVectorStatus::Empty;
+    }
+    destroyFrom(count - 1);
+    return SimpleVectorStatus::Ok;
+}
+
+/**
+ * @brief Remove every element equal to item, keeping the order of the others.
+ *
+ * @param item The item to be removed.
+ * @return The number of elements removed.
+ */
+template <typename T, size_t N>
+size_t StaticSimpleVector<T, N>::remove(const T& item) {
+    T* elements = slots();
+    size_t write = 0;
+    for (size_t read = 0; read < count; read++) {
+        if (elements[read] == item) {
+            continue;
+        }
+        if (write != read) {
+            elements[write] = static_cast<T&&>(elements[read]);
+        }
+        write++;
+    }
+    size_t removed = count - write;
+    destroyFrom(write);
+    return removed;
+}
+
+/**
+ * @brief Destroy all elements.
+ */
+template <typename T, size_t N>
+void StaticSimpleVector<T, N>::clear() {
+    destroyFrom(0);
+}
+
+/**
+ * @brief Access an element without bounds checking.
+ *
+ * @param index The index of the element. Must be smaller than elements().
+ */
+template <typename T, size_t N>
+T& StaticSimpleVector<T, N>::operator[](size_t index) {
+    return slots()[index];
+}
+
+/**
+ * @brief Access an element without bounds checking.
+ *
+ * @param index The index of the element. Must be smaller than elements().
+ */
+template <typename T, size_t N>
+const T& StaticSimpleVector<T, N>::operator[](size_t index) const {
+    return slots()[index];
+}
+
+/**
+ * @brief Get a pointer to an element.
+ *
+ * @param index The index of the element.
+ * @return Pointer to the element, or nullptr if the index is out of bounds.
+ */
+template <typename T, size_t N>
+T* StaticSimpleVector<T, N>::at(size_t index) {
+    return index < count ? slots() + index : nullptr;
+}
+
+/**
+ * @brief Get a pointer to an element.
+ *
+ * @param index The index of the element.
+ * @return Pointer to the element, or nullptr if the index is out of bounds.
+ */
+template <typename T, size_t N>
+const T* StaticSimpleVector<T, N>::at(size_t index) const {
+    return index < count ? slots() + index : nullptr;
+}
+
+/**
+ * @brief Copy an element into out.
+ *
+ * @param index The index of the element.
+ * @param out Receives the element. Left untouched if the index is out of bounds.
+ * @return SimpleVectorStatus::IndexOutOfBounds if the index is out of bounds, otherwise SimpleVectorStatus::Ok.
+ */
+template <typename T, size_t N>
+SimpleVectorStatus StaticSimpleVector<T, N>::get(size_t index, T& out) const {
+    if (index >= count) {
+        return SimpleVectorStatus::IndexOutOfBounds;
+    }
+    out = slots()[index];
+    return SimpleVectorStatus::Ok;
+}
+
+/**
+ * @brief Replace an element.
+ *
+ * @param index The index of the element.
+ * @param item The new value.
+ * @return SimpleVectorStatus::IndexOutOfBounds if the index is out of bounds, otherwise SimpleVectorStatus::Ok.
+ */
+template <typename T, size_t N>
+SimpleVectorStatus StaticSimpleVector<T, N>::set(size_t index, const T& item) {
+    if (index >= count) {
+        return SimpleVectorStatus::IndexOutOfBounds;
+    }
+    slots()[index] = item;
+    return SimpleVectorStatus::Ok;
+}
+
+/**
+ * @brief Get the last element.
+ *
+ * @return Pointer to the last element, or nullptr if the vector is empty.
+ */
+template <typename T, size_t N>
+T* StaticSimpleVector<T, N>::back() {
+    return count > 0 ? slots() + count - 1 : nullptr;
+}
+
+/**
+ * @brief Get the first element.
+ *
+ * @return Pointer to the first element, or nullptr if the vector is empty.
+ */
+template <typename T, size_t N>
+T* StaticSimpleVector<T, N>::front() {
+    return count > 0 ? slots() : nullptr;
+}
+
+/**
+ * @brief Get a pointer to the elements. [data(), data() + elements()) is a valid range.
+ */
+template <typename T, size_t N>
+T* StaticSimpleVector<T, N>::data() {
+    return slots();
+}
+
+/**
+ * @brief Get a pointer to the elements. [data(), data() + elements()) is a valid range.
+ */
+template <typename T, size_t N>
+const T* StaticSimpleVector<T, N>::data() const {
+    return slots();
+}
+
+/**
+ * @brief Get the number of elements.
+ */
+template <typename T, size_t N>
+size_t StaticSimpleVector<T, N>::elements() const {
+    return count;
+}
+
+/**
+ * @brief Check if the vector is empty.
+ */
+template <typename T, size_t N>
+bool StaticSimpleVector<T, N>::isEmpty() const {
+    return count == 0;
+}
+
+/**
+ * @brief Check if the vector holds N elements, so that adding another one fails.
+ */
+template <typename T, size_t N>
+bool StaticSimpleVector<T, N>::isFull() const {
+    return count == N;
+}
+
+/**
+ * @brief Get the index of the specified element.
+ *
+ * @param element The element to search for.
+ * @return The index of the first equal element, or -1 if there is none.
+ */
+template <typename T, size_t N>
+ptrdiff_t StaticSimpleVector<T, N>::indexOf(const T& element) const {
+    for (size_t i = 0; i < count; i++) {
+        if (slots()[i] == element) {
+            return static_cast<ptrdiff_t>(i);
+        }
+    }
+    return -1;
+}
+
+/**
+ * @brief Check if the vector contains the specified element.
+ */
+template <typename T, size_t N>
+bool StaticSimpleVector<T, N>::contains(const T& element) const {
+    return indexOf(element) != -1;
+}
+
+template <typename T, size_t N>
+typename StaticSimpleVector<T, N>::iterator StaticSimpleVector<T, N>::begin() {
+    return slots();
+}
+
+template <typename T, size_t N>
+typename StaticSimpleVector<T, N>::iterator StaticSimpleVector<T, N>::end() {
+    return slots() + count;
+}
+
+template <typename T, size_t N>
+typename StaticSimpleVector<T, N>::const_iterator StaticSimpleVector<T, N>::begin() const {
+    return slots();
+}
+
+template <typename T, size_t N>
+typename StaticSimpleVector<T, N>::const_iterator StaticSimpleVector<T, N>::end() const {
+    return slots() + count;
+}
+
+#endif // STATICSIMPLEVECTOR_H
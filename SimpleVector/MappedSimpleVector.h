@@ -0,0 +1,570 @@
+#ifndef MAPPEDSIMPLEVECTOR_H
+#define MAPPEDSIMPLEVECTOR_H
+
+#include "SimpleVector.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+#define SIMPLEVECTOR_HAS_MMAP 1
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+//#define DEBUG
+
+//==============================================================================|
+
+/**
+ * @brief Layout of the first bytes of a MappedSimpleVector file.
+ *
+ * @details The header occupies a full 64-byte block so the elements that follow it start at an offset that suits
+ * any element alignment up to 64. The element count lives in the mapping itself, so reopening a file needs no
+ * parsing at all.
+ */
+struct MappedSimpleVectorHeader {
+    char magic[8]; // "SVMAPPED"
+    uint32_t formatVersion; // Layout version of the file
+    uint32_t elementSize; // sizeof(T) of the writer, checked on open
+    uint64_t count; // Number of elements in use
+    unsigned char reserved[40]; // Pads the header to 64 bytes
+};
+
+//==============================================================================|
+
+/**
+ * @brief A SimpleVector whose elements live in a memory-mapped file.
+ *
+ * @details The file holds a small header followed by the raw element array, exactly as it is laid out in memory.
+ * Opening an existing file maps it and is done: no element is read or converted, pages are faulted in on first access.
+ * The vector grows by extending the file with ftruncate and remapping it (mremap on Linux), doubling the capacity like SimpleVector.
+ *
+ * Changes reach the page cache immediately and the kernel writes them back on its own schedule. Call sync() to make
+ * sure everything written so far is on disk, for example after a batch of updates.
+ *
+ * The element type must be trivially copyable because elements are stored and reloaded as raw bytes. Files are
+ * tied to the machine's layout of T (size, alignment, endianness); the element size is checked when a file is opened.
+ * Pointers and references to elements are invalidated when the vector grows, just like SimpleVector.
+ *
+ * @tparam T The type of the elements.
+ * @tparam LockPolicy The locking policy, see SimpleVector.
+ */
+template <typename T, typename LockPolicy = MutexLockPolicy>
+class MappedSimpleVector {
+    static_assert(std::is_trivially_copyable<T>::value, "MappedSimpleVector stores elements as raw bytes and needs a trivially copyable T");
+    static_assert(alignof(T) <= sizeof(MappedSimpleVectorHeader), "MappedSimpleVector cannot align elements beyond 64 bytes");
+
+private:
+    static constexpr uint32_t FORMAT_VERSION = 1;
+    static constexpr size_t HEADER_SIZE = sizeof(MappedSimpleVectorHeader);
+
+    std::string filePath; // Path of the backing file
+    int fd; // Descriptor of the backing file, -1 once moved from
+    unsigned char* mapping; // Start of the mapped file
+    size_t mappedBytes; // Size of the mapping and of the file
+    mutable LockPolicy lockPolicy; // Locking policy used for synchronization
+
+    typedef std::lock_guard<LockPolicy> WriteLock; // Exclusive lock for methods that modify the vector
+    typedef std::shared_lock<LockPolicy> ReadLock; // Shared lock for read-only methods
+
+    // The private helpers below expect the caller to already hold the write lock.
+    MappedSimpleVectorHeader* header() const { return reinterpret_cast<MappedSimpleVectorHeader*>(mapping); }
+    T* array() const { return reinterpret_cast<T*>(mapping + HEADER_SIZE); }
+    size_t capacityUnlocked() const { return (mappedBytes - HEADER_SIZE) / sizeof(T); }
+    void remap(size_t newCapacity); // Resize the file and the mapping to hold newCapacity elements
+    void ensureCapacity(size_t needed); // Grow to at least needed elements, doubling the capacity
+    void close() noexcept; // Unmap and close the file
+    [[noreturn]] void fail(const std::string& what); // Release everything acquired so far and throw with errno's description
+
+public:
+    typedef T value_type; // Define the element type
+    typedef T& reference; // Define the reference type
+    typedef const T& const_reference; // Define the const reference type
+    typedef T* iterator; // Elements are contiguous, so plain pointers are the iterators
+    typedef const T* const_iterator; // Define the const iterator type
+
+    explicit MappedSimpleVector(const std::string& path, size_t initialCapacity = 4); // Open the file at path, creating it if needed
+    MappedSimpleVector(MappedSimpleVector&& other) noexcept; // Move constructor
+    MappedSimpleVector& operator=(MappedSimpleVector&& other) noexcept; // Move assignment operator
+    MappedSimpleVector(const MappedSimpleVector&) = delete;
+    MappedSimpleVector& operator=(const MappedSimpleVector&) = delete;
+    ~MappedSimpleVector(); // Destructor
+
+    void sync(bool wait = true); // Flush the elements written so far to disk
+    const std::string& path() const { return filePath; } // Get the path of the backing file
+
+    void push_back(const T& item); // Add an element to the array
+    void reserve(size_t n); // Make room for at least n elements
+    void append(const T* first, size_t n); // Add n elements copied from an array
+    void remove(const T& item); // Remove every element equal to item
+    void clear(); // Remove all elements, keeping the file size
+    bool shrinkToFit(); // Truncate the file to the elements in use
+    T& back(); // Get the last element in the array
+    T& front(); // Get the first element in the array
+    T& operator[](size_t index); // Overload the subscript operator for non-const objects
+    const T& operator[](size_t index) const; // Overload the subscript operator for const objects
+    T& at_unchecked(size_t index) { return array()[index]; } // Get the element at the specified index without locking or bounds checking
+    const T& at_unchecked(size_t index) const { return array()[index]; } // Get the element at the specified index without locking or bounds checking
+    T* data(); // Get a pointer to the underlying array
+    const T* data() const; // Get a pointer to the underlying array
+    size_t size() const; // Get the capacity, like SimpleVector::size()
+    size_t elements() const; // Get the number of elements in the array
+    size_t capacity() const; // Get the number of elements the file can hold without growing
+    bool isEmpty() const; // Check if the array is empty
+    ptrdiff_t indexOf(const T& element) const; // Get the index of the specified element, or -1
+    bool contains(const T& element) const; // Check if the array contains the specified element
+    size_t count(const T& element) const; // Count the elements equal to the specified element
+
+    iterator begin() { return array(); } // Get an iterator pointing to the first element in the array
+    iterator end() { return array() + header()->count; } // Get an iterator pointing to one past the last element in the array
+    const_iterator begin() const { return array(); } // Get a const iterator pointing to the first element in the array
+    const_iterator end() const { return array() + header()->count; } // Get a const iterator pointing to one past the last element in the array
+};
+
+//==============================================================================|
+
+/**
+ * @brief Opens a MappedSimpleVector backed by the file at path.
+ *
+ * @details An existing file is mapped as is and keeps its elements. A missing or empty file is created with room for
+ * initialCapacity elements.
+ *
+ * @param path The file that stores the elements.
+ * @param initialCapacity The capacity of a newly created file.
+ *
+ * @throw SimpleVectorException if the file cannot be opened or mapped, or was not written by a MappedSimpleVector of the same element size.
+ */
+template <typename T, typename LockPolicy>
+MappedSimpleVector<T, LockPolicy>::MappedSimpleVector(const std::string& path, size_t initialCapacity)
+    : filePath(path), fd(-1), mapping(nullptr), mappedBytes(0) {
+    fd = ::open(path.c_str(), O_RDWR | O_CREAT, 0644);
+    if (fd < 0) {
+        fail("Cannot open " + path);
+    }
+    struct stat info;
+    if (::fstat(fd, &info) != 0) {
+        fail("Cannot stat " + path);
+    }
+
+    bool created = info.st_size == 0;
+    size_t bytes = static_cast<size_t>(info.st_size);
+    if (created) {
+        bytes = HEADER_SIZE + (initialCapacity > 0 ? initialCapacity : 1) * sizeof(T);
+        if (::ftruncate(fd, static_cast<off_t>(bytes)) != 0) {
+            fail("Cannot size " + path);
+        }
+    } else if (bytes < HEADER_SIZE) {
+        close();
+        throw SimpleVectorException(path + " is not a MappedSimpleVector file.");
+    }
+
+    void* address = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (address == MAP_FAILED) {
+        fail("Cannot map " + path);
+    }
+    mapping = static_cast<unsigned char*>(address);
+    mappedBytes = bytes;
+
+    MappedSimpleVectorHeader* head = header();
+    if (created) {
+        std::memcpy(head->magic, "SVMAPPED", sizeof(head->magic));
+        head->formatVersion = FORMAT_VERSION;
+        head->elementSize = static_cast<uint32_t>(sizeof(T));
+        head->count = 0;
+    } else if (std::memcmp(head->magic, "SVMAPPED", sizeof(head->magic)) != 0 || head->formatVersion != FORMAT_VERSION) {
+        close();
+        throw SimpleVectorException(path + " is not a MappedSimpleVector file.");
+    } else if (head->elementSize != sizeof(T)) {
+        close();
+        throw SimpleVectorException(path + " was written with a different element size.");
+    } else if (head->count > capacityUnlocked()) {
+        close();
+        throw SimpleVectorException(path + " is truncated.");
+    }
+    #ifdef DEBUG
+    std::cout << "Mapped " << path << " with " << head->count << " elements" << std::endl;
+    #endif
+}
+
+/**
+ * @brief Constructs a MappedSimpleVector object by taking over the file of another one.
+ *
+ * @param other The vector to move from. It no longer refers to any file.
+ */
+template <typename T, typename LockPolicy>
+MappedSimpleVector<T, LockPolicy>::MappedSimpleVector(MappedSimpleVector&& other) noexcept
+    : filePath(std::move(other.filePath)), fd(other.fd), mapping(other.mapping), mappedBytes(other.mappedBytes) {
+    other.fd = -1;
+    other.mapping = nullptr;
+    other.mappedBytes = 0;
+}
+
+/**
+ * @brief Closes this vector's file and takes over the file of another one.
+ *
+ * @param other The vector to move from. It no longer refers to any file.
+ * @return Reference to this vector.
+ */
+template <typename T, typename LockPolicy>
+MappedSimpleVector<T, LockPolicy>& MappedSimpleVector<T, LockPolicy>::operator=(MappedSimpleVector&& other) noexcept {
+    if (this != &other) {
+        close();
+        filePath = std::move(other.filePath);
+        fd = other.fd;
+        mapping = other.mapping;
+        mappedBytes = other.mappedBytes;
+        other.fd = -1;
+        other.mapping = nullptr;
+        other.mappedBytes = 0;
+    }
+    return *this;
+}
+
+/**
+ * @brief Unmaps and closes the file.
+ *
+ * @details The data stays in the page cache and is written back by the kernel; call sync() first when it must be on disk now.
+ */
+template <typename T, typename LockPolicy>
+MappedSimpleVector<T, LockPolicy>::~MappedSimpleVector() {
+    close();
+}
+
+template <typename T, typename LockPolicy>
+void MappedSimpleVector<T, LockPolicy>::close() noexcept {
+    if (mapping != nullptr) {
+        ::munmap(mapping, mappedBytes);
+        mapping = nullptr;
+        mappedBytes = 0;
+    }
+    if (fd >= 0) {
+        ::close(fd);
+        fd = -1;
+    }
+}
+
+template <typename T, typename LockPolicy>
+void MappedSimpleVector<T, LockPolicy>::fail(const std::string& what) {
+    std::string reason = std::strerror(errno);
+    close();
+    throw SimpleVectorException(what + ": " + reason);
+}
+
+/**
+ * @brief Resize the file and the mapping to hold newCapacity elements.
+ *
+ * @details The file is extended or truncated first, then the mapping follows. Linux moves the mapping with mremap;
+ * other systems map the file again.
+ *
+ * @param newCapacity The number of elements the file should hold. Must not be less than the current count.
+ *
+ * @throw SimpleVectorException if the file cannot be resized or remapped. The vector is unchanged in that case.
+ */
+template <typename T, typename LockPolicy>
+void MappedSimpleVector<T, LockPolicy>::remap(size_t newCapacity) {
+    if (newCapacity > (std::numeric_limits<size_t>::max() - HEADER_SIZE) / sizeof(T)) {
+        throw SimpleVectorException("Requested capacity exceeds the maximum size.");
+    }
+    size_t newBytes = HEADER_SIZE + newCapacity * sizeof(T);
+    if (newBytes > mappedBytes && ::ftruncate(fd, static_cast<off_t>(newBytes)) != 0) {
+        throw SimpleVectorException(std::string("Cannot grow ") + filePath + ": " + std::strerror(errno));
+    }
+
+    #ifdef __linux__
+    void* address = ::mremap(mapping, mappedBytes, newBytes, MREMAP_MAYMOVE);
+    #else
+    void* address = ::mmap(nullptr, newBytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    #endif
+    if (address == MAP_FAILED) {
+        std::string reason = std::strerror(errno);
+        if (newBytes > mappedBytes) {
+            // Give back the space that was added for nothing; the old mapping is still intact.
+            (void)::ftruncate(fd, static_cast<off_t>(mappedBytes));
+        }
+        throw SimpleVectorException("Cannot remap " + filePath + ": " + reason);
+    }
+    #ifndef __linux__
+    ::munmap(mapping, mappedBytes);
+    #endif
+
+    mapping = static_cast<unsigned char*>(address);
+    if (newBytes < mappedBytes) {
+        (void)::ftruncate(fd, static_cast<off_t>(newBytes));
+    }
+    mappedBytes = newBytes;
+    #ifdef DEBUG
+    std::cout << "Remapped " << filePath << " to " << newCapacity << " elements" << std::endl;
+    #endif
+}
+
+template <typename T, typename LockPolicy>
+void MappedSimpleVector<T, LockPolicy>::ensureCapacity(size_t needed) {
+    size_t capacity = capacityUnlocked();
+    if (needed <= capacity) {
+        return;
+    }
+    size_t doubled = capacity > std::numeric_limits<size_t>::max() / 2 ? needed : capacity * 2;
+    remap(doubled > needed ? doubled : needed);
+}
+
+/**
+ * @brief Flush the elements written so far to disk.
+ *
+ * @param wait If true, return only once the data is on disk. If false, just schedule the write-back.
+ *
+ * @throw SimpleVectorException if msync fails.
+ */
+template <typename T, typename LockPolicy>
+void MappedSimpleVector<T, LockPolicy>::sync(bool wait) {
+    ReadLock lock(lockPolicy);
+    if (::msync(mapping, mappedBytes, wait ? MS_SYNC : MS_ASYNC) != 0) {
+        throw SimpleVectorException(std::string("Cannot sync ") + filePath + ": " + std::strerror(errno));
+    }
+}
+
+/**
+ * @brief Add an element to the end of the array, growing the file if needed.
+ *
+ * @param item The item to be added.
+ */
+template <typename T, typename LockPolicy>
+void MappedSimpleVector<T, LockPolicy>::push_back(const T& item) {
+    WriteLock lock(lockPolicy);
+    uint64_t count = header()->count;
+    if (count == capacityUnlocked()) {
+        T copy = item; // item may live in the mapping that is about to move
+        ensureCapacity(count + 1);
+        std::memcpy(static_cast<void*>(array() + count), &copy, sizeof(T));
+    } else {
+        std::memcpy(static_cast<void*>(array() + count), &item, sizeof(T));
+    }
+    header()->count = count + 1;
+}
+
+/**
+ * @brief Make room for at least n elements.
+ *
+ * @param n The number of elements the file should be able to hold.
+ */
+template <typename T, typename LockPolicy>
+void MappedSimpleVector<T, LockPolicy>::reserve(size_t n) {
+    WriteLock lock(lockPolicy);
+    if (n > capacityUnlocked()) {
+        remap(n);
+    }
+}
+
+/**
+ * @brief Add n elements copied from an array, growing the file at most once.
+ *
+ * @details The source may point into this vector. Its offset is kept across the remap, which moves the elements.
+ *
+ * @param first Pointer to the first element to copy.
+ * @param n The number of elements to copy.
+ */
+template <typename T, typename LockPolicy>
+void MappedSimpleVector<T, LockPolicy>::append(const T* first, size_t n) {
+    WriteLock lock(lockPolicy);
+    uint64_t count = header()->count;
+    const T* begin = array();
+    if (count + n > capacityUnlocked() && std::less_equal<const T*>()(begin, first) && std::less<const T*>()(first, begin + count)) {
+        size_t offset = static_cast<size_t>(first - begin); // first dangles once the mapping moves
+        ensureCapacity(count + n);
+        first = array() + offset;
+    } else {
+        ensureCapacity(count + n);
+    }
+    std::memcpy(static_cast<void*>(array() + count), static_cast<const void*>(first), n * sizeof(T));
+    header()->count = count + n;
+}
+
+/**
+ * @brief Remove every element equal to item.
+ *
+ * @param item The item to be removed.
+ */
+template <typename T, typename LockPolicy>
+void MappedSimpleVector<T, LockPolicy>::remove(const T& item) {
+    WriteLock lock(lockPolicy);
+    T value = item;
+    T* first = array();
+    header()->count = static_cast<uint64_t>(std::remove(first, first + header()->count, value) - first);
+}
+
+/**
+ * @brief Remove all elements. The file keeps its size so it can be refilled without growing.
+ */
+template <typename T, typename LockPolicy>
+void MappedSimpleVector<T, LockPolicy>::clear() {
+    WriteLock lock(lockPolicy);
+    header()->count = 0;
+}
+
+/**
+ * @brief Truncate the file to the elements in use.
+ *
+ * @return True if the file was shrunk, false if it was already as small as possible.
+ */
+template <typename T, typename LockPolicy>
+bool MappedSimpleVector<T, LockPolicy>::shrinkToFit() {
+    WriteLock lock(lockPolicy);
+    size_t target = header()->count > 0 ? header()->count : 1;
+    if (target == capacityUnlocked()) {
+        return false;
+    }
+    remap(target);
+    return true;
+}
+
+/**
+ * @brief Get the last element in the array.
+ *
+ * @throw IndexOutOfBoundsException if the array is empty.
+ */
+template <typename T, typename LockPolicy>
+T& MappedSimpleVector<T, LockPolicy>::back() {
+    ReadLock lock(lockPolicy);
+    if (header()->count == 0) {
+        throw IndexOutOfBoundsException("Array is empty.");
+    }
+    return array()[header()->count - 1];
+}
+
+/**
+ * @brief Get the first element in the array.
+ *
+ * @throw IndexOutOfBoundsException if the array is empty.
+ */
+template <typename T, typename LockPolicy>
+T& MappedSimpleVector<T, LockPolicy>::front() {
+    ReadLock lock(lockPolicy);
+    if (header()->count == 0) {
+        throw IndexOutOfBoundsException("Array is empty.");
+    }
+    return array()[0];
+}
+
+/**
+ * @brief Overload the subscript operator for non-const objects.
+ *
+ * @throw IndexOutOfBoundsException if the index is out of bounds.
+ */
+template <typename T, typename LockPolicy>
+T& MappedSimpleVector<T, LockPolicy>::operator[](size_t index) {
+    ReadLock lock(lockPolicy);
+    if (index >= header()->count) {
+        throw IndexOutOfBoundsException("Error: Index out of bounds.");
+    }
+    return array()[index];
+}
+
+/**
+ * @brief Overload the subscript operator for const objects.
+ *
+ * @throw IndexOutOfBoundsException if the index is out of bounds.
+ */
+template <typename T, typename LockPolicy>
+const T& MappedSimpleVector<T, LockPolicy>::operator[](size_t index) const {
+    ReadLock lock(lockPolicy);
+    if (index >= header()->count) {
+        throw IndexOutOfBoundsException("Error: Index out of bounds.");
+    }
+    return array()[index];
+}
+
+/**
+ * @brief Get a pointer to the underlying array. It is invalidated when the vector grows.
+ */
+template <typename T, typename LockPolicy>
+T* MappedSimpleVector<T, LockPolicy>::data() {
+    ReadLock lock(lockPolicy);
+    return array();
+}
+
+/**
+ * @brief Get a pointer to the underlying array. It is invalidated when the vector grows.
+ */
+template <typename T, typename LockPolicy>
+const T* MappedSimpleVector<T, LockPolicy>::data() const {
+    ReadLock lock(lockPolicy);
+    return array();
+}
+
+/**
+ * @brief Get the capacity of the array.
+ *
+ * @details Like SimpleVector::size(), this is the number of elements the file can hold, not the number in use.
+ * Use elements() for that.
+ */
+template <typename T, typename LockPolicy>
+size_t MappedSimpleVector<T, LockPolicy>::size() const {
+    ReadLock lock(lockPolicy);
+    return capacityUnlocked();
+}
+
+/**
+ * @brief Get the number of elements in the array.
+ */
+template <typename T, typename LockPolicy>
+size_t MappedSimpleVector<T, LockPolicy>::elements() const {
+    ReadLock lock(lockPolicy);
+    return static_cast<size_t>(header()->count);
+}
+
+/**
+ * @brief Get the number of elements the file can hold without growing.
+ */
+template <typename T, typename LockPolicy>
+size_t MappedSimpleVector<T, LockPolicy>::capacity() const {
+    ReadLock lock(lockPolicy);
+    return capacityUnlocked();
+}
+
+/**
+ * @brief Check if the array is empty.
+ */
+template <typename T, typename LockPolicy>
+bool MappedSimpleVector<T, LockPolicy>::isEmpty() const {
+    return elements() == 0;
+}
+
+/**
+ * @brief Get the index of the specified element.
+ *
+ * @param element The element to search for.
+ * @return The index of the first match, or -1 if the element is not present.
+ */
+template <typename T, typename LockPolicy>
+ptrdiff_t MappedSimpleVector<T, LockPolicy>::indexOf(const T& element) const {
+    ReadLock lock(lockPolicy);
+    size_t count = static_cast<size_t>(header()->count);
+    size_t index = SimdKernels<T>::find(array(), count, element);
+    return index < count ? static_cast<ptrdiff_t>(index) : -1;
+}
+
+/**
+ * @brief Check if the array contains the specified element.
+ */
+template <typename T, typename LockPolicy>
+bool MappedSimpleVector<T, LockPolicy>::contains(const T& element) const {
+    return indexOf(element) != -1;
+}
+
+/**
+ * @brief Count the elements equal to the specified element.
+ */
+template <typename T, typename LockPolicy>
+size_t MappedSimpleVector<T, LockPolicy>::count(const T& element) const {
+    ReadLock lock(lockPolicy);
+    return SimdKernels<T>::count(array(), static_cast<size_t>(header()->count), element);
+}
+
+#endif // defined(__unix__) || defined(__APPLE__)
+
+#endif // MAPPEDSIMPLEVECTOR_H
@@ -0,0 +1,451 @@
+#ifndef PARALLELALGORITHMS_H
+#define PARALLELALGORITHMS_H
+
+#include "SimpleVector.h"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+// Number of threads the parallel algorithms use, including the calling thread. 0 means one per hardware thread.
+#ifndef SIMPLEVECTOR_PARALLEL_THREADS
+#define SIMPLEVECTOR_PARALLEL_THREADS 0
+#endif
+
+//==============================================================================|
+
+/**
+ * @brief Process-wide work-stealing thread pool behind the parallel SimpleVector algorithms.
+ *
+ * @details There is one worker per hardware thread except one, because the thread that starts a parallel call works
+ * along instead of waiting idle. Each worker owns a double-ended queue. A task covers a range of chunks: the thread
+ * that runs it keeps splitting the range in half, pushes the upper half onto the back of its own queue and continues
+ * with the lower half until a single chunk is left. Owners pop from the back of their queue, which keeps recently
+ * touched data hot in their cache; idle workers steal from the front of other queues, which holds the largest ranges,
+ * so a handful of steals spreads the work over all cores.
+ *
+ * A thread waiting for a parallel call to finish runs queued tasks meanwhile, so parallel calls may be nested.
+ * The pool is created on first use and lives until the process exits.
+ */
+class ParallelThreadPool {
+public:
+    /**
+     * @brief A parallel call in progress: runs chunk i for every chunk in the call.
+     */
+    class Job {
+    private:
+        friend class ParallelThreadPool;
+
+        void (*runChunk)(void* body, size_t chunk); // Calls the body for one chunk
+        void* body; // The callable of the parallel call
+        std::atomic<size_t> remaining; // Chunks not finished yet
+        std::mutex errorMutex; // Protects error and errorChunk
+        std::exception_ptr error; // Exception of the lowest failing chunk
+        size_t errorChunk; // Chunk that threw error
+
+    public:
+        template <typename Body>
+        Job(Body& chunkBody, size_t chunkCount)
+            : runChunk([](void* b, size_t chunk) { (*static_cast<Body*>(b))(chunk); }), body(&chunkBody),
+              remaining(chunkCount), errorChunk(SIZE_MAX) {}
+    };
+
+private:
+    /**
+     * @brief A range of chunks of one job.
+     */
+    struct Task {
+        Job* job;
+        size_t first;
+        size_t last;
+    };
+
+    /**
+     * @brief The task queue of one thread, padded to its own cache line.
+     */
+    struct alignas(64) WorkQueue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    std::vector<std::thread> workers; // Worker threads, never joined
+    std::unique_ptr<WorkQueue[]> queues; // One queue per worker, plus a last one shared by all other threads
+    size_t queueCount; // Number of queues
+    std::atomic<size_t> queued; // Number of tasks in all queues
+    std::mutex sleepMutex; // Guards sleeping on wake
+    std::condition_variable wake; // Signalled when tasks are queued
+
+    ParallelThreadPool();
+
+    static size_t& localQueue(); // Index of the queue owned by the calling thread
+    void workerLoop(size_t index); // Body of worker thread index
+    void push(const Task& task); // Add a task to the back of the calling thread's queue
+    bool popOrSteal(Task& task); // Take a task from the own queue, or else from another queue
+    void execute(Task task); // Split a task down to one chunk and run it
+
+public:
+    ParallelThreadPool(const ParallelThreadPool&) = delete;
+    ParallelThreadPool& operator=(const ParallelThreadPool&) = delete;
+
+    static ParallelThreadPool& instance(); // Get the process-wide pool
+    size_t threadCount() const; // Number of threads that run chunks, including the calling thread
+
+    template <typename Body>
+    void run(size_t chunkCount, Body body); // Call body(chunk) for every chunk and wait for all of them
+};
+
+/**
+ * @brief Get the process-wide pool. It is intentionally never destroyed, like EpochReclamation.
+ */
+inline ParallelThreadPool& ParallelThreadPool::instance() {
+    static ParallelThreadPool* pool = new ParallelThreadPool();
+    return *pool;
+}
+
+/**
+ * @brief Start one worker per hardware thread except one, or SIMPLEVECTOR_PARALLEL_THREADS - 1 workers if that is set.
+ */
+inline ParallelThreadPool::ParallelThreadPool() : queued(0) {
+    size_t threads = SIMPLEVECTOR_PARALLEL_THREADS > 0 ? SIMPLEVECTOR_PARALLEL_THREADS : std::thread::hardware_concurrency();
+    size_t workerCount = threads > 1 ? threads - 1 : 0;
+    queueCount = workerCount + 1;
+    queues.reset(new WorkQueue[queueCount]);
+    for (size_t i = 0; i < workerCount; i++) {
+        workers.emplace_back([this, i]() { workerLoop(i); });
+    }
+}
+
+/**
+ * @brief Get the index of the queue owned by the calling thread. Threads outside the pool share the last queue.
+ */
+inline size_t& ParallelThreadPool::localQueue() {
+    static thread_local size_t index = SIZE_MAX;
+    return index;
+}
+
+inline size_t ParallelThreadPool::threadCount() const {
+    return workers.size() + 1;
+}
+
+inline void ParallelThreadPool::workerLoop(size_t index) {
+    localQueue() = index;
+    Task task;
+    while (true) {
+        if (popOrSteal(task)) {
+            execute(task);
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        wake.wait(lock, [this]() { return queued.load(std::memory_order_acquire) > 0; });
+    }
+}
+
+/**
+ * @brief Add a task to the back of the calling thread's queue and wake a sleeping worker to steal it.
+ */
+inline void ParallelThreadPool::push(const Task& task) {
+    size_t index = std::min(localQueue(), queueCount - 1);
+    {
+        std::lock_guard<std::mutex> lock(queues[index].mutex);
+        queues[index].tasks.push_back(task);
+    }
+    queued.fetch_add(1, std::memory_order_release);
+    if (!workers.empty()) {
+        std::lock_guard<std::mutex> lock(sleepMutex); // Pairs with the predicate check of sleeping workers
+        wake.notify_one();
+    }
+}
+
+/**
+ * @brief Take the newest task of the own queue, or else steal the oldest task of another queue.
+ *
+ * @return True if a task was taken.
+ */
+inline bool ParallelThreadPool::popOrSteal(Task& task) {
+    if (queued.load(std::memory_order_acquire) == 0) {
+        return false;
+    }
+    size_t own = std::min(localQueue(), queueCount - 1);
+    {
+        std::lock_guard<std::mutex> lock(queues[own].mutex);
+        if (!queues[own].tasks.empty()) {
+            task = queues[own].tasks.back();
+            queues[own].tasks.pop_back();
+            queued.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+    for (size_t offset = 1; offset < queueCount; offset++) {
+        WorkQueue& victim = queues[(own + offset) % queueCount];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.tasks.empty()) {
+            task = victim.tasks.front();
+            victim.tasks.pop_front();
+            queued.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Run a task: publish the upper halves of its range for stealing and run the first chunk.
+ *
+ * @details An exception thrown by a chunk is recorded in the job; when several chunks throw, the one with the lowest
+ * index wins, so the caller sees the same exception regardless of scheduling.
+ */
+inline void ParallelThreadPool::execute(Task task) {
+    while (task.last - task.first > 1) {
+        size_t middle = task.first + (task.last - task.first) / 2;
+        push(Task{task.job, middle, task.last});
+        task.last = middle;
+    }
+    Job* job = task.job;
+    try {
+        job->runChunk(job->body, task.first);
+    } catch (...) {
+        std::lock_guard<std::mutex> lock(job->errorMutex);
+        if (task.first < job->errorChunk) {
+            job->error = std::current_exception();
+            job->errorChunk = task.first;
+        }
+    }
+    job->remaining.fetch_sub(1, std::memory_order_acq_rel);
+}
+
+/**
+ * @brief Call body(chunk) for every chunk in [0, chunkCount) on the pool and wait until all of them are done.
+ *
+ * @details The calling thread runs chunks as well and, while waiting, also runs tasks of other parallel calls.
+ *
+ * @throw The exception of the lowest-numbered chunk that threw, after every chunk has finished.
+ */
+template <typename Body>
+void ParallelThreadPool::run(size_t chunkCount, Body body) {
+    if (chunkCount == 0) {
+        return;
+    }
+    if (chunkCount == 1 || workers.empty()) {
+        for (size_t chunk = 0; chunk < chunkCount; chunk++) {
+            body(chunk);
+        }
+        return;
+    }
+    Job job(body, chunkCount);
+    execute(Task{&job, 0, chunkCount});
+    Task task;
+    while (job.remaining.load(std::memory_order_acquire) > 0) {
+        if (popOrSteal(task)) {
+            execute(task);
+        } else {
+            std::this_thread::yield();
+        }
+    }
+    if (job.error) {
+        std::rethrow_exception(job.error);
+    }
+}
+
+//==============================================================================|
+
+/**
+ * @brief Division of an array into chunks for the parallel algorithms.
+ *
+ * @details Chunks hold grainSize elements, rounded up to whole 64-byte cache lines. When the array start is given,
+ * the first chunk is shortened so that every later chunk starts on a cache line boundary and no two threads write
+ * to the same line. Without it, the boundaries depend only on the indices, which makes reductions reproducible.
+ */
+class ParallelChunks {
+private:
+    size_t count; // Number of elements
+    size_t grain; // Elements per chunk
+    size_t head; // Elements in the first, shortened chunk, 0 if it is not shortened
+
+public:
+    static constexpr size_t CACHE_LINE = 64; // Bytes per cache line
+    static constexpr size_t DEFAULT_GRAIN = 4096; // Default number of elements per chunk
+
+    template <typename T>
+    ParallelChunks(const T* data, size_t n, size_t grainSize) : count(n), head(0) {
+        size_t perLine = sizeof(T) < CACHE_LINE ? CACHE_LINE / sizeof(T) : 1;
+        grain = std::max<size_t>(grainSize, 1);
+        grain = (grain + perLine - 1) / perLine * perLine;
+        uintptr_t address = reinterpret_cast<uintptr_t>(data);
+        if (data != nullptr && CACHE_LINE % sizeof(T) == 0 && address % sizeof(T) == 0) {
+            head = std::min(n, (CACHE_LINE - address % CACHE_LINE) % CACHE_LINE / sizeof(T));
+        }
+    }
+
+    size_t chunkCount() const { return count == 0 ? 0 : (head > 0) + (count - head + grain - 1) / grain; }
+    size_t begin(size_t chunk) const { return chunk == 0 ? 0 : std::min(count, head + (chunk - (head > 0)) * grain); }
+    size_t end(size_t chunk) const { return begin(chunk + 1); }
+};
+
+namespace ParallelDetail {
+
+/**
+ * @brief Forward iterator that yields the same value n times, used to fill a vector with one growth.
+ */
+template <typename T>
+class RepeatIterator {
+    const T* value;
+    size_t index;
+
+public:
+    typedef std::forward_iterator_tag iterator_category;
+    typedef T value_type;
+    typedef ptrdiff_t difference_type;
+    typedef const T* pointer;
+    typedef const T& reference;
+
+    RepeatIterator(const T* repeated, size_t position) : value(repeated), index(position) {}
+    const T& operator*() const { return *value; }
+    RepeatIterator& operator++() { ++index; return *this; }
+    RepeatIterator operator++(int) { RepeatIterator previous = *this; ++index; return previous; }
+    bool operator==(const RepeatIterator& other) const { return index == other.index; }
+    bool operator!=(const RepeatIterator& other) const { return index != other.index; }
+};
+
+/**
+ * @brief A per-chunk result padded to its own cache line, so threads writing neighbouring results do not collide.
+ */
+template <typename T>
+struct alignas(64) PaddedResult {
+    T value;
+};
+
+} // namespace ParallelDetail
+
+//==============================================================================|
+
+/**
+ * @brief Call f on every element, in parallel.
+ *
+ * @details Elements are processed in cache-line aligned chunks of about grainSize elements. f may modify the element
+ * it is given but must not touch other elements or resize the vector.
+ *
+ * @param vec The vector to process.
+ * @param f Callable taking T&.
+ * @param grainSize The number of elements per chunk. Larger grains lower the scheduling overhead, smaller grains balance better.
+ */
+template <typename T, typename LockPolicy, typename GrowthPolicy, typename Func>
+void parallel_for_each(SimpleVector<T, LockPolicy, GrowthPolicy>& vec, Func f, size_t grainSize = ParallelChunks::DEFAULT_GRAIN) {
+    T* data = vec.data();
+    ParallelChunks chunks(data, vec.elements(), grainSize);
+    ParallelThreadPool::instance().run(chunks.chunkCount(), [&](size_t chunk) {
+        for (size_t i = chunks.begin(chunk), end = chunks.end(chunk); i < end; i++) {
+            f(data[i]);
+        }
+    });
+}
+
+/**
+ * @brief Store f(in[i]) in out[i] for every element, in parallel.
+ *
+ * @details out is replaced by in.elements() default-constructed values first, then every chunk of out is written
+ * by one thread. in and out must be different vectors.
+ *
+ * @param in The vector to read.
+ * @param out The vector to write.
+ * @param f Callable taking const T& and returning a value assignable to U.
+ * @param grainSize The number of elements per chunk.
+ */
+template <typename T, typename L1, typename G1, typename U, typename L2, typename G2, typename Func>
+void parallel_transform(const SimpleVector<T, L1, G1>& in, SimpleVector<U, L2, G2>& out, Func f, size_t grainSize = ParallelChunks::DEFAULT_GRAIN) {
+    size_t n = in.elements();
+    const U blank = U();
+    out.clear();
+    out.append(ParallelDetail::RepeatIterator<U>(&blank, 0), ParallelDetail::RepeatIterator<U>(&blank, n));
+    const T* source = in.data();
+    U* dest = out.data();
+    ParallelChunks chunks(dest, n, grainSize);
+    ParallelThreadPool::instance().run(chunks.chunkCount(), [&](size_t chunk) {
+        for (size_t i = chunks.begin(chunk), end = chunks.end(chunk); i < end; i++) {
+            dest[i] = f(source[i]);
+        }
+    });
+}
+
+/**
+ * @brief Combine all elements with op, in parallel and with a reproducible result.
+ *
+ * @details Each chunk is folded from left to right with op starting at identity, then the chunk results are folded in
+ * chunk order with combine on the calling thread. Chunk boundaries depend only on grainSize, so the result is the same
+ * on every run and on every machine, even for operations that are not exactly associative such as floating point
+ * addition. op and combine are separate because the element type and the result type can differ: counting the
+ * elements that match a predicate adds 0 or 1 per element but adds whole counts per chunk.
+ *
+ * @param vec The vector to reduce.
+ * @param identity The neutral value of combine, used to start every chunk and the final fold.
+ * @param op Callable taking (Result, const T&) and returning Result.
+ * @param combine Associative callable taking (Result, Result) and returning Result.
+ * @param grainSize The number of elements per chunk.
+ * @return The combined value, or identity if the vector is empty.
+ */
+template <typename T, typename LockPolicy, typename GrowthPolicy, typename Result, typename Op, typename Combine>
+Result parallel_reduce(const SimpleVector<T, LockPolicy, GrowthPolicy>& vec, Result identity, Op op, Combine combine,
+                       size_t grainSize = ParallelChunks::DEFAULT_GRAIN) {
+    static_assert(std::is_invocable_r<Result, Combine&, Result, Result>::value,
+                  "parallel_reduce: combine must be callable as (Result, Result) and return Result");
+    const T* data = vec.data();
+    ParallelChunks chunks(static_cast<const T*>(nullptr), vec.elements(), grainSize);
+    size_t chunkCount = chunks.chunkCount();
+    std::unique_ptr<ParallelDetail::PaddedResult<Result>[]> partial(new ParallelDetail::PaddedResult<Result>[chunkCount]);
+    ParallelThreadPool::instance().run(chunkCount, [&](size_t chunk) {
+        Result value = identity;
+        for (size_t i = chunks.begin(chunk), end = chunks.end(chunk); i < end; i++) {
+            value = op(value, data[i]);
+        }
+        partial[chunk].value = value;
+    });
+    Result total = identity;
+    for (size_t chunk = 0; chunk < chunkCount; chunk++) {
+        total = combine(total, partial[chunk].value);
+    }
+    return total;
+}
+
+/**
+ * @brief Copy the elements that satisfy pred into a new vector, in parallel, keeping their order.
+ *
+ * @details Every chunk collects its matches into a private buffer; the buffers are then appended in chunk order.
+ *
+ * @param vec The vector to filter.
+ * @param pred Callable taking const T& and returning bool.
+ * @param grainSize The number of elements per chunk.
+ * @return A vector with the matching elements, in their original order.
+ */
+template <typename T, typename LockPolicy, typename GrowthPolicy, typename Pred>
+SimpleVector<T, LockPolicy, GrowthPolicy> parallel_filter(const SimpleVector<T, LockPolicy, GrowthPolicy>& vec, Pred pred, size_t grainSize = ParallelChunks::DEFAULT_GRAIN) {
+    const T* data = vec.data();
+    ParallelChunks chunks(static_cast<const T*>(nullptr), vec.elements(), grainSize);
+    size_t chunkCount = chunks.chunkCount();
+    std::vector<SimpleVector<T, NoLockPolicy>> matches(chunkCount);
+    ParallelThreadPool::instance().run(chunkCount, [&](size_t chunk) {
+        for (size_t i = chunks.begin(chunk), end = chunks.end(chunk); i < end; i++) {
+            if (pred(data[i])) {
+                matches[chunk].push_back(data[i]);
+            }
+        }
+    });
+    size_t total = 0;
+    for (const SimpleVector<T, NoLockPolicy>& part : matches) {
+        total += part.elements();
+    }
+    SimpleVector<T, LockPolicy, GrowthPolicy> result;
+    result.reserve(total);
+    for (const SimpleVector<T, NoLockPolicy>& part : matches) {
+        result.append(part.begin(), part.end());
+    }
+    return result;
+}
+
+#endif // PARALLELALGORITHMS_H
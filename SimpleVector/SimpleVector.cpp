@@ -357,4 +357,8 @@ public:
         }
     };
 };
+
+// Fixed-capacity, heap-free variant shared with the desktop build.
+#include "StaticSimpleVector.h"
+
 #endif // SIMPLEVECTOR_H
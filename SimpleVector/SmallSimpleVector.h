@@ -0,0 +1,214 @@
+#ifndef SMALLSIMPLEVECTOR_H
+#define SMALLSIMPLEVECTOR_H
+
+#include "SimpleVector.h"
+
+//==============================================================================|
+
+/**
+ * @brief A SimpleVector that keeps its first N elements in inline storage.
+ *
+ * @details Short vectors never touch the heap: the first N elements live in a buffer embedded in the object itself.
+ * Adding element N + 1 moves the contents to a heap array, after which the vector behaves exactly like a SimpleVector.
+ * Shrinking back to N elements or fewer with shrinkToFit or releaseMemory returns to the inline buffer; clear keeps the heap array for refilling.
+ *
+ * A SmallSimpleVector is a SimpleVector, so it can be passed to any function that takes a SimpleVector reference.
+ * Copies and moves between the two types are supported in both directions.
+ *
+ * @tparam T The type of the elements.
+ * @tparam N The number of elements stored inline.
+ * @tparam LockPolicy The locking policy, see SimpleVector.
+ * @tparam GrowthPolicy The growth policy, see SimpleVector.
+ */
+template <typename T, unsigned int N, typename LockPolicy = MutexLockPolicy, typename GrowthPolicy = DoublingGrowthPolicy>
+class SmallSimpleVector : public SimpleVector<T, LockPolicy, GrowthPolicy> {
+    static_assert(N > 0, "SmallSimpleVector needs room for at least one inline element");
+
+    typedef SimpleVector<T, LockPolicy, GrowthPolicy> Base;
+
+private:
+    alignas(T) unsigned char inlineStorage[N * sizeof(T)]; // Raw inline storage for the first N elements
+
+public:
+    SmallSimpleVector(); // Default constructor
+    SmallSimpleVector(std::initializer_list<T> initList); // Initializer list constructor
+    SmallSimpleVector(const SmallSimpleVector& other); // Copy constructor
+    SmallSimpleVector(SmallSimpleVector&& other) noexcept(std::is_nothrow_move_constructible<T>::value); // Move constructor
+    SmallSimpleVector(const Base& other); // Copy from a SimpleVector
+    SmallSimpleVector(Base&& other); // Move from a SimpleVector, may allocate
+    ~SmallSimpleVector(); // Destructor
+
+    SmallSimpleVector& operator=(const SmallSimpleVector& other); // Copy assignment operator
+    SmallSimpleVector& operator=(SmallSimpleVector&& other) noexcept(std::is_nothrow_move_constructible<T>::value); // Move assignment operator
+
+    static constexpr unsigned int inlineSize() { return N; } // Number of elements stored without allocating
+    bool isInline() const; // Check if the elements currently live in the inline storage
+};
+
+//==============================================================================|
+
+/**
+ * @brief Constructs an empty SmallSimpleVector object. No memory is allocated.
+ */
+template <typename T, unsigned int N, typename LockPolicy, typename GrowthPolicy>
+SmallSimpleVector<T, N, LockPolicy, GrowthPolicy>::SmallSimpleVector() : Base(reinterpret_cast<T*>(inlineStorage), N) {
+}
+
+/**
+ * @brief Constructs a SmallSimpleVector object from an initializer list.
+ *
+ * @details Unlike SimpleVector, an empty initializer list is allowed and simply yields an empty vector.
+ *
+ * @param initList The initializer list to initialize the vector with.
+ */
+template <typename T, unsigned int N, typename LockPolicy, typename GrowthPolicy>
+SmallSimpleVector<T, N, LockPolicy, GrowthPolicy>::SmallSimpleVector(std::initializer_list<T> initList) : Base(reinterpret_cast<T*>(inlineStorage), N) {
+    for (const T& value : initList) {
+        this->push_back(value);
+    }
+}
+
+/**
+ * @brief Constructs a SmallSimpleVector object by copying another SmallSimpleVector object.
+ *
+ * @param other The SmallSimpleVector object to copy.
+ */
+template <typename T, unsigned int N, typename LockPolicy, typename GrowthPolicy>
+SmallSimpleVector<T, N, LockPolicy, GrowthPolicy>::SmallSimpleVector(const SmallSimpleVector& other) : Base(reinterpret_cast<T*>(inlineStorage), N) {
+    this->copyFrom(other);
+}
+
+/**
+ * @brief Constructs a SmallSimpleVector object by taking over the elements of another SmallSimpleVector object.
+ *
+ * @details Heap storage is stolen; inline elements are moved one by one into this vector's inline storage, which has
+ * the same size. No memory is allocated. Moving to or from a vector of another type goes through the SimpleVector
+ * overloads and may allocate.
+ *
+ * @param other The SmallSimpleVector object to move from. It is left empty.
+ */
+template <typename T, unsigned int N, typename LockPolicy, typename GrowthPolicy>
+SmallSimpleVector<T, N, LockPolicy, GrowthPolicy>::SmallSimpleVector(SmallSimpleVector&& other) noexcept(std::is_nothrow_move_constructible<T>::value)
+    : Base(reinterpret_cast<T*>(inlineStorage), N) {
+    this->moveFrom(other);
+}
+
+/**
+ * @brief Constructs a SmallSimpleVector object by copying a SimpleVector object.
+ *
+ * @param other The SimpleVector object to copy.
+ */
+template <typename T, unsigned int N, typename LockPolicy, typename GrowthPolicy>
+SmallSimpleVector<T, N, LockPolicy, GrowthPolicy>::SmallSimpleVector(const Base& other) : Base(reinterpret_cast<T*>(inlineStorage), N) {
+    this->copyFrom(other);
+}
+
+/**
+ * @brief Constructs a SmallSimpleVector object by taking over the elements of a SimpleVector object.
+ *
+ * @details Heap storage is stolen. If other is a SmallSimpleVector with more inline elements than fit here, they are
+ * moved to a new heap array.
+ *
+ * @param other The SimpleVector object to move from. It is left empty.
+ * @throw std::bad_alloc if other's inline elements need a heap array that cannot be allocated.
+ */
+template <typename T, unsigned int N, typename LockPolicy, typename GrowthPolicy>
+SmallSimpleVector<T, N, LockPolicy, GrowthPolicy>::SmallSimpleVector(Base&& other)
+    : Base(reinterpret_cast<T*>(inlineStorage), N) {
+    this->moveFrom(other);
+}
+
+/**
+ * @brief Destroys the SmallSimpleVector object.
+ *
+ * @details The elements are destroyed here, while the inline storage they may live in still exists.
+ */
+template <typename T, unsigned int N, typename LockPolicy, typename GrowthPolicy>
+SmallSimpleVector<T, N, LockPolicy, GrowthPolicy>::~SmallSimpleVector() {
+    this->releaseStorage();
+}
+
+/**
+ * @brief Replaces the contents of this vector with a copy of another vector.
+ *
+ * @param other The SmallSimpleVector object to copy.
+ * @return Reference to this vector.
+ */
+template <typename T, unsigned int N, typename LockPolicy, typename GrowthPolicy>
+SmallSimpleVector<T, N, LockPolicy, GrowthPolicy>& SmallSimpleVector<T, N, LockPolicy, GrowthPolicy>::operator=(const SmallSimpleVector& other) {
+    Base::operator=(other);
+    return *this;
+}
+
+/**
+ * @brief Replaces the contents of this vector by taking over the elements of another vector.
+ *
+ * @details The elements pass through a SmallSimpleVector temporary, so inline elements stay inline and nothing is allocated.
+ *
+ * @param other The SmallSimpleVector object to move from. It is left empty.
+ * @return Reference to this vector.
+ */
+template <typename T, unsigned int N, typename LockPolicy, typename GrowthPolicy>
+SmallSimpleVector<T, N, LockPolicy, GrowthPolicy>& SmallSimpleVector<T, N, LockPolicy, GrowthPolicy>::operator=(SmallSimpleVector&& other) noexcept(std::is_nothrow_move_constructible<T>::value) {
+    if (this != &other) {
+        SmallSimpleVector moved(std::move(other));
+        this->replaceStorage(moved);
+    }
+    return *this;
+}
+
+/**
+ * @brief Check if the elements currently live in the inline storage.
+ *
+ * @return True while the vector has not spilled to the heap.
+ */
+template <typename T, unsigned int N, typename LockPolicy, typename GrowthPolicy>
+bool SmallSimpleVector<T, N, LockPolicy, GrowthPolicy>::isInline() const {
+    return this->storageIsInline();
+}
+
+//==============================================================================|
+
+/**
+ * @brief A packed SimpleVector<bool> that keeps its first flags in inline words.
+ *
+ * @details N is rounded up to whole 64-bit words, so inlineSize() may be larger than N.
+ *
+ * @tparam N The minimum number of flags stored inline.
+ * @tparam LockPolicy The locking policy, see SimpleVector.
+ * @tparam GrowthPolicy The growth policy, see SimpleVector.
+ */
+template <unsigned int N, typename LockPolicy, typename GrowthPolicy>
+class SmallSimpleVector<bool, N, LockPolicy, GrowthPolicy> : public SimpleVector<bool, LockPolicy, GrowthPolicy> {
+    static_assert(N > 0, "SmallSimpleVector needs room for at least one inline element");
+
+    typedef SimpleVector<bool, LockPolicy, GrowthPolicy> Base;
+    typedef typename Base::Word Word;
+    static constexpr size_t INLINE_WORDS = (N + Base::WORD_BITS - 1) / Base::WORD_BITS;
+
+private:
+    Word inlineWords[INLINE_WORDS]; // Inline storage for the first words
+
+public:
+    SmallSimpleVector() : Base(inlineWords, INLINE_WORDS) {}
+    SmallSimpleVector(std::initializer_list<bool> initList) : Base(inlineWords, INLINE_WORDS) { this->append(initList.begin(), initList.end()); }
+    SmallSimpleVector(const SmallSimpleVector& other) : Base(inlineWords, INLINE_WORDS) { this->copyFrom(other); }
+    SmallSimpleVector(SmallSimpleVector&& other) noexcept : Base(inlineWords, INLINE_WORDS) { this->moveFrom(other); }
+    SmallSimpleVector(const Base& other) : Base(inlineWords, INLINE_WORDS) { this->copyFrom(other); }
+    SmallSimpleVector(Base&& other) : Base(inlineWords, INLINE_WORDS) { this->moveFrom(other); } // May allocate if other has more inline words
+    ~SmallSimpleVector() { this->releaseStorage(); }
+
+    SmallSimpleVector& operator=(const SmallSimpleVector& other) { Base::operator=(other); return *this; }
+    SmallSimpleVector& operator=(SmallSimpleVector&& other) noexcept {
+        if (this != &other) {
+            SmallSimpleVector moved(std::move(other)); // Keeps inline words inline, so nothing is allocated
+            this->replaceStorage(moved);
+        }
+        return *this;
+    }
+
+    static constexpr size_t inlineSize() { return INLINE_WORDS * Base::WORD_BITS; } // Number of flags stored without allocating
+    bool isInline() const { return this->storageIsInline(); } // Check if the flags currently live in the inline words
+};
+
+#endif // SMALLSIMPLEVECTOR_H
@@ -0,0 +1,290 @@
+#ifndef SNAPSHOTSIMPLEVECTOR_H
+#define SNAPSHOTSIMPLEVECTOR_H
+
+#include <atomic>
+#include <mutex>
+#include <utility>
+#include "SimpleVector.h"
+#include "EpochReclamation.h"
+
+//==============================================================================|
+
+/**
+ * @brief Read-copy-update vector for lists that are read constantly and changed rarely.
+ *
+ * @details The contents are an immutable SimpleVector version behind an atomic pointer. Readers pin the current epoch
+ * (see EpochReclamation), load the pointer and read the version directly. They never lock, never wait and never
+ * perform an atomic read-modify-write, so any number of reader threads scale.
+ *
+ * Writers are serialized by a mutex. Each write copies the current version, applies the change to the copy and
+ * publishes it with a single atomic store. The old version is retired and deleted once every reader that could
+ * still see it has left. A write therefore costs O(n); use this class for read-mostly data such as configuration or routing lists.
+ *
+ * @tparam T The type of the elements.
+ */
+template <typename T>
+class SnapshotSimpleVector {
+public:
+    typedef SimpleVector<T, NoLockPolicy> Version; // Immutable contents published to readers
+
+private:
+    std::atomic<const Version*> current; // The version new readers see
+    mutable std::mutex writerMutex; // Serializes writers; readers never touch it
+
+    void publish(Version* next); // Make next the current version and retire the previous one; writerMutex must be held
+
+public:
+    class Snapshot; // Pinned, consistent view of one version
+
+    SnapshotSimpleVector(); // Default constructor
+    SnapshotSimpleVector(std::initializer_list<T> initList); // Constructor with initializer list
+    explicit SnapshotSimpleVector(const SimpleVector<T, NoLockPolicy>& contents); // Constructor that copies an existing vector
+    ~SnapshotSimpleVector(); // Destructor
+
+    SnapshotSimpleVector(const SnapshotSimpleVector&) = delete;
+    SnapshotSimpleVector& operator=(const SnapshotSimpleVector&) = delete;
+
+    // Readers
+    Snapshot snapshot() const; // Get a consistent view for several reads in a row
+    T operator[](size_t index) const; // Get a copy of the element at the specified index
+    size_t elements() const; // Get the number of elements
+    bool isEmpty() const; // Check if the vector is empty
+    ptrdiff_t indexOf(const T& element) const; // Get the index of the specified element
+    bool contains(const T& element) const; // Check if the vector contains the specified element
+
+    // Writers
+    template <typename Mutator>
+    void update(Mutator mutate); // Apply mutate to a copy of the contents and publish the result
+    void push_back(const T& item); // Add an element
+    void remove(const T& item); // Remove every element equal to item
+    void set(size_t index, const T& item); // Replace the element at the specified index
+    void assign(const SimpleVector<T, NoLockPolicy>& contents); // Replace the whole contents
+    void clear(); // Remove all elements
+};
+
+//==============================================================================|
+
+/**
+ * @brief A consistent view of one version of a SnapshotSimpleVector.
+ *
+ * @details The thread stays pinned while the snapshot exists, so the version cannot be deleted. Writes made after the
+ * snapshot was taken are not visible through it. A snapshot must be destroyed on the thread that created it, and
+ * should be short-lived because it delays reclamation of old versions.
+ */
+template <typename T>
+class SnapshotSimpleVector<T>::Snapshot {
+private:
+    EpochReclamation::Guard guard;
+    const Version* version;
+
+public:
+    Snapshot(EpochReclamation::Guard&& pinned, const Version* pinnedVersion) : guard(std::move(pinned)), version(pinnedVersion) {}
+
+    const T& operator[](size_t index) const { return (*version)[index]; }
+    size_t elements() const { return version->elements(); }
+    bool isEmpty() const { return version->isEmpty(); }
+    bool contains(const T& element) const { return version->contains(element); }
+    const Version& contents() const { return *version; }
+    typename Version::const_iterator begin() const { return version->begin(); }
+    typename Version::const_iterator end() const { return version->end(); }
+};
+
+/**
+ * @brief Constructs an empty SnapshotSimpleVector object.
+ */
+template <typename T>
+SnapshotSimpleVector<T>::SnapshotSimpleVector() : current(new Version()) {
+}
+
+/**
+ * @brief Constructs a SnapshotSimpleVector object from an initializer list.
+ *
+ * @param initList The initializer list to initialize the vector with.
+ */
+template <typename T>
+SnapshotSimpleVector<T>::SnapshotSimpleVector(std::initializer_list<T> initList) : current(new Version(initList)) {
+}
+
+/**
+ * @brief Constructs a SnapshotSimpleVector object that starts with a copy of an existing vector.
+ *
+ * @param contents The elements to start with.
+ */
+template <typename T>
+SnapshotSimpleVector<T>::SnapshotSimpleVector(const SimpleVector<T, NoLockPolicy>& contents) : current(new Version(contents)) {
+}
+
+/**
+ * @brief Destroys the SnapshotSimpleVector object.
+ *
+ * @details No reader may use the vector while it is destroyed. Versions retired earlier may still be waiting for
+ * unrelated readers and are deleted by a later reclamation pass.
+ */
+template <typename T>
+SnapshotSimpleVector<T>::~SnapshotSimpleVector() {
+    delete current.load(std::memory_order_relaxed);
+    EpochReclamation::instance().collect();
+}
+
+/**
+ * @brief Make a new version current and retire the previous one.
+ *
+ * @details The release store makes the fully built version visible to readers that load the pointer.
+ * writerMutex must be held.
+ *
+ * @param next The new version. The vector takes ownership of it.
+ */
+template <typename T>
+void SnapshotSimpleVector<T>::publish(Version* next) {
+    const Version* previous = current.exchange(next, std::memory_order_acq_rel);
+    EpochReclamation::instance().retire(const_cast<Version*>(previous));
+}
+
+/**
+ * @brief Get a consistent view of the current version.
+ *
+ * @return A snapshot that keeps the version alive until it is destroyed.
+ */
+template <typename T>
+typename SnapshotSimpleVector<T>::Snapshot SnapshotSimpleVector<T>::snapshot() const {
+    EpochReclamation::Guard guard = EpochReclamation::instance().pin();
+    return Snapshot(std::move(guard), current.load(std::memory_order_acquire));
+}
+
+/**
+ * @brief Get a copy of the element at the specified index.
+ *
+ * @details A copy is returned because the version the element lives in may be deleted as soon as this call returns.
+ *
+ * @param index The index of the element to be accessed.
+ * @return A copy of the element at the specified index.
+ *
+ * @throw IndexOutOfBoundsException if the index is out of bounds.
+ */
+template <typename T>
+T SnapshotSimpleVector<T>::operator[](size_t index) const {
+    EpochReclamation::Guard guard = EpochReclamation::instance().pin();
+    return (*current.load(std::memory_order_acquire))[index];
+}
+
+/**
+ * @brief Get the number of elements.
+ *
+ * @return The number of elements in the current version.
+ */
+template <typename T>
+size_t SnapshotSimpleVector<T>::elements() const {
+    EpochReclamation::Guard guard = EpochReclamation::instance().pin();
+    return current.load(std::memory_order_acquire)->elements();
+}
+
+/**
+ * @brief Check if the vector is empty.
+ *
+ * @return True if the current version has no elements.
+ */
+template <typename T>
+bool SnapshotSimpleVector<T>::isEmpty() const {
+    EpochReclamation::Guard guard = EpochReclamation::instance().pin();
+    return current.load(std::memory_order_acquire)->isEmpty();
+}
+
+/**
+ * @brief Get the index of the specified element.
+ *
+ * @param element The element to search for.
+ * @return The index of the element in the current version, or -1 if it is not present.
+ */
+template <typename T>
+ptrdiff_t SnapshotSimpleVector<T>::indexOf(const T& element) const {
+    EpochReclamation::Guard guard = EpochReclamation::instance().pin();
+    return const_cast<Version*>(current.load(std::memory_order_acquire))->indexOf(element);
+}
+
+/**
+ * @brief Check if the vector contains the specified element.
+ *
+ * @param element The element to search for.
+ * @return True if the current version contains the element.
+ */
+template <typename T>
+bool SnapshotSimpleVector<T>::contains(const T& element) const {
+    EpochReclamation::Guard guard = EpochReclamation::instance().pin();
+    return current.load(std::memory_order_acquire)->contains(element);
+}
+
+/**
+ * @brief Apply a change to a copy of the contents and publish the result.
+ *
+ * @details Readers keep seeing the previous version until the new one is complete. If mutate throws, nothing is published.
+ *
+ * @param mutate Callable that receives a SimpleVector<T, NoLockPolicy>& holding a copy of the current contents.
+ */
+template <typename T>
+template <typename Mutator>
+void SnapshotSimpleVector<T>::update(Mutator mutate) {
+    std::lock_guard<std::mutex> lock(writerMutex);
+    Version* next = new Version(*current.load(std::memory_order_relaxed));
+    try {
+        mutate(*next);
+    } catch (...) {
+        delete next;
+        throw;
+    }
+    publish(next);
+}
+
+/**
+ * @brief Add an element.
+ *
+ * @param item The item to be added.
+ */
+template <typename T>
+void SnapshotSimpleVector<T>::push_back(const T& item) {
+    update([&item](Version& next) { next.push_back(item); });
+}
+
+/**
+ * @brief Remove every element equal to item.
+ *
+ * @param item The item to be removed.
+ */
+template <typename T>
+void SnapshotSimpleVector<T>::remove(const T& item) {
+    update([&item](Version& next) { next.remove(item); });
+}
+
+/**
+ * @brief Replace the element at the specified index.
+ *
+ * @param index The index of the element to replace.
+ * @param item The new value.
+ *
+ * @throw IndexOutOfBoundsException if the index is out of bounds.
+ */
+template <typename T>
+void SnapshotSimpleVector<T>::set(size_t index, const T& item) {
+    update([index, &item](Version& next) { next[index] = item; });
+}
+
+/**
+ * @brief Replace the whole contents.
+ *
+ * @param contents The new elements.
+ */
+template <typename T>
+void SnapshotSimpleVector<T>::assign(const SimpleVector<T, NoLockPolicy>& contents) {
+    std::lock_guard<std::mutex> lock(writerMutex);
+    publish(new Version(contents));
+}
+
+/**
+ * @brief Remove all elements.
+ */
+template <typename T>
+void SnapshotSimpleVector<T>::clear() {
+    std::lock_guard<std::mutex> lock(writerMutex);
+    publish(new Version());
+}
+
+#endif // SNAPSHOTSIMPLEVECTOR_H
@@ -0,0 +1,719 @@
+#ifndef SOAVECTOR_H
+#define SOAVECTOR_H
+
+#include "SimpleVector.h"
+#include <algorithm>
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+//==============================================================================|
+
+/**
+ * @brief A view of one contiguous column of a SoAVector.
+ *
+ * @details The span is a pointer and a length, so it can be handed straight to the SimpleVectorSimd kernels or any
+ * other loop over a raw array. The scan helpers below do exactly that. A span does not lock the vector it came from
+ * and is invalidated when the vector grows, like SimpleVector::data().
+ *
+ * @tparam T The element type, const-qualified for read-only spans.
+ */
+template <typename T>
+class ColumnSpan {
+private:
+    typedef typename std::remove_const<T>::type Element;
+
+    T* first; // First element of the column
+    size_t count; // Number of elements in the column
+
+public:
+    typedef T* iterator;
+
+    ColumnSpan() : first(nullptr), count(0) {}
+    ColumnSpan(T* data, size_t n) : first(data), count(n) {}
+
+    // A mutable span converts to a read-only span, but not the other way around.
+    template <typename U, typename = typename std::enable_if<std::is_same<const U, T>::value && !std::is_same<U, T>::value>::type>
+    ColumnSpan(const ColumnSpan<U>& other) : first(other.data()), count(other.size()) {}
+
+    T* data() const { return first; }
+    size_t size() const { return count; }
+    bool isEmpty() const { return count == 0; }
+    T& operator[](size_t index) const { return first[index]; }
+    T* begin() const { return first; }
+    T* end() const { return first + count; }
+
+    ptrdiff_t indexOf(const Element& value) const; // Get the index of the first element equal to value, or -1
+    size_t countOf(const Element& value) const; // Count the elements equal to value
+    Element min() const; // Get the smallest element
+    Element max() const; // Get the largest element
+    typename SimdKernels<Element>::SumType sum() const; // Get the sum of all elements
+};
+
+/**
+ * @brief Get the index of the first element equal to value.
+ *
+ * @return The index, or -1 if no element matches.
+ */
+template <typename T>
+ptrdiff_t ColumnSpan<T>::indexOf(const Element& value) const {
+    size_t index = SimdKernels<Element>::find(first, count, value);
+    return index == count ? -1 : static_cast<ptrdiff_t>(index);
+}
+
+/**
+ * @brief Count the elements equal to value.
+ */
+template <typename T>
+size_t ColumnSpan<T>::countOf(const Element& value) const {
+    return SimdKernels<Element>::count(first, count, value);
+}
+
+/**
+ * @brief Get the smallest element.
+ *
+ * @throw IndexOutOfBoundsException if the span is empty.
+ */
+template <typename T>
+typename ColumnSpan<T>::Element ColumnSpan<T>::min() const {
+    if (count == 0) {
+        throw IndexOutOfBoundsException("Array is empty.");
+    }
+    return SimdKernels<Element>::min(first, count);
+}
+
+/**
+ * @brief Get the largest element.
+ *
+ * @throw IndexOutOfBoundsException if the span is empty.
+ */
+template <typename T>
+typename ColumnSpan<T>::Element ColumnSpan<T>::max() const {
+    if (count == 0) {
+        throw IndexOutOfBoundsException("Array is empty.");
+    }
+    return SimdKernels<Element>::max(first, count);
+}
+
+/**
+ * @brief Get the sum of all elements, accumulated in SimdKernels<T>::SumType.
+ */
+template <typename T>
+typename SimdKernels<typename ColumnSpan<T>::Element>::SumType ColumnSpan<T>::sum() const {
+    return SimdKernels<Element>::sum(first, count);
+}
+
+//==============================================================================|
+
+/**
+ * @brief Element type a SoAVector column stores for a field of type T.
+ *
+ * @details SimpleVector<bool> is bit-packed and has no array of bools to span, so bool fields are stored one byte
+ * per flag in a SimpleVector<unsigned char> and read through bool pointers.
+ */
+template <typename T>
+struct SoAColumnStorage {
+    typedef T type;
+};
+
+template <>
+struct SoAColumnStorage<bool> {
+    static_assert(sizeof(bool) == 1, "bool columns reuse unsigned char storage");
+    typedef unsigned char type;
+};
+
+//==============================================================================|
+
+/**
+ * @brief Structure-of-arrays container: each field of a row is stored in its own contiguous SimpleVector column.
+ *
+ * @details A scan over one field of a SimpleVector<Record> pulls every other field of the record through the cache
+ * as well. A SoAVector<int, float, char> keeps all ints together, all floats together and all chars together, so a
+ * scan of one column touches only the bytes of that column and can be vectorized directly.
+ *
+ * Rows are added with push_back and accessed through row proxies: row.get<I>() returns a reference to field I.
+ * Whole columns are exposed as ColumnSpans for kernels and plain loops.
+ *
+ * Every operation on the vector takes its lock; the columns themselves are unlocked SimpleVectors. Row proxies and
+ * column spans do not lock and are invalidated when the vector grows.
+ *
+ * @tparam LockPolicy The locking policy, see SimpleVector.
+ * @tparam Fields The types of the fields of a row, in order.
+ */
+template <typename LockPolicy, typename... Fields>
+class BasicSoAVector {
+    static_assert(sizeof...(Fields) > 0, "SoAVector needs at least one field");
+
+public:
+    template <size_t I>
+    using FieldType = typename std::tuple_element<I, std::tuple<Fields...>>::type; // Type of field I
+    typedef std::tuple<Fields...> Row; // A row copied out of the vector
+    static constexpr size_t FIELDS = sizeof...(Fields); // Number of fields per row
+
+private:
+    /**
+     * @brief A column that lets the container roll back a partially added row. field() and fields() view the
+     * stored elements as T, which differs from the storage type for bool.
+     */
+    template <typename T>
+    class Column : public SimpleVector<typename SoAColumnStorage<T>::type, NoLockPolicy> {
+    public:
+        using SimpleVector<typename SoAColumnStorage<T>::type, NoLockPolicy>::truncate;
+
+        T& field(size_t index) { return reinterpret_cast<T&>(this->at_unchecked(index)); }
+        const T& field(size_t index) const { return reinterpret_cast<const T&>(this->at_unchecked(index)); }
+        T* fields() { return reinterpret_cast<T*>(this->data()); }
+        const T* fields() const { return reinterpret_cast<const T*>(this->data()); }
+    };
+
+    typedef std::index_sequence_for<Fields...> Indices;
+
+    std::tuple<Column<Fields>...> columns; // One column per field, all of length rowCount
+    size_t rowCount; // Number of rows
+    mutable LockPolicy lockPolicy; // Locking policy used for synchronization
+
+    typedef std::lock_guard<LockPolicy> WriteLock; // Exclusive lock for methods that modify the vector
+    typedef std::shared_lock<LockPolicy> ReadLock; // Shared lock for read-only methods
+
+    // The private helpers below expect the caller to already hold the lock.
+    template <size_t... I>
+    void pushUnlocked(std::index_sequence<I...>, const Fields&... values); // Add a row, or none if a column throws
+    template <size_t... I>
+    void reserveUnlocked(std::index_sequence<I...>, size_t n); // Reserve n rows in every column
+    template <size_t... I>
+    void clearUnlocked(std::index_sequence<I...>); // Empty every column
+    template <size_t... I>
+    void releaseUnlocked(std::index_sequence<I...>); // Free the memory of every column
+    template <size_t... I>
+    bool shrinkUnlocked(std::index_sequence<I...>); // Shrink every column
+    template <size_t... I>
+    Row rowUnlocked(std::index_sequence<I...>, size_t index) const; // Copy the fields of a row
+
+public:
+    template <bool Const>
+    class BasicRowReference; // Proxy for one row
+    typedef BasicRowReference<false> RowReference; // Proxy that can modify the row
+    typedef BasicRowReference<true> ConstRowReference; // Proxy that only reads the row
+    template <bool Const>
+    class BasicRowIterator; // Random access iterator over the rows
+    typedef BasicRowIterator<false> iterator; // Define the iterator type
+    typedef BasicRowIterator<true> const_iterator; // Define the const iterator type
+
+    BasicSoAVector(); // Default constructor
+    BasicSoAVector(size_t initialCapacity); // Constructor with initial capacity in rows
+    BasicSoAVector(const BasicSoAVector& other); // Copy constructor
+    BasicSoAVector(BasicSoAVector&& other) noexcept; // Move constructor
+
+    BasicSoAVector& operator=(const BasicSoAVector& other); // Copy assignment operator
+    BasicSoAVector& operator=(BasicSoAVector&& other) noexcept; // Move assignment operator
+
+    void push_back(const Fields&... values); // Add a row
+    void push_back(const Row& row); // Add a row from a tuple
+    void reserve(size_t n); // Make room for at least n rows
+    void clear(); // Remove all rows, keeping the capacity
+    void releaseMemory(); // Release the memory used by the columns
+    bool shrinkToFit(); // Shrink the columns to the rows in use
+    RowReference operator[](size_t index); // Access a row of a non-const vector
+    ConstRowReference operator[](size_t index) const; // Access a row of a const vector
+    RowReference at_unchecked(size_t index); // Access a row without locking or bounds checking
+    ConstRowReference at_unchecked(size_t index) const; // Access a row without locking or bounds checking
+    RowReference back(); // Get the last row
+    RowReference front(); // Get the first row
+    Row row(size_t index) const; // Copy a row out of the vector
+    size_t size() const; // Get the capacity in rows
+    size_t elements() const; // Get the number of rows
+    bool isEmpty() const; // Check if the vector is empty
+
+    template <size_t I>
+    ColumnSpan<FieldType<I>> column(); // Get the column of field I
+    template <size_t I>
+    ColumnSpan<const FieldType<I>> column() const; // Get the read-only column of field I
+
+    iterator begin(); // Get an iterator pointing to the first row
+    iterator end(); // Get an iterator pointing to one past the last row
+    const_iterator begin() const; // Get a const iterator pointing to the first row
+    const_iterator end() const; // Get a const iterator pointing to one past the last row
+    const_iterator cbegin() const; // Get a const iterator pointing to the first row
+    const_iterator cend() const; // Get a const iterator pointing to one past the last row
+};
+
+/**
+ * @brief SoAVector with the default locking policy.
+ */
+template <typename... Fields>
+using SoAVector = BasicSoAVector<MutexLockPolicy, Fields...>;
+
+//==============================================================================|
+
+/**
+ * @brief Proxy for one row of a SoAVector.
+ *
+ * @details get<I>() reaches into column I. Assigning a tuple or another row writes every field.
+ *
+ * @tparam Const True for a proxy that only reads the row.
+ */
+template <typename LockPolicy, typename... Fields>
+template <bool Const>
+class BasicSoAVector<LockPolicy, Fields...>::BasicRowReference {
+    typedef typename std::conditional<Const, const BasicSoAVector, BasicSoAVector>::type Owner;
+
+    template <size_t... I>
+    void assign(std::index_sequence<I...>, const Row& values) const {
+        ((std::get<I>(owner->columns).field(index) = std::get<I>(values)), ...);
+    }
+
+    Owner* owner;
+    size_t index;
+
+public:
+    BasicRowReference(Owner* vector, size_t row) : owner(vector), index(row) {}
+
+    template <size_t I>
+    typename std::conditional<Const, const FieldType<I>&, FieldType<I>&>::type get() const {
+        return std::get<I>(owner->columns).field(index);
+    }
+
+    operator Row() const { return owner->rowUnlocked(Indices(), index); }
+
+    template <bool C = Const, typename = typename std::enable_if<!C>::type>
+    const BasicRowReference& operator=(const Row& values) const {
+        assign(Indices(), values);
+        return *this;
+    }
+
+    template <bool C = Const, typename = typename std::enable_if<!C>::type>
+    const BasicRowReference& operator=(const BasicRowReference& other) const {
+        assign(Indices(), static_cast<Row>(other));
+        return *this;
+    }
+
+    size_t position() const { return index; }
+};
+
+/**
+ * @brief Random access iterator over the rows of a SoAVector, yielding row proxies.
+ *
+ * @tparam Const True for the const iterator.
+ */
+template <typename LockPolicy, typename... Fields>
+template <bool Const>
+class BasicSoAVector<LockPolicy, Fields...>::BasicRowIterator {
+    typedef typename std::conditional<Const, const BasicSoAVector, BasicSoAVector>::type Owner;
+
+    Owner* owner;
+    size_t index;
+
+public:
+    typedef std::random_access_iterator_tag iterator_category;
+    typedef Row value_type;
+    typedef ptrdiff_t difference_type;
+    typedef BasicRowReference<Const> reference;
+    typedef void pointer;
+
+    BasicRowIterator() : owner(nullptr), index(0) {}
+    BasicRowIterator(Owner* vector, size_t row) : owner(vector), index(row) {}
+
+    reference operator*() const { return reference(owner, index); }
+    reference operator[](difference_type offset) const { return reference(owner, index + offset); }
+
+    BasicRowIterator& operator++() { ++index; return *this; }
+    BasicRowIterator operator++(int) { BasicRowIterator previous = *this; ++index; return previous; }
+    BasicRowIterator& operator--() { --index; return *this; }
+    BasicRowIterator operator--(int) { BasicRowIterator previous = *this; --index; return previous; }
+    BasicRowIterator& operator+=(difference_type offset) { index += offset; return *this; }
+    BasicRowIterator& operator-=(difference_type offset) { index -= offset; return *this; }
+
+    friend BasicRowIterator operator+(BasicRowIterator it, difference_type offset) { return it += offset; }
+    friend BasicRowIterator operator+(difference_type offset, BasicRowIterator it) { return it += offset; }
+    friend BasicRowIterator operator-(BasicRowIterator it, difference_type offset) { return it -= offset; }
+    friend difference_type operator-(const BasicRowIterator& lhs, const BasicRowIterator& rhs) {
+        return static_cast<difference_type>(lhs.index) - static_cast<difference_type>(rhs.index);
+    }
+
+    friend bool operator==(const BasicRowIterator& lhs, const BasicRowIterator& rhs) { return lhs.index == rhs.index; }
+    friend bool operator!=(const BasicRowIterator& lhs, const BasicRowIterator& rhs) { return lhs.index != rhs.index; }
+    friend bool operator<(const BasicRowIterator& lhs, const BasicRowIterator& rhs) { return lhs.index < rhs.index; }
+    friend bool operator>(const BasicRowIterator& lhs, const BasicRowIterator& rhs) { return lhs.index > rhs.index; }
+    friend bool operator<=(const BasicRowIterator& lhs, const BasicRowIterator& rhs) { return lhs.index <= rhs.index; }
+    friend bool operator>=(const BasicRowIterator& lhs, const BasicRowIterator& rhs) { return lhs.index >= rhs.index; }
+};
+
+//==============================================================================|
+
+/**
+ * @brief Constructs an empty SoAVector object.
+ */
+template <typename LockPolicy, typename... Fields>
+BasicSoAVector<LockPolicy, Fields...>::BasicSoAVector() : columns(), rowCount(0) {
+}
+
+/**
+ * @brief Constructs an empty SoAVector object with room for the specified number of rows.
+ *
+ * @param initialCapacity The number of rows to make room for.
+ *
+ * @throw SimpleVectorException if the initial capacity is 0.
+ */
+template <typename LockPolicy, typename... Fields>
+BasicSoAVector<LockPolicy, Fields...>::BasicSoAVector(size_t initialCapacity) : columns(), rowCount(0) {
+    if (initialCapacity == 0) {
+        throw SimpleVectorException("Initial capacity must be greater than 0.");
+    }
+    reserveUnlocked(Indices(), initialCapacity);
+}
+
+/**
+ * @brief Constructs a SoAVector object by copying another one.
+ *
+ * @param other The vector to copy.
+ */
+template <typename LockPolicy, typename... Fields>
+BasicSoAVector<LockPolicy, Fields...>::BasicSoAVector(const BasicSoAVector& other) : rowCount(0) {
+    ReadLock otherLock(other.lockPolicy); // Hold the source steady while it is copied
+    columns = other.columns;
+    rowCount = other.rowCount;
+}
+
+/**
+ * @brief Constructs a SoAVector object by taking over the columns of another one.
+ *
+ * @param other The vector to move from. It is left empty.
+ */
+template <typename LockPolicy, typename... Fields>
+BasicSoAVector<LockPolicy, Fields...>::BasicSoAVector(BasicSoAVector&& other) noexcept : rowCount(0) {
+    WriteLock otherLock(other.lockPolicy); // The source is modified, so take its exclusive lock
+    columns = std::move(other.columns);
+    rowCount = other.rowCount;
+    other.rowCount = 0;
+}
+
+/**
+ * @brief Replaces the contents of this vector with a copy of another vector.
+ *
+ * @details The copy is built before this vector is locked, so the two locks are never held at the same time.
+ *
+ * @param other The vector to copy.
+ * @return Reference to this vector.
+ */
+template <typename LockPolicy, typename... Fields>
+BasicSoAVector<LockPolicy, Fields...>& BasicSoAVector<LockPolicy, Fields...>::operator=(const BasicSoAVector& other) {
+    if (this != &other) {
+        BasicSoAVector copy(other);
+        WriteLock lock(lockPolicy); // Lock for thread-safety
+        columns = std::move(copy.columns);
+        rowCount = copy.rowCount;
+    }
+    return *this;
+}
+
+/**
+ * @brief Replaces the contents of this vector by taking over the columns of another vector.
+ *
+ * @param other The vector to move from. It is left empty.
+ * @return Reference to this vector.
+ */
+template <typename LockPolicy, typename... Fields>
+BasicSoAVector<LockPolicy, Fields...>& BasicSoAVector<LockPolicy, Fields...>::operator=(BasicSoAVector&& other) noexcept {
+    if (this != &other) {
+        BasicSoAVector moved(std::move(other));
+        WriteLock lock(lockPolicy); // Lock for thread-safety
+        columns = std::move(moved.columns);
+        rowCount = moved.rowCount;
+    }
+    return *this;
+}
+
+/**
+ * @brief Add a row by appending each value to its column.
+ *
+ * @details If a column throws, the columns already extended are cut back, so the vector never holds a partial row.
+ */
+template <typename LockPolicy, typename... Fields>
+template <size_t... I>
+void BasicSoAVector<LockPolicy, Fields...>::pushUnlocked(std::index_sequence<I...>, const Fields&... values) {
+    size_t extended = 0;
+    try {
+        ((std::get<I>(columns).push_back(values), extended++), ...);
+    } catch (...) {
+        ((I < extended ? std::get<I>(columns).truncate(rowCount) : void()), ...);
+        throw;
+    }
+    rowCount++;
+}
+
+template <typename LockPolicy, typename... Fields>
+template <size_t... I>
+void BasicSoAVector<LockPolicy, Fields...>::reserveUnlocked(std::index_sequence<I...>, size_t n) {
+    (std::get<I>(columns).reserve(n), ...);
+}
+
+template <typename LockPolicy, typename... Fields>
+template <size_t... I>
+void BasicSoAVector<LockPolicy, Fields...>::clearUnlocked(std::index_sequence<I...>) {
+    (std::get<I>(columns).clear(), ...);
+}
+
+template <typename LockPolicy, typename... Fields>
+template <size_t... I>
+void BasicSoAVector<LockPolicy, Fields...>::releaseUnlocked(std::index_sequence<I...>) {
+    (std::get<I>(columns).releaseMemory(), ...);
+}
+
+template <typename LockPolicy, typename... Fields>
+template <size_t... I>
+bool BasicSoAVector<LockPolicy, Fields...>::shrinkUnlocked(std::index_sequence<I...>) {
+    bool shrunk = false;
+    ((shrunk = std::get<I>(columns).shrinkToFit() || shrunk), ...);
+    return shrunk;
+}
+
+template <typename LockPolicy, typename... Fields>
+template <size_t... I>
+typename BasicSoAVector<LockPolicy, Fields...>::Row BasicSoAVector<LockPolicy, Fields...>::rowUnlocked(std::index_sequence<I...>, size_t index) const {
+    return Row(std::get<I>(columns).field(index)...);
+}
+
+/**
+ * @brief Add a row.
+ *
+ * @param values The fields of the new row, in order.
+ */
+template <typename LockPolicy, typename... Fields>
+void BasicSoAVector<LockPolicy, Fields...>::push_back(const Fields&... values) {
+    WriteLock lock(lockPolicy); // Lock for thread-safety
+    pushUnlocked(Indices(), values...);
+}
+
+/**
+ * @brief Add a row from a tuple of its fields.
+ *
+ * @param row The fields of the new row, in order.
+ */
+template <typename LockPolicy, typename... Fields>
+void BasicSoAVector<LockPolicy, Fields...>::push_back(const Row& row) {
+    WriteLock lock(lockPolicy); // Lock for thread-safety
+    std::apply([this](const Fields&... values) { pushUnlocked(Indices(), values...); }, row);
+}
+
+/**
+ * @brief Make room for at least the specified number of rows in every column. The columns are never shrunk.
+ *
+ * @param n The number of rows the vector must be able to hold.
+ */
+template <typename LockPolicy, typename... Fields>
+void BasicSoAVector<LockPolicy, Fields...>::reserve(size_t n) {
+    WriteLock lock(lockPolicy); // Lock for thread-safety
+    reserveUnlocked(Indices(), n);
+}
+
+/**
+ * @brief Remove all rows, keeping the capacity of the columns.
+ */
+template <typename LockPolicy, typename... Fields>
+void BasicSoAVector<LockPolicy, Fields...>::clear() {
+    WriteLock lock(lockPolicy); // Lock for thread-safety
+    clearUnlocked(Indices());
+    rowCount = 0;
+}
+
+/**
+ * @brief Remove all rows and release the memory of the columns.
+ */
+template <typename LockPolicy, typename... Fields>
+void BasicSoAVector<LockPolicy, Fields...>::releaseMemory() {
+    WriteLock lock(lockPolicy); // Lock for thread-safety
+    releaseUnlocked(Indices());
+    rowCount = 0;
+}
+
+/**
+ * @brief Shrink the columns to the rows in use, subject to the growth policy's shrink hysteresis.
+ *
+ * @return True if any column was shrunk.
+ */
+template <typename LockPolicy, typename... Fields>
+bool BasicSoAVector<LockPolicy, Fields...>::shrinkToFit() {
+    WriteLock lock(lockPolicy); // Lock for thread-safety
+    return shrinkUnlocked(Indices());
+}
+
+/**
+ * @brief Access a row of a non-const vector.
+ *
+ * @param index The index of the row.
+ * @return Proxy for the row.
+ *
+ * @throw IndexOutOfBoundsException if the index is out of bounds.
+ */
+template <typename LockPolicy, typename... Fields>
+typename BasicSoAVector<LockPolicy, Fields...>::RowReference BasicSoAVector<LockPolicy, Fields...>::operator[](size_t index) {
+    ReadLock lock(lockPolicy); // Shared lock for thread-safety
+    if (index >= rowCount) {
+        throw IndexOutOfBoundsException("Error: Index out of bounds.");
+    }
+    return RowReference(this, index);
+}
+
+/**
+ * @brief Access a row of a const vector.
+ *
+ * @param index The index of the row.
+ * @return Read-only proxy for the row.
+ *
+ * @throw IndexOutOfBoundsException if the index is out of bounds.
+ */
+template <typename LockPolicy, typename... Fields>
+typename BasicSoAVector<LockPolicy, Fields...>::ConstRowReference BasicSoAVector<LockPolicy, Fields...>::operator[](size_t index) const {
+    ReadLock lock(lockPolicy); // Shared lock for thread-safety
+    if (index >= rowCount) {
+        throw IndexOutOfBoundsException("Error: Index out of bounds.");
+    }
+    return ConstRowReference(this, index);
+}
+
+/**
+ * @brief Access a row without locking or bounds checking.
+ */
+template <typename LockPolicy, typename... Fields>
+typename BasicSoAVector<LockPolicy, Fields...>::RowReference BasicSoAVector<LockPolicy, Fields...>::at_unchecked(size_t index) {
+    return RowReference(this, index);
+}
+
+/**
+ * @brief Access a row without locking or bounds checking.
+ */
+template <typename LockPolicy, typename... Fields>
+typename BasicSoAVector<LockPolicy, Fields...>::ConstRowReference BasicSoAVector<LockPolicy, Fields...>::at_unchecked(size_t index) const {
+    return ConstRowReference(this, index);
+}
+
+/**
+ * @brief Get the last row.
+ *
+ * @throw IndexOutOfBoundsException if the vector is empty.
+ */
+template <typename LockPolicy, typename... Fields>
+typename BasicSoAVector<LockPolicy, Fields...>::RowReference BasicSoAVector<LockPolicy, Fields...>::back() {
+    ReadLock lock(lockPolicy); // Shared lock for thread-safety
+    if (rowCount == 0) {
+        throw IndexOutOfBoundsException("Array is empty.");
+    }
+    return RowReference(this, rowCount - 1);
+}
+
+/**
+ * @brief Get the first row.
+ *
+ * @throw IndexOutOfBoundsException if the vector is empty.
+ */
+template <typename LockPolicy, typename... Fields>
+typename BasicSoAVector<LockPolicy, Fields...>::RowReference BasicSoAVector<LockPolicy, Fields...>::front() {
+    ReadLock lock(lockPolicy); // Shared lock for thread-safety
+    if (rowCount == 0) {
+        throw IndexOutOfBoundsException("Array is empty.");
+    }
+    return RowReference(this, 0);
+}
+
+/**
+ * @brief Copy a row out of the vector while holding the lock.
+ *
+ * @param index The index of the row.
+ * @return A tuple of the fields of the row.
+ *
+ * @throw IndexOutOfBoundsException if the index is out of bounds.
+ */
+template <typename LockPolicy, typename... Fields>
+typename BasicSoAVector<LockPolicy, Fields...>::Row BasicSoAVector<LockPolicy, Fields...>::row(size_t index) const {
+    ReadLock lock(lockPolicy); // Shared lock for thread-safety
+    if (index >= rowCount) {
+        throw IndexOutOfBoundsException("Error: Index out of bounds.");
+    }
+    return rowUnlocked(Indices(), index);
+}
+
+/**
+ * @brief Get the capacity of the vector in rows, which is the capacity of its smallest column.
+ */
+template <typename LockPolicy, typename... Fields>
+size_t BasicSoAVector<LockPolicy, Fields...>::size() const {
+    ReadLock lock(lockPolicy); // Shared lock for thread-safety
+    return std::apply([](const Column<Fields>&... column) { return std::min({column.size()...}); }, columns);
+}
+
+/**
+ * @brief Get the number of rows.
+ */
+template <typename LockPolicy, typename... Fields>
+size_t BasicSoAVector<LockPolicy, Fields...>::elements() const {
+    ReadLock lock(lockPolicy); // Shared lock for thread-safety
+    return rowCount;
+}
+
+/**
+ * @brief Check if the vector is empty.
+ */
+template <typename LockPolicy, typename... Fields>
+bool BasicSoAVector<LockPolicy, Fields...>::isEmpty() const {
+    ReadLock lock(lockPolicy); // Shared lock for thread-safety
+    return rowCount == 0;
+}
+
+/**
+ * @brief Get the column of a field.
+ *
+ * @tparam I The index of the field.
+ * @return A span over the values of field I of every row.
+ */
+template <typename LockPolicy, typename... Fields>
+template <size_t I>
+ColumnSpan<typename BasicSoAVector<LockPolicy, Fields...>::template FieldType<I>> BasicSoAVector<LockPolicy, Fields...>::column() {
+    ReadLock lock(lockPolicy); // Shared lock for thread-safety
+    return ColumnSpan<FieldType<I>>(std::get<I>(columns).fields(), rowCount);
+}
+
+/**
+ * @brief Get the read-only column of a field.
+ *
+ * @tparam I The index of the field.
+ * @return A read-only span over the values of field I of every row.
+ */
+template <typename LockPolicy, typename... Fields>
+template <size_t I>
+ColumnSpan<const typename BasicSoAVector<LockPolicy, Fields...>::template FieldType<I>> BasicSoAVector<LockPolicy, Fields...>::column() const {
+    ReadLock lock(lockPolicy); // Shared lock for thread-safety
+    return ColumnSpan<const FieldType<I>>(std::get<I>(columns).fields(), rowCount);
+}
+
+template <typename LockPolicy, typename... Fields>
+typename BasicSoAVector<LockPolicy, Fields...>::iterator BasicSoAVector<LockPolicy, Fields...>::begin() {
+    return iterator(this, 0);
+}
+
+template <typename LockPolicy, typename... Fields>
+typename BasicSoAVector<LockPolicy, Fields...>::iterator BasicSoAVector<LockPolicy, Fields...>::end() {
+    return iterator(this, rowCount);
+}
+
+template <typename LockPolicy, typename... Fields>
+typename BasicSoAVector<LockPolicy, Fields...>::const_iterator BasicSoAVector<LockPolicy, Fields...>::begin() const {
+    return const_iterator(this, 0);
+}
+
+template <typename LockPolicy, typename... Fields>
+typename BasicSoAVector<LockPolicy, Fields...>::const_iterator BasicSoAVector<LockPolicy, Fields...>::end() const {
+    return const_iterator(this, rowCount);
+}
+
+template <typename LockPolicy, typename... Fields>
+typename BasicSoAVector<LockPolicy, Fields...>::const_iterator BasicSoAVector<LockPolicy, Fields...>::cbegin() const {
+    return begin();
+}
+
+template <typename LockPolicy, typename... Fields>
+typename BasicSoAVector<LockPolicy, Fields...>::const_iterator BasicSoAVector<LockPolicy, Fields...>::cend() const {
+    return end();
+}
+
+#endif // SOAVECTOR_H
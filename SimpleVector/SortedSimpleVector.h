@@ -0,0 +1,545 @@
+#ifndef SORTEDSIMPLEVECTOR_H
+#define SORTEDSIMPLEVECTOR_H
+
+#include "SimpleVector.h"
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <mutex>
+#include <shared_mutex>
+#include <type_traits>
+
+//==============================================================================|
+
+/**
+ * @brief A set of unique elements kept sorted in one contiguous SimpleVector (a flat set).
+ *
+ * @details Lookups are binary searches over contiguous memory, O(log n) with no pointer chasing, so they beat a
+ * node-based tree such as std::set on read-mostly data. A single insert or erase shifts the elements behind it and
+ * costs O(n). Many elements are best added with insertBatch, which appends them, sorts only the new tail and merges
+ * it into place in O(n + k log k). Union, intersection and difference of two sets run in linear time.
+ *
+ * Two elements a and b are considered equal when neither compares less than the other.
+ *
+ * @tparam T The type of the elements.
+ * @tparam Compare The strict weak ordering of the elements.
+ * @tparam LockPolicy The locking policy, see SimpleVector.
+ */
+template <typename T, typename Compare = std::less<T>, typename LockPolicy = MutexLockPolicy>
+class SortedSimpleVector {
+private:
+    /**
+     * @brief Element storage that lets the set drop duplicates from its tail in place.
+     */
+    class Storage : public SimpleVector<T, NoLockPolicy> {
+    public:
+        using SimpleVector<T, NoLockPolicy>::truncate;
+    };
+
+    Storage items; // The elements, sorted and unique
+    Compare compare; // Ordering of the elements
+    mutable LockPolicy lockPolicy; // Locking policy used for synchronization
+
+    typedef std::lock_guard<LockPolicy> WriteLock; // Exclusive lock for methods that modify the set
+    typedef std::shared_lock<LockPolicy> ReadLock; // Shared lock for read-only methods
+
+    // The private helpers below expect the caller to already hold the lock.
+    bool equivalent(const T& a, const T& b) const { return !compare(a, b) && !compare(b, a); }
+    size_t lowerBoundUnlocked(const T& value) const; // Index of the first element not less than value
+    ptrdiff_t findUnlocked(const T& value) const; // Index of the element equal to value, or -1
+    void mergeTail(size_t sortedCount); // Merge the unsorted elements past sortedCount into the sorted prefix
+    void eraseAt(size_t index); // Remove the element at index, keeping the order
+
+    template <typename Merge>
+    static SortedSimpleVector combine(const SortedSimpleVector& a, const SortedSimpleVector& b, Merge merge); // Build a set from two locked sets
+
+public:
+    typedef T value_type; // Define the element type
+    typedef typename SimpleVector<T, NoLockPolicy>::const_iterator const_iterator; // Define the const iterator type
+    typedef const_iterator iterator; // Elements cannot be modified in place, that could break the order
+
+    SortedSimpleVector(); // Default constructor
+    explicit SortedSimpleVector(const Compare& comp); // Constructor with a comparison object
+    SortedSimpleVector(std::initializer_list<T> initList, const Compare& comp = Compare()); // Constructor with initializer list, sorts and drops duplicates
+    template <typename OtherLockPolicy, typename OtherGrowthPolicy>
+    explicit SortedSimpleVector(const SimpleVector<T, OtherLockPolicy, OtherGrowthPolicy>& values, const Compare& comp = Compare()); // Constructor that sorts a copy of a vector
+    SortedSimpleVector(const SortedSimpleVector& other); // Copy constructor
+    SortedSimpleVector(SortedSimpleVector&& other) noexcept; // Move constructor
+
+    SortedSimpleVector& operator=(const SortedSimpleVector& other); // Copy assignment operator
+    SortedSimpleVector& operator=(SortedSimpleVector&& other) noexcept; // Move assignment operator
+
+    bool insert(const T& item); // Add an element unless an equal one is present
+    void insertBatch(const T* first, size_t n); // Add many elements with one merge
+    template <typename InputIt>
+    void insertBatch(InputIt first, InputIt last); // Add the elements of a range with one merge
+    bool erase(const T& item); // Remove the element equal to item
+    void clear(); // Remove all elements, keeping the capacity
+    void reserve(size_t n); // Make room for at least n elements
+    bool shrinkToFit(); // Shrink the capacity to the elements in use
+
+    bool contains(const T& element) const; // Check if an equal element is present
+    ptrdiff_t indexOf(const T& element) const; // Get the index of the equal element, or -1
+    size_t lower_bound(const T& value) const; // Get the index of the first element not less than value
+    size_t upper_bound(const T& value) const; // Get the index of the first element greater than value
+    const T& operator[](size_t index) const; // Get the element at the specified index
+    const T& front() const; // Get the smallest element
+    const T& back() const; // Get the largest element
+    const T* data() const; // Get a pointer to the sorted elements
+    size_t size() const; // Get the capacity
+    size_t elements() const; // Get the number of elements
+    bool isEmpty() const; // Check if the set is empty
+
+    static SortedSimpleVector setUnion(const SortedSimpleVector& a, const SortedSimpleVector& b); // Elements in either set
+    static SortedSimpleVector setIntersection(const SortedSimpleVector& a, const SortedSimpleVector& b); // Elements in both sets
+    static SortedSimpleVector setDifference(const SortedSimpleVector& a, const SortedSimpleVector& b); // Elements of a that are not in b
+
+    const_iterator begin() const; // Get an iterator pointing to the smallest element
+    const_iterator end() const; // Get an iterator pointing to one past the largest element
+    const_iterator cbegin() const; // Get an iterator pointing to the smallest element
+    const_iterator cend() const; // Get an iterator pointing to one past the largest element
+};
+
+//==============================================================================|
+
+/**
+ * @brief Constructs an empty SortedSimpleVector object.
+ */
+template <typename T, typename Compare, typename LockPolicy>
+SortedSimpleVector<T, Compare, LockPolicy>::SortedSimpleVector() : items(), compare() {
+}
+
+/**
+ * @brief Constructs an empty SortedSimpleVector object with a comparison object.
+ *
+ * @param comp The ordering of the elements.
+ */
+template <typename T, typename Compare, typename LockPolicy>
+SortedSimpleVector<T, Compare, LockPolicy>::SortedSimpleVector(const Compare& comp) : items(), compare(comp) {
+}
+
+/**
+ * @brief Constructs a SortedSimpleVector object from an initializer list.
+ *
+ * @param initList The elements, in any order. Duplicates are dropped.
+ * @param comp The ordering of the elements.
+ */
+template <typename T, typename Compare, typename LockPolicy>
+SortedSimpleVector<T, Compare, LockPolicy>::SortedSimpleVector(std::initializer_list<T> initList, const Compare& comp) : items(), compare(comp) {
+    items.append(initList.begin(), initList.end());
+    mergeTail(0);
+}
+
+/**
+ * @brief Constructs a SortedSimpleVector object from a copy of an existing vector.
+ *
+ * @param values The elements, in any order. Duplicates are dropped.
+ * @param comp The ordering of the elements.
+ */
+template <typename T, typename Compare, typename LockPolicy>
+template <typename OtherLockPolicy, typename OtherGrowthPolicy>
+SortedSimpleVector<T, Compare, LockPolicy>::SortedSimpleVector(const SimpleVector<T, OtherLockPolicy, OtherGrowthPolicy>& values, const Compare& comp)
+    : items(), compare(comp) {
+    items.append(values.begin(), values.end());
+    mergeTail(0);
+}
+
+/**
+ * @brief Constructs a SortedSimpleVector object by copying another one.
+ *
+ * @param other The set to copy.
+ */
+template <typename T, typename Compare, typename LockPolicy>
+SortedSimpleVector<T, Compare, LockPolicy>::SortedSimpleVector(const SortedSimpleVector& other) : items(), compare(other.compare) {
+    ReadLock otherLock(other.lockPolicy); // Hold the source steady while it is copied
+    items = other.items;
+}
+
+/**
+ * @brief Constructs a SortedSimpleVector object by taking over the elements of another one.
+ *
+ * @param other The set to move from. It is left empty.
+ */
+template <typename T, typename Compare, typename LockPolicy>
+SortedSimpleVector<T, Compare, LockPolicy>::SortedSimpleVector(SortedSimpleVector&& other) noexcept : items(), compare(other.compare) {
+    WriteLock otherLock(other.lockPolicy); // The source is modified, so take its exclusive lock
+    items = std::move(other.items);
+}
+
+/**
+ * @brief Replaces the contents of this set with a copy of another set.
+ *
+ * @details The copy is built before this set is locked, so the two locks are never held at the same time.
+ *
+ * @param other The set to copy.
+ * @return Reference to this set.
+ */
+template <typename T, typename Compare, typename LockPolicy>
+SortedSimpleVector<T, Compare, LockPolicy>& SortedSimpleVector<T, Compare, LockPolicy>::operator=(const SortedSimpleVector& other) {
+    if (this != &other) {
+        SortedSimpleVector copy(other);
+        WriteLock lock(lockPolicy); // Lock for thread-safety
+        items = std::move(copy.items);
+        compare = copy.compare;
+    }
+    return *this;
+}
+
+/**
+ * @brief Replaces the contents of this set by taking over the elements of another set.
+ *
+ * @param other The set to move from. It is left empty.
+ * @return Reference to this set.
+ */
+template <typename T, typename Compare, typename LockPolicy>
+SortedSimpleVector<T, Compare, LockPolicy>& SortedSimpleVector<T, Compare, LockPolicy>::operator=(SortedSimpleVector&& other) noexcept {
+    if (this != &other) {
+        SortedSimpleVector moved(std::move(other));
+        WriteLock lock(lockPolicy); // Lock for thread-safety
+        items = std::move(moved.items);
+        compare = moved.compare;
+    }
+    return *this;
+}
+
+/**
+ * @brief Get the index of the first element that is not less than value.
+ */
+template <typename T, typename Compare, typename LockPolicy>
+size_t SortedSimpleVector<T, Compare, LockPolicy>::lowerBoundUnlocked(const T& value) const {
+    return static_cast<size_t>(std::lower_bound(items.begin(), items.end(), value, compare) - items.begin());
+}
+
+/**
+ * @brief Get the index of the element equal to value, or -1 if there is none.
+ */
+template <typename T, typename Compare, typename LockPolicy>
+ptrdiff_t SortedSimpleVector<T, Compare, LockPolicy>::findUnlocked(const T& value) const {
+    size_t index = lowerBoundUnlocked(value);
+    if (index < items.elements() && !compare(value, items.at_unchecked(index))) {
+        return static_cast<ptrdiff_t>(index);
+    }
+    return -1;
+}
+
+/**
+ * @brief Merge the elements appended after the sorted prefix into it and drop duplicates.
+ *
+ * @details Only the k new elements are sorted, in O(k log k); the merge and the duplicate sweep are linear.
+ *
+ * @param sortedCount The length of the prefix that is already sorted and unique.
+ */
+template <typename T, typename Compare, typename LockPolicy>
+void SortedSimpleVector<T, Compare, LockPolicy>::mergeTail(size_t sortedCount) {
+    T* first = items.data();
+    T* middle = first + sortedCount;
+    T* last = first + items.elements();
+    if (middle == last) {
+        return;
+    }
+    std::sort(middle, last, compare);
+    std::inplace_merge(first, middle, last, compare);
+    T* unique = std::unique(first, last, [this](const T& a, const T& b) { return equivalent(a, b); });
+    items.truncate(static_cast<size_t>(unique - first));
+}
+
+/**
+ * @brief Remove the element at index, shifting the elements behind it down.
+ */
+template <typename T, typename Compare, typename LockPolicy>
+void SortedSimpleVector<T, Compare, LockPolicy>::eraseAt(size_t index) {
+    T* first = items.data();
+    std::move(first + index + 1, first + items.elements(), first + index);
+    items.truncate(items.elements() - 1);
+}
+
+/**
+ * @brief Add an element unless an equal one is already present.
+ *
+ * @details The element is appended and rotated into place, shifting the larger elements up by one.
+ *
+ * @param item The item to be added.
+ * @return True if the element was added, false if an equal element was already present.
+ */
+template <typename T, typename Compare, typename LockPolicy>
+bool SortedSimpleVector<T, Compare, LockPolicy>::insert(const T& item) {
+    WriteLock lock(lockPolicy); // Lock for thread-safety
+    size_t index = lowerBoundUnlocked(item);
+    if (index < items.elements() && !compare(item, items.at_unchecked(index))) {
+        return false;
+    }
+    items.push_back(item);
+    T* first = items.data();
+    std::rotate(first + index, first + items.elements() - 1, first + items.elements());
+    return true;
+}
+
+/**
+ * @brief Add many elements with a single merge.
+ *
+ * @param first Pointer to the first element to add. The elements may be in any order and contain duplicates.
+ * @param n The number of elements to add.
+ */
+template <typename T, typename Compare, typename LockPolicy>
+void SortedSimpleVector<T, Compare, LockPolicy>::insertBatch(const T* first, size_t n) {
+    WriteLock lock(lockPolicy); // Lock for thread-safety
+    size_t sortedCount = items.elements();
+    items.append(first, n);
+    mergeTail(sortedCount);
+}
+
+/**
+ * @brief Add the elements of a range with a single merge.
+ *
+ * @tparam InputIt The iterator type of the range. The elements may be in any order and contain duplicates.
+ */
+template <typename T, typename Compare, typename LockPolicy>
+template <typename InputIt>
+void SortedSimpleVector<T, Compare, LockPolicy>::insertBatch(InputIt first, InputIt last) {
+    WriteLock lock(lockPolicy); // Lock for thread-safety
+    size_t sortedCount = items.elements();
+    items.append(first, last);
+    mergeTail(sortedCount);
+}
+
+/**
+ * @brief Remove the element equal to item.
+ *
+ * @param item The item to be removed.
+ * @return True if an element was removed.
+ */
+template <typename T, typename Compare, typename LockPolicy>
+bool SortedSimpleVector<T, Compare, LockPolicy>::erase(const T& item) {
+    WriteLock lock(lockPolicy); // Lock for thread-safety
+    ptrdiff_t index = findUnlocked(item);
+    if (index == -1) {
+        return false;
+    }
+    eraseAt(static_cast<size_t>(index));
+    return true;
+}
+
+/**
+ * @brief Remove all elements, keeping the capacity.
+ */
+template <typename T, typename Compare, typename LockPolicy>
+void SortedSimpleVector<T, Compare, LockPolicy>::clear() {
+    WriteLock lock(lockPolicy); // Lock for thread-safety
+    items.clear();
+}
+
+/**
+ * @brief Make room for at least n elements.
+ */
+template <typename T, typename Compare, typename LockPolicy>
+void SortedSimpleVector<T, Compare, LockPolicy>::reserve(size_t n) {
+    WriteLock lock(lockPolicy); // Lock for thread-safety
+    items.reserve(n);
+}
+
+/**
+ * @brief Shrink the capacity to the elements in use, subject to the growth policy's shrink hysteresis.
+ *
+ * @return True if the storage was shrunk.
+ */
+template <typename T, typename Compare, typename LockPolicy>
+bool SortedSimpleVector<T, Compare, LockPolicy>::shrinkToFit() {
+    WriteLock lock(lockPolicy); // Lock for thread-safety
+    return items.shrinkToFit();
+}
+
+/**
+ * @brief Check if an equal element is present, in O(log n).
+ */
+template <typename T, typename Compare, typename LockPolicy>
+bool SortedSimpleVector<T, Compare, LockPolicy>::contains(const T& element) const {
+    ReadLock lock(lockPolicy); // Shared lock for thread-safety
+    return findUnlocked(element) != -1;
+}
+
+/**
+ * @brief Get the index of the equal element, in O(log n).
+ *
+ * @return The index, or -1 if no equal element is present.
+ */
+template <typename T, typename Compare, typename LockPolicy>
+ptrdiff_t SortedSimpleVector<T, Compare, LockPolicy>::indexOf(const T& element) const {
+    ReadLock lock(lockPolicy); // Shared lock for thread-safety
+    return findUnlocked(element);
+}
+
+/**
+ * @brief Get the index of the first element that is not less than value.
+ *
+ * @return The index, or elements() if every element is less than value.
+ */
+template <typename T, typename Compare, typename LockPolicy>
+size_t SortedSimpleVector<T, Compare, LockPolicy>::lower_bound(const T& value) const {
+    ReadLock lock(lockPolicy); // Shared lock for thread-safety
+    return lowerBoundUnlocked(value);
+}
+
+/**
+ * @brief Get the index of the first element that is greater than value.
+ *
+ * @return The index, or elements() if no element is greater than value.
+ */
+template <typename T, typename Compare, typename LockPolicy>
+size_t SortedSimpleVector<T, Compare, LockPolicy>::upper_bound(const T& value) const {
+    ReadLock lock(lockPolicy); // Shared lock for thread-safety
+    return static_cast<size_t>(std::upper_bound(items.begin(), items.end(), value, compare) - items.begin());
+}
+
+/**
+ * @brief Get the element at the specified index. Index 0 is the smallest element.
+ *
+ * @throw IndexOutOfBoundsException if the index is out of bounds.
+ */
+template <typename T, typename Compare, typename LockPolicy>
+const T& SortedSimpleVector<T, Compare, LockPolicy>::operator[](size_t index) const {
+    ReadLock lock(lockPolicy); // Shared lock for thread-safety
+    return static_cast<const Storage&>(items)[index];
+}
+
+/**
+ * @brief Get the smallest element.
+ *
+ * @throw IndexOutOfBoundsException if the set is empty.
+ */
+template <typename T, typename Compare, typename LockPolicy>
+const T& SortedSimpleVector<T, Compare, LockPolicy>::front() const {
+    ReadLock lock(lockPolicy); // Shared lock for thread-safety
+    if (items.isEmpty()) {
+        throw IndexOutOfBoundsException("Array is empty.");
+    }
+    return items.at_unchecked(0);
+}
+
+/**
+ * @brief Get the largest element.
+ *
+ * @throw IndexOutOfBoundsException if the set is empty.
+ */
+template <typename T, typename Compare, typename LockPolicy>
+const T& SortedSimpleVector<T, Compare, LockPolicy>::back() const {
+    ReadLock lock(lockPolicy); // Shared lock for thread-safety
+    if (items.isEmpty()) {
+        throw IndexOutOfBoundsException("Array is empty.");
+    }
+    return items.at_unchecked(items.elements() - 1);
+}
+
+/**
+ * @brief Get a pointer to the sorted elements. [data(), data() + elements()) is a valid range.
+ */
+template <typename T, typename Compare, typename LockPolicy>
+const T* SortedSimpleVector<T, Compare, LockPolicy>::data() const {
+    ReadLock lock(lockPolicy); // Shared lock for thread-safety
+    return items.data();
+}
+
+/**
+ * @brief Get the capacity of the set.
+ */
+template <typename T, typename Compare, typename LockPolicy>
+size_t SortedSimpleVector<T, Compare, LockPolicy>::size() const {
+    ReadLock lock(lockPolicy); // Shared lock for thread-safety
+    return items.size();
+}
+
+/**
+ * @brief Get the number of elements.
+ */
+template <typename T, typename Compare, typename LockPolicy>
+size_t SortedSimpleVector<T, Compare, LockPolicy>::elements() const {
+    ReadLock lock(lockPolicy); // Shared lock for thread-safety
+    return items.elements();
+}
+
+/**
+ * @brief Check if the set is empty.
+ */
+template <typename T, typename Compare, typename LockPolicy>
+bool SortedSimpleVector<T, Compare, LockPolicy>::isEmpty() const {
+    ReadLock lock(lockPolicy); // Shared lock for thread-safety
+    return items.isEmpty();
+}
+
+/**
+ * @brief Build a new set from two sets in one linear pass.
+ *
+ * @details Both sets are read-locked, in address order so that concurrent calls on the same pair cannot deadlock.
+ * The result uses the ordering of a.
+ *
+ * @param merge Callable that receives the two sorted ranges, the comparison and an output iterator.
+ */
+template <typename T, typename Compare, typename LockPolicy>
+template <typename Merge>
+SortedSimpleVector<T, Compare, LockPolicy> SortedSimpleVector<T, Compare, LockPolicy>::combine(const SortedSimpleVector& a, const SortedSimpleVector& b, Merge merge) {
+    SortedSimpleVector result(a.compare);
+    std::shared_lock<LockPolicy> firstLock(a.lockPolicy, std::defer_lock);
+    std::shared_lock<LockPolicy> secondLock(b.lockPolicy, std::defer_lock);
+    if (&a == &b) {
+        firstLock.lock();
+    } else if (std::less<const void*>()(&a, &b)) {
+        firstLock.lock();
+        secondLock.lock();
+    } else {
+        secondLock.lock();
+        firstLock.lock();
+    }
+    merge(a.items.begin(), a.items.end(), b.items.begin(), b.items.end(), std::back_inserter(result.items), a.compare);
+    return result;
+}
+
+/**
+ * @brief Get the elements that are in either set, in O(n + m).
+ */
+template <typename T, typename Compare, typename LockPolicy>
+SortedSimpleVector<T, Compare, LockPolicy> SortedSimpleVector<T, Compare, LockPolicy>::setUnion(const SortedSimpleVector& a, const SortedSimpleVector& b) {
+    return combine(a, b, [](auto first1, auto last1, auto first2, auto last2, auto out, const Compare& comp) {
+        std::set_union(first1, last1, first2, last2, out, comp);
+    });
+}
+
+/**
+ * @brief Get the elements that are in both sets, in O(n + m).
+ */
+template <typename T, typename Compare, typename LockPolicy>
+SortedSimpleVector<T, Compare, LockPolicy> SortedSimpleVector<T, Compare, LockPolicy>::setIntersection(const SortedSimpleVector& a, const SortedSimpleVector& b) {
+    return combine(a, b, [](auto first1, auto last1, auto first2, auto last2, auto out, const Compare& comp) {
+        std::set_intersection(first1, last1, first2, last2, out, comp);
+    });
+}
+
+/**
+ * @brief Get the elements of a that are not in b, in O(n + m).
+ */
+template <typename T, typename Compare, typename LockPolicy>
+SortedSimpleVector<T, Compare, LockPolicy> SortedSimpleVector<T, Compare, LockPolicy>::setDifference(const SortedSimpleVector& a, const SortedSimpleVector& b) {
+    return combine(a, b, [](auto first1, auto last1, auto first2, auto last2, auto out, const Compare& comp) {
+        std::set_difference(first1, last1, first2, last2, out, comp);
+    });
+}
+
+template <typename T, typename Compare, typename LockPolicy>
+typename SortedSimpleVector<T, Compare, LockPolicy>::const_iterator SortedSimpleVector<T, Compare, LockPolicy>::begin() const {
+    return static_cast<const Storage&>(items).begin();
+}
+
+template <typename T, typename Compare, typename LockPolicy>
+typename SortedSimpleVector<T, Compare, LockPolicy>::const_iterator SortedSimpleVector<T, Compare, LockPolicy>::end() const {
+    return static_cast<const Storage&>(items).end();
+}
+
+template <typename T, typename Compare, typename LockPolicy>
+typename SortedSimpleVector<T, Compare, LockPolicy>::const_iterator SortedSimpleVector<T, Compare, LockPolicy>::cbegin() const {
+    return begin();
+}
+
+template <typename T, typename Compare, typename LockPolicy>
+typename SortedSimpleVector<T, Compare, LockPolicy>::const_iterator SortedSimpleVector<T, Compare, LockPolicy>::cend() const {
+    return end();
+}
+
+#endif // SORTEDSIMPLEVECTOR_H
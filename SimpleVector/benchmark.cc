@@ -0,0 +1,413 @@
+#include "SimpleVector.h"
+#include "ConcurrentSimpleVector.h"
+#include "SnapshotSimpleVector.h"
+#include "MappedSimpleVector.h"
+#include "SoAVector.h"
+#include "SortedSimpleVector.h"
+#include "ParallelAlgorithms.h"
+#include <thread>
+#include <atomic>
+#include <vector>
+#include <set>
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <algorithm>
+#include <cmath>
+#include <functional>
+
+// Simple micro benchmarks for SimpleVector. Build the "simplevector_benchmark" target in Release mode and run it directly.
+
+static const unsigned int ELEMENTS = 1000000;
+static const int ROUNDS = 20;
+
+template <typename Func>
+double nanosecondsPerElement(Func func) {
+    auto start = std::chrono::steady_clock::now();
+    for (int round = 0; round < ROUNDS; round++) {
+        func();
+    }
+    auto stop = std::chrono::steady_clock::now();
+    double total = std::chrono::duration<double, std::nano>(stop - start).count();
+    return total / (static_cast<double>(ELEMENTS) * ROUNDS);
+}
+
+template <typename LockPolicy>
+void benchmarkLockPolicy(const std::string& name) {
+    SimpleVector<int, LockPolicy> vec;
+    for (unsigned int i = 0; i < ELEMENTS; i++) {
+        vec.push_back(static_cast<int>(i));
+    }
+
+    volatile long long sink = 0;
+    double indexed = nanosecondsPerElement([&]() {
+        long long sum = 0;
+        for (unsigned int i = 0; i < ELEMENTS; i++) {
+            sum += vec[i];
+        }
+        sink = sink + sum;
+    });
+
+    double pushed = nanosecondsPerElement([&]() {
+        SimpleVector<int, LockPolicy> scratch;
+        for (unsigned int i = 0; i < ELEMENTS; i++) {
+            scratch.push_back(static_cast<int>(i));
+        }
+    });
+
+    std::printf("%-24s operator[]: %6.2f ns/element   push_back: %6.2f ns/element\n", name.c_str(), indexed, pushed);
+}
+
+void benchmarkBatchAppend() {
+    SimpleVector<int> source;
+    for (unsigned int i = 0; i < ELEMENTS; i++) {
+        source.push_back(static_cast<int>(i));
+    }
+    const int* data = &source[0];
+
+    double looped = nanosecondsPerElement([&]() {
+        SimpleVector<int> target;
+        for (unsigned int i = 0; i < ELEMENTS; i++) {
+            target.push_back(data[i]);
+        }
+    });
+
+    double batched = nanosecondsPerElement([&]() {
+        SimpleVector<int> target;
+        target.append(data, ELEMENTS);
+    });
+
+    std::printf("%-24s push_back loop: %6.2f ns/element   append: %6.2f ns/element\n", "Batch ingestion", looped, batched);
+}
+
+void benchmarkSearchKernels() {
+    SimpleVector<int, NoLockPolicy> ids;
+    for (unsigned int i = 0; i < ELEMENTS; i++) {
+        ids.push_back(static_cast<int>(i));
+    }
+    const int* data = ids.data();
+    const int missing = -1;
+
+    volatile size_t sink = 0;
+    double scalarFind = nanosecondsPerElement([&]() { sink = sink + ScalarKernels<int>::find(data, ELEMENTS, missing); });
+    double simdFind = nanosecondsPerElement([&]() { sink = sink + SimdKernels<int>::find(data, ELEMENTS, missing); });
+    double scalarSum = nanosecondsPerElement([&]() { sink = sink + static_cast<size_t>(ScalarKernels<int>::sum(data, ELEMENTS)); });
+    double simdSum = nanosecondsPerElement([&]() { sink = sink + static_cast<size_t>(SimdKernels<int>::sum(data, ELEMENTS)); });
+
+    std::printf("%-24s find: scalar %6.3f simd %6.3f ns/element   sum: scalar %6.3f simd %6.3f ns/element (level %d)\n",
+        "Search kernels (int)", scalarFind, simdFind, scalarSum, simdSum, static_cast<int>(SimdSupport::level()));
+}
+
+template <typename Vector>
+double nanosecondsPerAppend(unsigned int threads) {
+    Vector vec;
+    unsigned int perThread = ELEMENTS / threads;
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> writers;
+    for (unsigned int t = 0; t < threads; t++) {
+        writers.emplace_back([&vec, perThread]() {
+            for (unsigned int i = 0; i < perThread; i++) {
+                vec.push_back(static_cast<int>(i));
+            }
+        });
+    }
+    for (auto& writer : writers) {
+        writer.join();
+    }
+    auto stop = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(stop - start).count() / (static_cast<double>(perThread) * threads);
+}
+
+void benchmarkConcurrentAppend() {
+    for (unsigned int threads = 1; threads <= 8; threads *= 2) {
+        double locked = nanosecondsPerAppend<SimpleVector<int>>(threads);
+        double lockFree = nanosecondsPerAppend<ConcurrentSimpleVector<int>>(threads);
+        std::printf("%u producer thread(s)       SimpleVector: %6.2f ns/element   ConcurrentSimpleVector: %6.2f ns/element\n",
+            threads, locked, lockFree);
+    }
+}
+
+template <typename Vector>
+double nanosecondsPerRead(Vector& vec, unsigned int threads) {
+    const unsigned int reads = ELEMENTS;
+    std::atomic<long long> sink(0);
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> readers;
+    for (unsigned int t = 0; t < threads; t++) {
+        readers.emplace_back([&vec, &sink, reads]() {
+            long long total = 0;
+            for (unsigned int i = 0; i < reads; i++) {
+                total += vec[i % 64];
+            }
+            sink += total;
+        });
+    }
+    for (auto& reader : readers) {
+        reader.join();
+    }
+    auto stop = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(stop - start).count() / (static_cast<double>(reads) * threads);
+}
+
+void benchmarkSnapshotReads() {
+    SimpleVector<int> mutexVec;
+    SimpleVector<int, SharedMutexLockPolicy> sharedVec;
+    SnapshotSimpleVector<int> snapshotVec;
+    for (int i = 0; i < 64; i++) {
+        mutexVec.push_back(i);
+        sharedVec.push_back(i);
+        snapshotVec.push_back(i);
+    }
+    for (unsigned int threads = 1; threads <= 8; threads *= 2) {
+        double mutexRead = nanosecondsPerRead(mutexVec, threads);
+        double sharedRead = nanosecondsPerRead(sharedVec, threads);
+        double snapshotRead = nanosecondsPerRead(snapshotVec, threads);
+        std::printf("%u reader thread(s)   Mutex: %6.2f ns/read   SharedMutex: %6.2f ns/read   Snapshot: %6.2f ns/read\n",
+            threads, mutexRead, sharedRead, snapshotRead);
+    }
+}
+
+template <typename GrowthPolicy>
+void benchmarkGrowthPolicy(const std::string& name) {
+    SimpleVector<int, NoLockPolicy, GrowthPolicy> vec;
+    double perElement = nanosecondsPerElement([&vec]() {
+        vec.clear();
+        for (unsigned int i = 0; i < ELEMENTS; i++) {
+            vec.push_back(static_cast<int>(i));
+        }
+    });
+    SimpleVectorStats stats = vec.stats();
+    std::printf("%-26s refill: %6.2f ns/element   reallocations: %zu   bytes copied: %zu   peak capacity: %zu\n",
+        name.c_str(), perElement, stats.reallocations, stats.bytesCopied, stats.peakCapacity);
+}
+
+void benchmarkRandomAccess() {
+    // 256 MiB of ints: far more pages than the TLB covers, unless they are huge pages.
+    const size_t n = size_t(64) << 20;
+    SimpleVector<int, NoLockPolicy> vec;
+    vec.reserve(n);
+    std::vector<int> plain;
+    plain.reserve(n);
+    for (size_t i = 0; i < n; i++) {
+        vec.push_back(static_cast<int>(i));
+        plain.push_back(static_cast<int>(i));
+    }
+    const unsigned int lookups = 20000000;
+    auto gather = [&](const int* data) {
+        unsigned long long state = 88172645463325252ull;
+        long long total = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (unsigned int i = 0; i < lookups; i++) {
+            state ^= state << 13;
+            state ^= state >> 7;
+            state ^= state << 17;
+            total += data[state % n];
+        }
+        auto stop = std::chrono::steady_clock::now();
+        std::printf("%s", total == 42 ? " " : "");
+        return std::chrono::duration<double, std::nano>(stop - start).count() / lookups;
+    };
+    double operatorNew = gather(plain.data());
+    double hugePages = gather(vec.data());
+    std::printf("Random reads over %zu MiB   std::vector: %6.2f ns/read   SimpleVector: %6.2f ns/read\n",
+        n * sizeof(int) >> 20, operatorNew, hugePages);
+}
+
+#ifdef SIMPLEVECTOR_HAS_MMAP
+void benchmarkMappedReopen() {
+    const char* path = "simplevector_benchmark.bin";
+    std::remove(path);
+    {
+        MappedSimpleVector<int, NoLockPolicy> mapped(path);
+        for (unsigned int i = 0; i < ELEMENTS; i++) {
+            mapped.push_back(static_cast<int>(i));
+        }
+    }
+    auto start = std::chrono::steady_clock::now();
+    SimpleVector<int, NoLockPolicy> rebuilt;
+    for (unsigned int i = 0; i < ELEMENTS; i++) {
+        rebuilt.push_back(static_cast<int>(i));
+    }
+    auto middle = std::chrono::steady_clock::now();
+    MappedSimpleVector<int, NoLockPolicy> reopened(path);
+    auto stop = std::chrono::steady_clock::now();
+    std::printf("Startup with %u elements   rebuild: %8.1f us   reopen mapped file: %8.1f us\n", ELEMENTS,
+        std::chrono::duration<double, std::micro>(middle - start).count(),
+        std::chrono::duration<double, std::micro>(stop - middle).count());
+    std::remove(path);
+}
+#endif
+
+void benchmarkBitVector() {
+    SimpleVector<bool, NoLockPolicy> packed, other;
+    std::vector<unsigned char> bytes, otherBytes;
+    for (unsigned int i = 0; i < ELEMENTS; i++) {
+        packed.push_back(i % 7 == 0);
+        other.push_back(i % 5 == 0);
+        bytes.push_back(i % 7 == 0);
+        otherBytes.push_back(i % 5 == 0);
+    }
+
+    volatile size_t sink = 0;
+    double byteCount = nanosecondsPerElement([&]() { sink = sink + std::count(bytes.begin(), bytes.end(), 1); });
+    double packedCount = nanosecondsPerElement([&]() { sink = sink + packed.popcount(); });
+    double byteAnd = nanosecondsPerElement([&]() {
+        for (unsigned int i = 0; i < ELEMENTS; i++) {
+            bytes[i] &= otherBytes[i];
+        }
+    });
+    double packedAnd = nanosecondsPerElement([&]() { packed &= other; });
+
+    std::printf("%-24s count: bytes %6.3f packed %6.3f ns/flag   and: bytes %6.3f packed %6.3f ns/flag (%zu vs %zu bytes)\n",
+        "SimpleVector<bool>", byteCount, packedCount, byteAnd, packedAnd, bytes.size(), packed.wordCount() * sizeof(uint64_t));
+}
+
+struct BenchmarkRecord {
+    int id;
+    double weight;
+    char name[48];
+};
+
+void benchmarkColumnScan() {
+    SimpleVector<BenchmarkRecord, NoLockPolicy> records;
+    SoAVector<int, double, std::string> table;
+    records.reserve(ELEMENTS);
+    table.reserve(ELEMENTS);
+    for (unsigned int i = 0; i < ELEMENTS; i++) {
+        BenchmarkRecord record = {static_cast<int>(i), i * 0.5, "record"};
+        records.push_back(record);
+        table.push_back(record.id, record.weight, record.name);
+    }
+
+    volatile long long sink = 0;
+    double rowScan = nanosecondsPerElement([&]() {
+        long long total = 0;
+        for (const BenchmarkRecord& record : records) {
+            total += record.id;
+        }
+        sink = sink + total;
+    });
+    double columnScan = nanosecondsPerElement([&]() { sink = sink + table.column<0>().sum(); });
+
+    std::printf("%-24s sum of one field: array of structs %6.3f   SoAVector column %6.3f ns/row\n",
+        "Column scan", rowScan, columnScan);
+}
+
+template <typename Buffer>
+void controlLoopCycles(const char* name) {
+    // Each cycle builds a fresh 256-sample buffer, as a control loop would; the worst cycle is the jitter that matters.
+    const int cycles = 100000;
+    double worst = 0;
+    double total = 0;
+    volatile int sink = 0;
+    for (int cycle = 0; cycle < cycles; cycle++) {
+        auto start = std::chrono::steady_clock::now();
+        {
+            Buffer samples;
+            for (int i = 0; i < 256; i++) {
+                samples.push_back(cycle + i);
+            }
+            sink = sink + samples[255];
+        }
+        double elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+        total += elapsed;
+        worst = std::max(worst, elapsed);
+    }
+    std::printf("%-26s mean cycle: %8.1f ns   worst cycle: %10.1f ns\n", name, total / cycles, worst);
+}
+
+void benchmarkStaticVector() {
+    controlLoopCycles<SimpleVector<int, NoLockPolicy>>("SimpleVector cycle");
+    controlLoopCycles<StaticSimpleVector<int, 256>>("StaticSimpleVector cycle");
+}
+
+void benchmarkSortedLookups() {
+    const int ids = 100000;
+    const int lookups = 1000000;
+    SortedSimpleVector<int, std::less<int>, NoLockPolicy> flat;
+    std::set<int> tree;
+    std::vector<int> batch;
+    for (int i = 0; i < ids; i++) {
+        batch.push_back(i * 3);
+        tree.insert(i * 3);
+    }
+    flat.insertBatch(batch.begin(), batch.end());
+
+    auto probe = [&](auto contains) {
+        unsigned int state = 12345;
+        size_t hits = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < lookups; i++) {
+            state = state * 1664525u + 1013904223u;
+            hits += contains(static_cast<int>(state % (3u * ids)));
+        }
+        auto stop = std::chrono::steady_clock::now();
+        std::printf("%s", hits == 42 ? " " : "");
+        return std::chrono::duration<double, std::nano>(stop - start).count() / lookups;
+    };
+    double flatTime = probe([&](int id) { return flat.contains(id); });
+    double treeTime = probe([&](int id) { return tree.count(id) != 0; });
+    std::printf("%-26s contains over %d ids: SortedSimpleVector %6.1f   std::set %6.1f ns/lookup\n",
+        "Sorted lookups", ids, flatTime, treeTime);
+}
+
+void benchmarkParallelAlgorithms() {
+    const size_t n = size_t(16) << 20;
+    SimpleVector<float, NoLockPolicy> values;
+    values.reserve(n);
+    for (size_t i = 0; i < n; i++) {
+        values.push_back(static_cast<float>(i % 1000) * 0.001f);
+    }
+    auto time = [n](auto body) {
+        auto start = std::chrono::steady_clock::now();
+        body();
+        return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / n;
+    };
+    volatile double sink = 0;
+    auto heavy = [](float value) { return std::sqrt(value) * std::sin(value) + std::cos(value); };
+    SimpleVector<float, NoLockPolicy> out;
+    out.reserve(n);
+
+    double serialTransform = time([&]() {
+        out.clear();
+        for (float value : values) {
+            out.push_back(heavy(value));
+        }
+    });
+    double parallelTransform = time([&]() { parallel_transform(values, out, heavy); });
+    double serialReduce = time([&]() {
+        double total = 0;
+        for (float value : values) {
+            total += value;
+        }
+        sink = sink + total;
+    });
+    double parallelReduce = time([&]() { sink = sink + parallel_reduce(values, 0.0, [](double total, float value) { return total + value; }, std::plus<double>()); });
+
+    std::printf("%-26s transform: serial %6.3f parallel %6.3f   reduce: serial %6.3f parallel %6.3f ns/element (%zu threads)\n",
+        "Parallel algorithms", serialTransform, parallelTransform, serialReduce, parallelReduce, ParallelThreadPool::instance().threadCount());
+}
+
+int main() {
+    std::printf("Lock policy cost (%u elements, %d rounds)\n", ELEMENTS, ROUNDS);
+    benchmarkLockPolicy<NoLockPolicy>("NoLockPolicy");
+    benchmarkLockPolicy<MutexLockPolicy>("MutexLockPolicy");
+    benchmarkLockPolicy<SharedMutexLockPolicy>("SharedMutexLockPolicy");
+    benchmarkBatchAppend();
+    benchmarkSearchKernels();
+    benchmarkBitVector();
+    benchmarkColumnScan();
+    benchmarkConcurrentAppend();
+    benchmarkSnapshotReads();
+    benchmarkGrowthPolicy<DoublingGrowthPolicy>("DoublingGrowthPolicy");
+    benchmarkGrowthPolicy<OneAndAHalfGrowthPolicy>("OneAndAHalfGrowthPolicy");
+    benchmarkGrowthPolicy<FixedGrowthPolicy<65536>>("FixedGrowthPolicy<65536>");
+    benchmarkStaticVector();
+    benchmarkSortedLookups();
+    benchmarkParallelAlgorithms();
+    benchmarkRandomAccess();
+#ifdef SIMPLEVECTOR_HAS_MMAP
+    benchmarkMappedReopen();
+#endif
+    return 0;
+}
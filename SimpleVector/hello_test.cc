@@ -1,6 +1,24 @@
 #include <gtest/gtest.h>
 #include "SimpleVector.h" // Make sure this path is correct
+#include "SmallSimpleVector.h"
+#include "ConcurrentSimpleVector.h"
+#include "SnapshotSimpleVector.h"
+#include "MappedSimpleVector.h"
+#include "SoAVector.h"
+#include "SortedSimpleVector.h"
+#include "ParallelAlgorithms.h"
 #include <string>
+#include <thread>
+#include <atomic>
+#include <vector>
+#include <memory>
+#include <sstream>
+#include <iterator>
+#include <algorithm>
+#include <limits>
+#include <cstdio>
+#include <numeric>
+#include <functional>
 
 class SimpleVectorTest : public ::testing::Test {
 protected:
@@ -41,9 +59,10 @@ TEST_F(SimpleVectorTest, CopyConstructor) {
 
     // Test copying an empty vector
     SimpleVector<int> emptyVector;
-    EXPECT_THROW({
-        SimpleVector<int> copiedEmptyVector(emptyVector);
-    }, SimpleVectorException);
+    SimpleVector<int> copiedEmptyVector(emptyVector);
+    EXPECT_TRUE(copiedEmptyVector.isEmpty());
+    copiedEmptyVector.push_back(7);
+    EXPECT_EQ(copiedEmptyVector[0], 7);
 
     // Test copying a vector at full capacity
     SimpleVector<int> fullVector(2);
@@ -108,6 +127,123 @@ TEST_F(SimpleVectorTest, EmplaceBack) {
     EXPECT_EQ((*intVector)[0], 1);
 }
 
+TEST_F(SimpleVectorTest, EmplaceBackReturnsReference) {
+    std::string& inserted = stringVector->emplace_back(3, 'x');
+    EXPECT_EQ(inserted, "xxx");
+    inserted += "y";
+    EXPECT_EQ((*stringVector)[0], "xxxy");
+}
+
+TEST_F(SimpleVectorTest, MoveConstructor) {
+    stringVector->push_back("Hello");
+    stringVector->push_back("World");
+    SimpleVector<std::string> moved(std::move(*stringVector));
+    EXPECT_EQ(moved.elements(), 2);
+    EXPECT_EQ(moved[1], "World");
+    EXPECT_TRUE(stringVector->isEmpty());
+
+    // The moved-from vector can be reused
+    stringVector->push_back("Again");
+    EXPECT_EQ((*stringVector)[0], "Again");
+}
+
+TEST_F(SimpleVectorTest, CopyAndMoveAssignment) {
+    intVector->bulk_add(1, 2, 3);
+    SimpleVector<int> copied;
+    copied.push_back(99);
+    copied = *intVector;
+    EXPECT_EQ(copied.elements(), 3);
+    EXPECT_EQ(copied[2], 3);
+
+    SimpleVector<int> moved;
+    moved = std::move(copied);
+    EXPECT_EQ(moved.elements(), 3);
+    EXPECT_EQ(moved[0], 1);
+    EXPECT_TRUE(copied.isEmpty());
+}
+
+TEST_F(SimpleVectorTest, PushBackRvalue) {
+    std::string value(100, 'a');
+    stringVector->push_back(std::move(value));
+    EXPECT_EQ((*stringVector)[0].size(), 100);
+}
+
+TEST(SimpleVectorMoveOnlyTest, HoldsMoveOnlyType) {
+    SimpleVector<std::unique_ptr<int>> vec;
+    for (int i = 0; i < 10; i++) {
+        vec.push_back(std::unique_ptr<int>(new int(i)));
+    }
+    std::unique_ptr<int>& last = vec.emplace_back(new int(10));
+    EXPECT_EQ(*last, 10);
+    EXPECT_EQ(vec.elements(), 11);
+    EXPECT_EQ(*vec[5], 5);
+
+    SimpleVector<std::unique_ptr<int>> moved(std::move(vec));
+    EXPECT_EQ(*moved[10], 10);
+}
+
+TEST_F(SimpleVectorTest, Reserve) {
+    intVector->reserve(100);
+    EXPECT_EQ(intVector->size(), 100);
+    EXPECT_TRUE(intVector->isEmpty());
+    intVector->reserve(10);
+    EXPECT_EQ(intVector->size(), 100);
+}
+
+TEST_F(SimpleVectorTest, AppendArray) {
+    int values[] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+    intVector->push_back(0);
+    intVector->append(values, 10);
+    EXPECT_EQ(intVector->elements(), 11);
+    EXPECT_EQ((*intVector)[0], 0);
+    EXPECT_EQ((*intVector)[10], 10);
+
+    // Appending a vector to itself must read the old elements before they are moved.
+    intVector->append(&(*intVector)[0], intVector->elements());
+    EXPECT_EQ(intVector->elements(), 22);
+    EXPECT_EQ((*intVector)[11], 0);
+    EXPECT_EQ((*intVector)[21], 10);
+}
+
+TEST_F(SimpleVectorTest, AppendRange) {
+    std::vector<std::string> words = {"alpha", "beta", "gamma", "delta", "epsilon"};
+    stringVector->append(words.begin(), words.end());
+    EXPECT_EQ(stringVector->elements(), 5);
+    EXPECT_EQ((*stringVector)[4], "epsilon");
+
+    stringVector->append(&(*stringVector)[0], 5);
+    EXPECT_EQ(stringVector->elements(), 10);
+    EXPECT_EQ((*stringVector)[5], "alpha");
+
+    std::istringstream input("zeta eta");
+    stringVector->append(std::istream_iterator<std::string>(input), std::istream_iterator<std::string>());
+    EXPECT_EQ(stringVector->elements(), 12);
+    EXPECT_EQ((*stringVector)[11], "eta");
+}
+
+TEST_F(SimpleVectorTest, InsertRange) {
+    intVector->bulk_add(1, 5);
+    int middle[] = {2, 3, 4};
+    intVector->insert(1, middle, 3);
+    std::vector<int> tail = {6, 7};
+    intVector->insert(intVector->elements(), tail.begin(), tail.end());
+    std::vector<int> head = {0};
+    intVector->insert(0, head.begin(), head.end());
+    ASSERT_EQ(intVector->elements(), 8);
+    for (unsigned int i = 0; i < 8; i++) {
+        EXPECT_EQ((*intVector)[i], static_cast<int>(i));
+    }
+    EXPECT_THROW(intVector->insert(9, middle, 3), SimpleVectorException);
+}
+
+TEST_F(SimpleVectorTest, BulkAddOwnElementWhileGrowing) {
+    stringVector->bulk_add("a", "b", "c", "d");
+    stringVector->bulk_add((*stringVector)[0], (*stringVector)[3]);
+    EXPECT_EQ(stringVector->elements(), 6);
+    EXPECT_EQ((*stringVector)[4], "a");
+    EXPECT_EQ((*stringVector)[5], "d");
+}
+
 TEST_F(SimpleVectorTest, FrontAndBack) {
     intVector->push_back(1);
     intVector->push_back(2);
@@ -165,6 +301,49 @@ TEST_F(SimpleVectorTest, Iterator) {
     EXPECT_EQ(sum, 6);
 }
 
+TEST_F(SimpleVectorTest, RandomAccessIterator) {
+    intVector->bulk_add(5, 3, 9, 1, 7);
+    std::sort(intVector->begin(), intVector->end());
+    EXPECT_EQ((*intVector)[0], 1);
+    EXPECT_EQ((*intVector)[4], 9);
+
+    SimpleVector<int>::iterator it = intVector->begin();
+    EXPECT_EQ(intVector->end() - it, 5);
+    EXPECT_EQ(*(it + 2), 5);
+    EXPECT_EQ(it[3], 7);
+    it += 4;
+    EXPECT_EQ(*it--, 9);
+    EXPECT_EQ(*it, 7);
+    EXPECT_TRUE(intVector->begin() < it);
+
+    auto found = std::lower_bound(intVector->begin(), intVector->end(), 6);
+    EXPECT_EQ(found - intVector->begin(), 3);
+
+    int reversed[5];
+    std::reverse_copy(intVector->begin(), intVector->end(), reversed);
+    EXPECT_EQ(reversed[0], 9);
+}
+
+TEST_F(SimpleVectorTest, ConstIteratorAndData) {
+    intVector->bulk_add(1, 2, 3);
+    const SimpleVector<int>& constVector = *intVector;
+    int sum = 0;
+    for (const int& value : constVector) {
+        sum += value;
+    }
+    EXPECT_EQ(sum, 6);
+    static_assert(std::is_same<decltype(*constVector.begin()), const int&>::value, "const begin must yield const elements");
+    static_assert(std::is_same<decltype(*intVector->cbegin()), const int&>::value, "cbegin must yield const elements");
+
+    SimpleVector<int>::const_iterator converted = intVector->begin();
+    EXPECT_TRUE(converted == constVector.cbegin());
+
+    EXPECT_EQ(intVector->data(), &(*intVector)[0]);
+    intVector->data()[1] = 20;
+    EXPECT_EQ(intVector->at_unchecked(1), 20);
+    EXPECT_EQ(constVector.at_unchecked(2), 3);
+}
+
 TEST_F(SimpleVectorTest, OutOfBoundsAccess) {
     EXPECT_THROW(intVector->get(0), IndexOutOfBoundsException);
 }
@@ -182,4 +361,1028 @@ TEST_F(SimpleVectorTest, StringVector) {
     EXPECT_EQ(stringVector->elements(), 2);
     EXPECT_EQ((*stringVector)[0], "Hello");
     EXPECT_EQ((*stringVector)[1], "World");
-}
\ No newline at end of file
+}
+
+// Counts live instances so tests can check that the vector constructs and destroys exactly what it holds.
+struct LifetimeTracker {
+    static int live;
+    static int copies;
+    int value;
+
+    explicit LifetimeTracker(int v) : value(v) { live++; }
+    LifetimeTracker(const LifetimeTracker& other) : value(other.value) { live++; copies++; }
+    LifetimeTracker(LifetimeTracker&& other) noexcept : value(other.value) { live++; }
+    LifetimeTracker& operator=(const LifetimeTracker& other) { value = other.value; copies++; return *this; }
+    LifetimeTracker& operator=(LifetimeTracker&& other) noexcept { value = other.value; return *this; }
+    ~LifetimeTracker() { live--; }
+
+    bool operator==(const LifetimeTracker& other) const { return value == other.value; }
+};
+int LifetimeTracker::live = 0;
+int LifetimeTracker::copies = 0;
+
+TEST(SimpleVectorStorageTest, ConstructsOnlyLiveElements) {
+    LifetimeTracker::live = 0;
+    LifetimeTracker::copies = 0;
+    {
+        SimpleVector<LifetimeTracker> vec;
+        EXPECT_EQ(LifetimeTracker::live, 0);
+        for (int i = 0; i < 100; i++) {
+            LifetimeTracker item(i);
+            vec.push_back(item);
+        }
+        EXPECT_EQ(LifetimeTracker::live, 100);
+        // One copy per push_back; growth must move instead of copying.
+        EXPECT_EQ(LifetimeTracker::copies, 100);
+        EXPECT_EQ(vec[99].value, 99);
+
+        vec.remove(LifetimeTracker(50));
+        EXPECT_EQ(LifetimeTracker::live, 99);
+
+        vec.shrinkToFit();
+        EXPECT_EQ(LifetimeTracker::live, 99);
+
+        vec.clear();
+        EXPECT_EQ(LifetimeTracker::live, 0);
+
+        vec.push_back(LifetimeTracker(1));
+        vec.push_back(LifetimeTracker(2));
+    }
+    EXPECT_EQ(LifetimeTracker::live, 0);
+}
+
+TEST(SimpleVectorStorageTest, PushBackOwnElementWhileGrowing) {
+    SimpleVector<std::string> vec(1);
+    vec.push_back("first");
+    vec.push_back(vec[0]);
+    EXPECT_EQ(vec.elements(), 2);
+    EXPECT_EQ(vec[1], "first");
+}
+
+TEST(SimpleVectorStorageTest, PushBackAfterReleaseMemory) {
+    SimpleVector<int> vec;
+    vec.push_back(1);
+    vec.releaseMemory();
+    vec.push_back(2);
+    EXPECT_EQ(vec.elements(), 1);
+    EXPECT_EQ(vec[0], 2);
+}
+
+TEST(SimpleVectorStorageTest, SizesAre64Bit) {
+    SimpleVector<int> vec{1, 2, 3};
+    static_assert(std::is_same<decltype(vec.elements()), size_t>::value, "element counts are size_t");
+    static_assert(std::is_same<decltype(vec.indexOf(1)), ptrdiff_t>::value, "indexOf returns ptrdiff_t");
+    size_t index = 2;
+    EXPECT_EQ(vec[index], 3);
+    EXPECT_EQ(vec.indexOf(4), -1);
+    EXPECT_THROW(vec.reserve(std::numeric_limits<size_t>::max()), SimpleVectorException);
+}
+
+TEST(SimpleVectorStorageTest, LargeArraysUseHugePages) {
+    // 16 MiB of ints, above the default huge page threshold.
+    const size_t n = size_t(4) << 20;
+    SimpleVector<int, NoLockPolicy> vec;
+    vec.reserve(n);
+#ifdef SIMPLEVECTOR_HUGE_PAGES
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(vec.data()) % HugePages::HUGE_PAGE_SIZE, 0u);
+#endif
+    for (size_t i = 0; i < n; i++) {
+        vec.push_back(static_cast<int>(i));
+    }
+    vec.push_back(-1); // Grows from one mapping to the next
+    EXPECT_EQ(vec.elements(), n + 1);
+    EXPECT_EQ(vec[n - 1], static_cast<int>(n - 1));
+    EXPECT_EQ(vec.indexOf(-1), static_cast<ptrdiff_t>(n));
+    SimpleVector<int, NoLockPolicy> copy(vec);
+    EXPECT_EQ(copy[12345], 12345);
+    vec.clear();
+    EXPECT_TRUE(vec.isEmpty());
+}
+
+struct TriplingGrowthPolicy : GrowthPolicyBase {
+    static size_t grow(size_t capacity) { return capacity == 0 ? 1 : capacity * 3; }
+};
+
+template <typename GrowthPolicy>
+std::vector<size_t> capacitiesWhileFilling(size_t n) {
+    SimpleVector<int, NoLockPolicy, GrowthPolicy> vec;
+    std::vector<size_t> capacities{vec.size()};
+    for (size_t i = 0; i < n; i++) {
+        vec.push_back(static_cast<int>(i));
+        if (vec.size() != capacities.back()) {
+            capacities.push_back(vec.size());
+        }
+    }
+    return capacities;
+}
+
+TEST(SimpleVectorGrowthTest, GrowthPolicies) {
+    EXPECT_EQ(capacitiesWhileFilling<DoublingGrowthPolicy>(20), std::vector<size_t>({4, 8, 16, 32}));
+    EXPECT_EQ(capacitiesWhileFilling<OneAndAHalfGrowthPolicy>(20), std::vector<size_t>({4, 6, 9, 13, 19, 28}));
+    EXPECT_EQ(capacitiesWhileFilling<FixedGrowthPolicy<5>>(20), std::vector<size_t>({4, 9, 14, 19, 24}));
+    EXPECT_EQ(capacitiesWhileFilling<TriplingGrowthPolicy>(20), std::vector<size_t>({4, 12, 36}));
+}
+
+// Written without a special case for 0, so it does not grow an empty vector
+struct PlainDoublingGrowthPolicy : GrowthPolicyBase {
+    static size_t grow(size_t capacity) { return capacity * 2; }
+};
+
+TEST(SimpleVectorGrowthTest, PolicyThatCannotGrowFromZero) {
+    typedef SimpleVector<int, NoLockPolicy, PlainDoublingGrowthPolicy> Vector;
+    Vector vec;
+    vec.releaseMemory();
+    EXPECT_EQ(vec.size(), 0u);
+    for (int i = 0; i < 10; i++) {
+        vec.push_back(i);
+    }
+    EXPECT_EQ(vec.size(), 16u); // 0 -> 4 -> 8 -> 16
+    EXPECT_EQ(vec[9], 9);
+
+    Vector moved(std::move(vec));
+    vec.push_back(1);
+    EXPECT_EQ(vec.elements(), 1u);
+    Vector released;
+    released.releaseMemory();
+    Vector emptyCopy(released);
+    emptyCopy.push_back(2);
+    EXPECT_EQ(emptyCopy[0], 2);
+}
+
+TEST(SimpleVectorGrowthTest, ClearKeepsCapacity) {
+    SimpleVector<int> vec;
+    for (int frame = 0; frame < 10; frame++) {
+        for (int i = 0; i < 1000; i++) {
+            vec.push_back(i);
+        }
+        vec.clear();
+    }
+    SimpleVectorStats stats = vec.stats();
+    EXPECT_EQ(stats.reallocations, 8u); // 4 -> 1024 during the first frame only
+    EXPECT_EQ(stats.peakCapacity, 1024u);
+    EXPECT_EQ(stats.bytesCopied, (4 + 8 + 16 + 32 + 64 + 128 + 256 + 512) * sizeof(int));
+    EXPECT_EQ(vec.size(), 1024u);
+
+    vec.resetStats();
+    EXPECT_EQ(vec.stats().reallocations, 0u);
+    EXPECT_EQ(vec.stats().peakCapacity, 1024u);
+    vec.releaseMemory();
+    EXPECT_EQ(vec.stats().peakCapacity, 1024u);
+}
+
+TEST(SimpleVectorGrowthTest, ShrinkHysteresis) {
+    SimpleVector<int> vec;
+    vec.reserve(100);
+    for (int i = 0; i < 90; i++) {
+        vec.push_back(i);
+    }
+    EXPECT_FALSE(vec.shrinkToFit()); // 10% unused is not worth a reallocation
+    EXPECT_EQ(vec.size(), 100u);
+    for (int i = 0; i < 40; i++) {
+        vec.remove(i);
+    }
+    EXPECT_TRUE(vec.shrinkToFit());
+    EXPECT_EQ(vec.size(), 50u);
+    EXPECT_EQ(vec[0], 40);
+}
+
+TEST(SimpleVectorBoolTest, PackedStorage) {
+    SimpleVector<bool> flags;
+    for (int i = 0; i < 130; i++) {
+        flags.push_back(i % 3 == 0);
+    }
+    EXPECT_EQ(flags.elements(), 130u);
+    EXPECT_EQ(flags.wordCount(), 3u);
+    EXPECT_TRUE(flags[0]);
+    EXPECT_FALSE(flags[1]);
+    flags[1] = true;
+    flags[129].flip();
+    EXPECT_TRUE(flags[1]);
+    EXPECT_FALSE(flags.back()); // 129 is a multiple of 3, so the flip cleared it
+    EXPECT_THROW(flags[130], IndexOutOfBoundsException);
+
+    const SimpleVector<bool>& view = flags;
+    std::vector<bool> copied(view.begin(), view.end());
+    EXPECT_EQ(copied.size(), 130u);
+    EXPECT_TRUE(copied[1]);
+    for (SimpleVector<bool>::reference flag : flags) {
+        flag = !flag;
+    }
+    EXPECT_FALSE(flags[0]);
+    EXPECT_EQ(std::count(view.begin(), view.end(), true), 130 - 43 - 1);
+
+    bool raw[100];
+    for (int i = 0; i < 100; i++) {
+        raw[i] = i >= 50;
+    }
+    SimpleVector<bool> appended = {true};
+    appended.append(raw, 100);
+    EXPECT_EQ(appended.elements(), 101u);
+    EXPECT_EQ(appended.count(true), 51u);
+    EXPECT_EQ(appended.indexOf(false), 1);
+}
+
+TEST(SimpleVectorBoolTest, FindAndCount) {
+    SimpleVector<bool> flags;
+    for (int i = 0; i < 1000; i++) {
+        flags.push_back(i % 100 == 7);
+    }
+    EXPECT_EQ(flags.popcount(), 10u);
+    EXPECT_EQ(flags.count(false), 990u);
+
+    std::vector<ptrdiff_t> found;
+    for (ptrdiff_t i = flags.findFirstSet(); i != -1; i = flags.findNextSet(i)) {
+        found.push_back(i);
+    }
+    ASSERT_EQ(found.size(), 10u);
+    EXPECT_EQ(found.front(), 7);
+    EXPECT_EQ(found.back(), 907);
+
+    flags.flip();
+    EXPECT_EQ(flags.popcount(), 990u);
+    EXPECT_EQ(flags.indexOf(false), 7);
+    flags.remove(false);
+    EXPECT_EQ(flags.elements(), 990u);
+    EXPECT_FALSE(flags.contains(false));
+    flags.remove(true);
+    EXPECT_TRUE(flags.isEmpty());
+    EXPECT_EQ(flags.findFirstSet(), -1);
+}
+
+TEST(SimpleVectorBoolTest, BitwiseOperations) {
+    SimpleVector<bool> evens, thirds;
+    for (int i = 0; i < 600; i++) {
+        evens.push_back(i % 2 == 0);
+        thirds.push_back(i % 3 == 0);
+    }
+    EXPECT_EQ((evens & thirds).popcount(), 100u);
+    EXPECT_EQ((evens | thirds).popcount(), 400u);
+    EXPECT_EQ((evens ^ thirds).popcount(), 300u);
+    thirds ^= thirds;
+    EXPECT_EQ(thirds.popcount(), 0u);
+    thirds.push_back(true);
+    EXPECT_THROW(evens &= thirds, SimpleVectorException);
+
+    SmallSimpleVector<bool, 100> small = {true, false, true};
+    EXPECT_EQ(small.inlineSize(), 128u);
+    EXPECT_TRUE(small.isInline());
+    for (int i = 0; i < 200; i++) {
+        small.push_back(true);
+    }
+    EXPECT_FALSE(small.isInline());
+    EXPECT_EQ(small.popcount(), 202u);
+    small.remove(true);
+    EXPECT_TRUE(small.shrinkToFit());
+    EXPECT_TRUE(small.isInline());
+    EXPECT_FALSE(small[0]);
+}
+
+TEST(SoAVectorTest, RowProxies) {
+    SoAVector<int, std::string, double> table;
+    for (int i = 0; i < 100; i++) {
+        table.push_back(i, std::to_string(i), i * 0.5);
+    }
+    table.push_back(std::make_tuple(100, std::string("last"), 50.0));
+    EXPECT_EQ(table.elements(), 101u);
+    EXPECT_EQ(table[7].get<1>(), "7");
+    table[7].get<0>() = -7;
+    table[8] = std::make_tuple(80, std::string("eighty"), 4.0);
+    EXPECT_EQ(std::get<0>(table.row(7)), -7);
+    EXPECT_EQ(table[8].get<1>(), "eighty");
+    EXPECT_EQ(table.back().get<1>(), "last");
+    EXPECT_THROW(table[101], IndexOutOfBoundsException);
+
+    const SoAVector<int, std::string, double>& view = table;
+    double total = 0;
+    for (auto row : view) {
+        total += row.get<2>();
+    }
+    EXPECT_DOUBLE_EQ(total, 99 * 100 / 4.0 + 50.0);
+
+    SoAVector<int, std::string, double> copy(table);
+    table.clear();
+    EXPECT_TRUE(table.isEmpty());
+    EXPECT_EQ(copy.elements(), 101u);
+    EXPECT_EQ(copy[100].get<0>(), 100);
+}
+
+TEST(SoAVectorTest, ColumnSpans) {
+    SoAVector<int, float, char> table(1000);
+    for (int i = 0; i < 1000; i++) {
+        table.push_back(i, static_cast<float>(i % 10), static_cast<char>('a' + i % 26));
+    }
+    ColumnSpan<int> ids = table.column<0>();
+    ASSERT_EQ(ids.size(), 1000u);
+    EXPECT_EQ(ids.sum(), 999 * 1000 / 2);
+    EXPECT_EQ(ids.indexOf(500), 500);
+    EXPECT_EQ(ids.indexOf(-1), -1);
+    ids[0] = 5000;
+    EXPECT_EQ(table[0].get<0>(), 5000);
+    EXPECT_EQ(ids.max(), 5000);
+
+    const SoAVector<int, float, char>& view = table;
+    ColumnSpan<const float> weights = view.column<1>();
+    EXPECT_EQ(weights.countOf(3.0f), 100u);
+    EXPECT_FLOAT_EQ(weights.max(), 9.0f);
+    EXPECT_EQ(table.column<2>().countOf('z'), 38u);
+    EXPECT_EQ(table.column<2>().data() + 1, &table[1].get<2>());
+}
+
+struct ThrowingField {
+    static int copiesLeft;
+    int value;
+    ThrowingField(int v) : value(v) {}
+    ThrowingField(const ThrowingField& other) : value(other.value) {
+        if (copiesLeft-- == 0) {
+            throw std::runtime_error("copy failed");
+        }
+    }
+    ThrowingField& operator=(const ThrowingField&) = default;
+};
+int ThrowingField::copiesLeft = 1000;
+
+TEST(SoAVectorTest, FailedPushLeavesNoPartialRow) {
+    BasicSoAVector<NoLockPolicy, int, ThrowingField> table;
+    table.push_back(1, ThrowingField(1));
+    ThrowingField::copiesLeft = 0;
+    EXPECT_THROW(table.push_back(2, ThrowingField(2)), std::runtime_error);
+    ThrowingField::copiesLeft = 1000;
+    EXPECT_EQ(table.elements(), 1u);
+    table.push_back(3, ThrowingField(3));
+    EXPECT_EQ(table.column<0>().size(), 2u);
+    EXPECT_EQ(table[1].get<0>(), 3);
+    EXPECT_EQ(table[1].get<1>().value, 3);
+}
+
+TEST(SoAVectorTest, BoolFieldsAreByteColumns) {
+    SoAVector<int, bool> table;
+    for (int i = 0; i < 100; i++) {
+        table.push_back(i, i % 3 == 0);
+    }
+    ColumnSpan<bool> flags = table.column<1>();
+    EXPECT_EQ(flags.countOf(true), 34u);
+    EXPECT_EQ(flags.indexOf(false), 1);
+    flags[1] = true;
+    EXPECT_TRUE(table[1].get<1>());
+
+    table[2].get<1>() = true;
+    table[3] = std::make_tuple(-3, false);
+    EXPECT_EQ(table.row(2), std::make_tuple(2, true));
+    EXPECT_EQ(table.row(3), std::make_tuple(-3, false));
+    const SoAVector<int, bool>& view = table;
+    EXPECT_EQ(view.column<1>().countOf(true), 35u);
+}
+
+TEST(StaticSimpleVectorTest, ReportsOverflowWithoutThrowing) {
+    StaticSimpleVector<int, 4> vec = {1, 2, 3};
+    EXPECT_EQ(vec.size(), 4u);
+    EXPECT_EQ(vec.push_back(4), SimpleVectorStatus::Ok);
+    EXPECT_TRUE(vec.isFull());
+    EXPECT_EQ(vec.push_back(5), SimpleVectorStatus::Full);
+    EXPECT_EQ(vec.elements(), 4u);
+
+    int value = 0;
+    EXPECT_EQ(vec.get(3, value), SimpleVectorStatus::Ok);
+    EXPECT_EQ(value, 4);
+    EXPECT_EQ(vec.get(4, value), SimpleVectorStatus::IndexOutOfBounds);
+    EXPECT_EQ(vec.set(9, 0), SimpleVectorStatus::IndexOutOfBounds);
+    EXPECT_EQ(vec.at(4), nullptr);
+    EXPECT_EQ(*vec.back(), 4);
+
+    EXPECT_EQ(vec.remove(2), 1u);
+    EXPECT_EQ(vec.indexOf(3), 1);
+    EXPECT_EQ(vec.indexOf(2), -1);
+    EXPECT_EQ(vec.pop_back(), SimpleVectorStatus::Ok);
+    vec.clear();
+    EXPECT_EQ(vec.pop_back(), SimpleVectorStatus::Empty);
+    EXPECT_EQ(vec.front(), nullptr);
+}
+
+TEST(StaticSimpleVectorTest, ManagesElementLifetimesInline) {
+    std::shared_ptr<int> shared = std::make_shared<int>(7);
+    {
+        StaticSimpleVector<std::shared_ptr<int>, 8> owners;
+        for (int i = 0; i < 8; i++) {
+            owners.push_back(shared);
+        }
+        EXPECT_EQ(owners.emplace_back(shared), SimpleVectorStatus::Full);
+        EXPECT_EQ(shared.use_count(), 9);
+        EXPECT_GE(reinterpret_cast<const char*>(owners.data()), reinterpret_cast<const char*>(&owners));
+        EXPECT_LT(reinterpret_cast<const char*>(owners.data()), reinterpret_cast<const char*>(&owners + 1));
+
+        StaticSimpleVector<std::shared_ptr<int>, 8> moved(std::move(owners));
+        EXPECT_TRUE(owners.isEmpty());
+        EXPECT_EQ(shared.use_count(), 9);
+        moved.pop_back();
+        EXPECT_EQ(shared.use_count(), 8);
+    }
+    EXPECT_EQ(shared.use_count(), 1);
+}
+
+TEST(SortedSimpleVectorTest, BinarySearchLookups) {
+    SortedSimpleVector<int> ids = {42, 7, 19, 7, 100};
+    EXPECT_EQ(ids.elements(), 4u);
+    EXPECT_EQ(ids.front(), 7);
+    EXPECT_EQ(ids.back(), 100);
+    EXPECT_TRUE(ids.contains(19));
+    EXPECT_FALSE(ids.contains(20));
+    EXPECT_EQ(ids.indexOf(42), 2);
+    EXPECT_EQ(ids.indexOf(43), -1);
+    EXPECT_EQ(ids.lower_bound(20), 2u);
+    EXPECT_EQ(ids.upper_bound(42), 3u);
+    EXPECT_EQ(ids.lower_bound(1000), ids.elements());
+
+    EXPECT_TRUE(ids.insert(20));
+    EXPECT_FALSE(ids.insert(20));
+    EXPECT_TRUE(ids.erase(7));
+    EXPECT_FALSE(ids.erase(7));
+    std::vector<int> inOrder(ids.begin(), ids.end());
+    EXPECT_EQ(inOrder, (std::vector<int>{19, 20, 42, 100}));
+
+    SortedSimpleVector<std::string, std::greater<std::string>> names = {"b", "c", "a"};
+    EXPECT_EQ(names[0], "c");
+    EXPECT_EQ(names.indexOf("a"), 2);
+}
+
+TEST(SortedSimpleVectorTest, BatchInsertMergesAndDeduplicates) {
+    SortedSimpleVector<int> ids;
+    for (int round = 0; round < 10; round++) {
+        std::vector<int> batch;
+        for (int i = 0; i < 1000; i++) {
+            batch.push_back((i * 7919 + round * 31) % 5000);
+        }
+        ids.insertBatch(batch.begin(), batch.end());
+    }
+    int values[] = {4999, 0, 5000, 5000};
+    ids.insertBatch(values, 4);
+    EXPECT_TRUE(std::is_sorted(ids.begin(), ids.end()));
+    EXPECT_TRUE(std::adjacent_find(ids.begin(), ids.end()) == ids.end());
+    EXPECT_TRUE(ids.contains(5000));
+    EXPECT_EQ(ids.back(), 5000);
+
+    SimpleVector<int> unsorted = {3, 1, 2, 3};
+    SortedSimpleVector<int> fromVector(unsorted);
+    EXPECT_EQ(fromVector.elements(), 3u);
+    EXPECT_EQ(fromVector[0], 1);
+}
+
+TEST(SortedSimpleVectorTest, SetOperations) {
+    SortedSimpleVector<int> evens, thirds;
+    for (int i = 0; i < 60; i += 2) {
+        evens.insert(i);
+    }
+    for (int i = 0; i < 60; i += 3) {
+        thirds.insert(i);
+    }
+    typedef SortedSimpleVector<int> IntSet;
+    IntSet both = IntSet::setIntersection(evens, thirds);
+    IntSet either = IntSet::setUnion(evens, thirds);
+    IntSet onlyEven = IntSet::setDifference(evens, thirds);
+    EXPECT_EQ(both.elements(), 10u);
+    EXPECT_EQ(both[1], 6);
+    EXPECT_EQ(either.elements(), 40u);
+    EXPECT_TRUE(std::is_sorted(either.begin(), either.end()));
+    EXPECT_EQ(onlyEven.elements(), 20u);
+    EXPECT_FALSE(onlyEven.contains(6));
+    EXPECT_EQ(IntSet::setUnion(evens, evens).elements(), evens.elements());
+}
+
+TEST(ParallelAlgorithmsTest, ForEachAndTransform) {
+    SimpleVector<int, NoLockPolicy> values;
+    for (int i = 0; i < 100000; i++) {
+        values.push_back(i);
+    }
+    parallel_for_each(values, [](int& value) { value *= 2; }, 1000);
+    SimpleVector<long long> squares;
+    parallel_transform(values, squares, [](int value) { return static_cast<long long>(value) * value; }, 1000);
+    ASSERT_EQ(squares.elements(), values.elements());
+    for (size_t i = 0; i < values.elements(); i += 997) {
+        EXPECT_EQ(values[i], static_cast<int>(2 * i));
+        EXPECT_EQ(squares[i], 4LL * i * i);
+    }
+
+    ParallelChunks chunks(values.data() + 1, 1000, 100);
+    size_t covered = 0;
+    for (size_t chunk = 0; chunk < chunks.chunkCount(); chunk++) {
+        EXPECT_EQ(chunks.begin(chunk), covered);
+        if (chunk > 0) {
+            EXPECT_EQ(reinterpret_cast<uintptr_t>(values.data() + 1 + chunks.begin(chunk)) % 64, 0u);
+        }
+        covered = chunks.end(chunk);
+    }
+    EXPECT_EQ(covered, 1000u);
+}
+
+TEST(ParallelAlgorithmsTest, ReduceIsDeterministic) {
+    SimpleVector<double, NoLockPolicy> values;
+    for (int i = 0; i < 200000; i++) {
+        values.push_back(1.0 / (1 + i % 977));
+    }
+    auto add = [](double total, double value) { return total + value; };
+    double first = parallel_reduce(values, 0.0, add, add, 512);
+    for (int run = 0; run < 5; run++) {
+        EXPECT_EQ(parallel_reduce(values, 0.0, add, add, 512), first);
+    }
+    EXPECT_NEAR(first, std::accumulate(values.begin(), values.end(), 0.0), 1e-9);
+    SimpleVector<double, NoLockPolicy> empty;
+    EXPECT_EQ(parallel_reduce(empty, 5.0, add, add), 5.0);
+
+    // The element type and the result type differ, so the chunk results are added with combine, not with op.
+    SimpleVector<int, NoLockPolicy> positives;
+    for (int i = 0; i < 100000; i++) {
+        positives.push_back(5);
+    }
+    size_t count = parallel_reduce(positives, size_t(0), [](size_t n, int value) { return n + (value > 0); },
+                                   std::plus<size_t>(), 1024);
+    EXPECT_EQ(count, 100000u);
+
+    EXPECT_THROW(parallel_for_each(values, [](double& value) {
+        if (value == 1.0) {
+            throw std::runtime_error("chunk failed");
+        }
+    }, 512), std::runtime_error);
+}
+
+TEST(ParallelAlgorithmsTest, FilterKeepsOrder) {
+    SimpleVector<int> values;
+    for (int i = 0; i < 100000; i++) {
+        values.push_back(i);
+    }
+    SimpleVector<int> multiples = parallel_filter(values, [](int value) { return value % 7 == 0; }, 256);
+    ASSERT_EQ(multiples.elements(), 14286u);
+    for (size_t i = 0; i < multiples.elements(); i++) {
+        ASSERT_EQ(multiples[i], static_cast<int>(7 * i));
+    }
+    // Nested parallel calls run on the same pool without deadlocking.
+    std::atomic<long long> total(0);
+    SimpleVector<int> outer = {1, 2, 3, 4, 5, 6, 7, 8};
+    parallel_for_each(outer, [&](int& scale) {
+        total += scale * parallel_reduce(values, 0LL, [](long long sum, int value) { return sum + value; }, std::plus<long long>(), 4096);
+    }, 1);
+    EXPECT_EQ(total.load(), 36LL * (99999LL * 100000 / 2));
+}
+
+TEST(SimpleVectorLockPolicyTest, NoLockPolicy) {
+    SimpleVector<int, NoLockPolicy> vec;
+    for (int i = 0; i < 100; i++) {
+        vec.push_back(i);
+    }
+    EXPECT_EQ(vec.elements(), 100);
+    EXPECT_EQ(vec[42], 42);
+    EXPECT_EQ(vec.indexOf(99), 99);
+    vec.remove(42);
+    EXPECT_FALSE(vec.contains(42));
+    EXPECT_EQ(vec.elements(), 99);
+}
+
+TEST(SimpleVectorLockPolicyTest, SharedMutexLockPolicy) {
+    SimpleVector<int, SharedMutexLockPolicy> vec;
+    for (int i = 0; i < 1000; i++) {
+        vec.push_back(i);
+    }
+
+    std::vector<std::thread> readers;
+    std::atomic<long> total{0};
+    for (int t = 0; t < 4; t++) {
+        readers.emplace_back([&vec, &total]() {
+            long sum = 0;
+            for (unsigned int i = 0; i < vec.elements(); i++) {
+                sum += vec[i];
+            }
+            total += sum;
+        });
+    }
+    for (auto& reader : readers) {
+        reader.join();
+    }
+    EXPECT_EQ(total.load(), 4L * 999 * 1000 / 2);
+}
+
+TEST(SimpleVectorLockPolicyTest, ConcurrentPushBack) {
+    SimpleVector<int> vec;
+    std::vector<std::thread> writers;
+    for (int t = 0; t < 4; t++) {
+        writers.emplace_back([&vec]() {
+            for (int i = 0; i < 1000; i++) {
+                vec.push_back(i);
+            }
+        });
+    }
+    for (auto& writer : writers) {
+        writer.join();
+    }
+    EXPECT_EQ(vec.elements(), 4000);
+}
+
+TEST(SmallSimpleVectorTest, StaysInlineThenSpills) {
+    SmallSimpleVector<int, 4> vec;
+    EXPECT_TRUE(vec.isInline());
+    EXPECT_EQ(vec.size(), 4);
+    for (int i = 0; i < 4; i++) {
+        vec.push_back(i);
+    }
+    EXPECT_TRUE(vec.isInline());
+    vec.push_back(4);
+    EXPECT_FALSE(vec.isInline());
+    EXPECT_EQ(vec.elements(), 5);
+    EXPECT_EQ(vec[4], 4);
+
+    vec.remove(4);
+    vec.shrinkToFit();
+    EXPECT_TRUE(vec.isInline());
+    EXPECT_EQ(vec.elements(), 4);
+    EXPECT_EQ(vec[3], 3);
+
+    vec.releaseMemory();
+    EXPECT_TRUE(vec.isInline());
+    EXPECT_TRUE(vec.isEmpty());
+    vec.push_back(7);
+    EXPECT_EQ(vec[0], 7);
+}
+
+TEST(SmallSimpleVectorTest, CopyAndMove) {
+    SmallSimpleVector<std::string, 2> small = {"a", "b"};
+    SmallSimpleVector<std::string, 2> copy(small);
+    EXPECT_TRUE(copy.isInline());
+    EXPECT_EQ(copy[1], "b");
+
+    SmallSimpleVector<std::string, 2> moved(std::move(copy));
+    EXPECT_TRUE(moved.isInline());
+    EXPECT_EQ(moved[0], "a");
+    EXPECT_TRUE(copy.isEmpty());
+    EXPECT_TRUE(copy.isInline());
+
+    SmallSimpleVector<std::string, 2> big = {"x", "y", "z"};
+    EXPECT_FALSE(big.isInline());
+    moved = std::move(big);
+    EXPECT_EQ(moved.elements(), 3);
+    EXPECT_EQ(moved[2], "z");
+    EXPECT_TRUE(big.isEmpty());
+
+    small = moved;
+    EXPECT_EQ(small.elements(), 3);
+    EXPECT_EQ(moved.elements(), 3);
+}
+
+TEST(SmallSimpleVectorTest, ConvertsToAndFromSimpleVector) {
+    SimpleVector<int> heap = {1, 2, 3};
+    SmallSimpleVector<int, 8> small(heap);
+    EXPECT_TRUE(small.isInline());
+    EXPECT_EQ(small.elements(), 3);
+
+    SimpleVector<int> back(std::move(small));
+    EXPECT_EQ(back.elements(), 3);
+    EXPECT_EQ(back[2], 3);
+    EXPECT_TRUE(small.isEmpty());
+
+    SimpleVector<int>& asBase = small;
+    asBase.push_back(9);
+    EXPECT_EQ(small[0], 9);
+
+    // Inline elements need a heap array in a plain SimpleVector, so only that move may throw
+    typedef SmallSimpleVector<int, 8> Small;
+    static_assert(!std::is_nothrow_constructible<SimpleVector<int>, Small&&>::value, "moving inline elements to the heap may throw");
+    static_assert(std::is_nothrow_move_constructible<Small>::value, "Small to Small moves stay inline");
+    static_assert(std::is_nothrow_move_constructible<SimpleVector<int>>::value, "heap moves only steal the array");
+    back = std::move(small);
+    EXPECT_EQ(back.elements(), 1);
+    EXPECT_EQ(back[0], 9);
+
+    Small inlineSource = {4, 5};
+    Small target = {1, 2, 3};
+    target = std::move(inlineSource);
+    EXPECT_TRUE(target.isInline());
+    EXPECT_EQ(target.elements(), 2);
+    EXPECT_EQ(target[1], 5);
+
+    SmallSimpleVector<bool, 64> flags = {true, false, true};
+    SimpleVector<bool> packed(std::move(flags));
+    EXPECT_EQ(packed.elements(), 3);
+    EXPECT_TRUE(packed[2]);
+    static_assert(!std::is_nothrow_constructible<SimpleVector<bool>, SmallSimpleVector<bool, 64>&&>::value, "moving inline words to the heap may throw");
+}
+
+TEST(SmallSimpleVectorTest, DestroysInlineElements) {
+    LifetimeTracker::live = 0;
+    {
+        SmallSimpleVector<LifetimeTracker, 4> vec;
+        vec.emplace_back(1);
+        vec.emplace_back(2);
+        EXPECT_EQ(LifetimeTracker::live, 2);
+        SmallSimpleVector<LifetimeTracker, 4> other(std::move(vec));
+        EXPECT_EQ(LifetimeTracker::live, 2);
+        for (int i = 3; i <= 6; i++) {
+            other.emplace_back(i);
+        }
+        EXPECT_EQ(LifetimeTracker::live, 6);
+        other.clear();
+        EXPECT_EQ(LifetimeTracker::live, 0);
+        other.emplace_back(7);
+    }
+    EXPECT_EQ(LifetimeTracker::live, 0);
+}
+
+// Checks the SIMD kernels against the scalar loops for every length up to a few vector widths,
+// so both the vector body and the scalar tail are covered.
+template <typename T>
+void checkKernelsAgainstScalar(T (*valueAt)(unsigned int)) {
+    for (unsigned int n = 1; n < 100; n++) {
+        SimpleVector<T, NoLockPolicy> vec;
+        for (unsigned int i = 0; i < n; i++) {
+            vec.push_back(valueAt(i));
+        }
+        const T* data = vec.data();
+        T last = valueAt(n - 1);
+        EXPECT_EQ(vec.indexOf(last), static_cast<int>(ScalarKernels<T>::find(data, n, last)));
+        EXPECT_EQ(vec.count(last), ScalarKernels<T>::count(data, n, last));
+        EXPECT_EQ(vec.min(), ScalarKernels<T>::min(data, n));
+        EXPECT_EQ(vec.max(), ScalarKernels<T>::max(data, n));
+        EXPECT_DOUBLE_EQ(static_cast<double>(vec.sum()), static_cast<double>(ScalarKernels<T>::sum(data, n)));
+        EXPECT_FALSE(vec.contains(static_cast<T>(101)));
+    }
+}
+
+TEST(SimpleVectorSimdTest, MatchesScalarKernels) {
+    checkKernelsAgainstScalar<int>([](unsigned int i) { return static_cast<int>((i * 37) % 23) - 11; });
+    checkKernelsAgainstScalar<char>([](unsigned int i) { return static_cast<char>((i * 37) % 91 - 45); });
+    checkKernelsAgainstScalar<float>([](unsigned int i) { return static_cast<float>((i * 37) % 23) * 0.5f - 5.0f; });
+    checkKernelsAgainstScalar<double>([](unsigned int i) { return static_cast<double>((i * 37) % 23) * 0.25 - 2.0; });
+}
+
+TEST(SimpleVectorSimdTest, SumDoesNotOverflow) {
+    SimpleVector<int> vec;
+    for (int i = 0; i < 1000; i++) {
+        vec.push_back(std::numeric_limits<int>::max());
+    }
+    EXPECT_EQ(vec.sum(), 1000LL * std::numeric_limits<int>::max());
+
+    SimpleVector<char> chars;
+    for (int i = 0; i < 100; i++) {
+        chars.push_back(static_cast<char>(100));
+    }
+    EXPECT_EQ(chars.sum(), 10000);
+}
+
+TEST(SimpleVectorSimdTest, RemoveAllMatches) {
+    SimpleVector<int> vec;
+    for (int i = 0; i < 1000; i++) {
+        vec.push_back(i % 7 == 0 ? -1 : i);
+    }
+    vec.remove(-1);
+    EXPECT_EQ(vec.elements(), 857);
+    EXPECT_EQ(vec.count(-1), 0);
+    EXPECT_EQ(vec[0], 1);
+    EXPECT_EQ(vec[6], 8);
+    EXPECT_EQ(vec.indexOf(999), 856);
+
+    vec.remove(12345);
+    EXPECT_EQ(vec.elements(), 857);
+}
+
+TEST(SimpleVectorSimdTest, ReductionsOnOtherTypes) {
+    SimpleVector<std::string> words = {"pear", "apple", "fig", "apple"};
+    EXPECT_EQ(words.count("apple"), 2);
+    EXPECT_EQ(words.min(), "apple");
+    EXPECT_EQ(words.max(), "pear");
+
+    SimpleVector<long> longs = {5, -3, 9};
+    EXPECT_EQ(longs.sum(), 11);
+    EXPECT_EQ(longs.min(), -3);
+
+    SimpleVector<double> empty;
+    EXPECT_THROW(empty.min(), IndexOutOfBoundsException);
+    EXPECT_EQ(empty.sum(), 0.0);
+}
+
+TEST(ConcurrentSimpleVectorTest, ReferencesStayValidWhileGrowing) {
+    ConcurrentSimpleVector<std::string> vec;
+    EXPECT_TRUE(vec.isEmpty());
+    std::string& first = vec.emplace_back("first");
+    for (int i = 0; i < 10000; i++) {
+        vec.push_back(std::to_string(i));
+    }
+    EXPECT_EQ(&first, &vec[0]);
+    EXPECT_EQ(first, "first");
+    EXPECT_EQ(vec.elements(), 10001);
+    EXPECT_EQ(vec[10000], "9999");
+    EXPECT_EQ(vec.back(), "9999");
+    EXPECT_THROW(vec[10001], IndexOutOfBoundsException);
+
+    size_t visited = 0;
+    for (const std::string& value : vec) {
+        (void)value;
+        visited++;
+    }
+    EXPECT_EQ(visited, 10001);
+}
+
+TEST(ConcurrentSimpleVectorTest, ConcurrentProducers) {
+    ConcurrentSimpleVector<int> vec;
+    const int perThread = 20000;
+    std::vector<std::thread> writers;
+    for (int t = 0; t < 4; t++) {
+        writers.emplace_back([&vec, t, perThread]() {
+            for (int i = 0; i < perThread; i++) {
+                vec.push_back(t * perThread + i);
+            }
+        });
+    }
+    for (auto& writer : writers) {
+        writer.join();
+    }
+    ASSERT_EQ(vec.elements(), 4u * perThread);
+    std::vector<bool> seen(4 * perThread, false);
+    for (size_t i = 0; i < vec.elements(); i++) {
+        EXPECT_FALSE(seen[vec[i]]);
+        seen[vec[i]] = true;
+    }
+}
+
+TEST(ConcurrentSimpleVectorTest, ReadersSeeOnlyPublishedElements) {
+    ConcurrentSimpleVector<std::unique_ptr<int>> vec;
+    std::atomic<bool> done{false};
+    std::atomic<bool> ok{true};
+    std::thread reader([&]() {
+        while (!done.load()) {
+            size_t published = vec.elements();
+            for (size_t i = 0; i < published; i++) {
+                if (!vec[i] || *vec[i] != static_cast<int>(i)) {
+                    ok = false;
+                }
+            }
+        }
+    });
+    for (int i = 0; i < 5000; i++) {
+        vec.push_back(std::unique_ptr<int>(new int(i)));
+    }
+    done = true;
+    reader.join();
+    EXPECT_TRUE(ok.load());
+    EXPECT_EQ(vec.elements(), 5000);
+}
+
+TEST(ConcurrentSimpleVectorTest, DestroysElements) {
+    LifetimeTracker::live = 0;
+    {
+        ConcurrentSimpleVector<LifetimeTracker> vec;
+        for (int i = 0; i < 100; i++) {
+            vec.emplace_back(i);
+        }
+        EXPECT_EQ(LifetimeTracker::live, 100);
+    }
+    EXPECT_EQ(LifetimeTracker::live, 0);
+}
+
+TEST(SnapshotSimpleVectorTest, ReadsAndWrites) {
+    SnapshotSimpleVector<int> vec{1, 2, 3};
+    EXPECT_EQ(vec.elements(), 3);
+    EXPECT_EQ(vec[1], 2);
+    EXPECT_TRUE(vec.contains(3));
+    vec.push_back(4);
+    vec.set(0, 10);
+    vec.remove(2);
+    EXPECT_EQ(vec.elements(), 3);
+    EXPECT_EQ(vec[0], 10);
+    EXPECT_EQ(vec.indexOf(4), 2);
+    EXPECT_EQ(vec.indexOf(2), -1);
+    EXPECT_THROW(vec[3], IndexOutOfBoundsException);
+    EXPECT_THROW(vec.set(5, 1), IndexOutOfBoundsException);
+    EXPECT_EQ(vec.elements(), 3);
+    vec.clear();
+    EXPECT_TRUE(vec.isEmpty());
+}
+
+TEST(SnapshotSimpleVectorTest, SnapshotIgnoresLaterWrites) {
+    SnapshotSimpleVector<std::string> vec{"a", "b"};
+    {
+        auto view = vec.snapshot();
+        vec.push_back("c");
+        vec.remove("a");
+        EXPECT_EQ(view.elements(), 2);
+        EXPECT_EQ(view[0], "a");
+        std::string joined;
+        for (const std::string& value : view) {
+            joined += value;
+        }
+        EXPECT_EQ(joined, "ab");
+        EXPECT_GT(EpochReclamation::instance().pendingCount(), 0u);
+    }
+    EXPECT_EQ(vec.elements(), 2);
+    EXPECT_EQ(vec[0], "b");
+    EpochReclamation::instance().collect();
+    EXPECT_EQ(EpochReclamation::instance().pendingCount(), 0u);
+}
+
+TEST(SnapshotSimpleVectorTest, ReadersRunAlongsideWriter) {
+    SnapshotSimpleVector<int> vec;
+    std::atomic<bool> done{false};
+    std::atomic<bool> ok{true};
+    std::vector<std::thread> readers;
+    for (int t = 0; t < 4; t++) {
+        readers.emplace_back([&]() {
+            while (!done.load()) {
+                auto view = vec.snapshot();
+                for (unsigned int i = 0; i < view.elements(); i++) {
+                    if (view[i] != static_cast<int>(i)) {
+                        ok = false;
+                    }
+                }
+            }
+        });
+    }
+    for (int i = 0; i < 2000; i++) {
+        vec.push_back(i);
+    }
+    done = true;
+    for (auto& reader : readers) {
+        reader.join();
+    }
+    EXPECT_TRUE(ok.load());
+    EXPECT_EQ(vec.elements(), 2000);
+    EpochReclamation::instance().collect();
+    EXPECT_EQ(EpochReclamation::instance().pendingCount(), 0u);
+}
+
+#ifdef SIMPLEVECTOR_HAS_MMAP
+struct MappedRecord {
+    int id;
+    double value;
+    bool operator==(const MappedRecord& other) const { return id == other.id && value == other.value; }
+};
+
+TEST(MappedSimpleVectorTest, ReopensWithoutLoading) {
+    std::string path = ::testing::TempDir() + "mapped_records.bin";
+    std::remove(path.c_str());
+    {
+        MappedSimpleVector<MappedRecord> vec(path);
+        EXPECT_TRUE(vec.isEmpty());
+        for (int i = 0; i < 10000; i++) {
+            vec.push_back(MappedRecord{i, i * 0.5});
+        }
+        vec.push_back(vec[0]);
+        EXPECT_GE(vec.capacity(), 10001u);
+        vec.sync();
+    }
+    MappedSimpleVector<MappedRecord> reopened(path);
+    ASSERT_EQ(reopened.elements(), 10001u);
+    EXPECT_EQ(reopened[1234].id, 1234);
+    EXPECT_EQ(reopened[1234].value, 617.0);
+    EXPECT_EQ(reopened.back(), reopened.front());
+    EXPECT_EQ(reopened.indexOf(MappedRecord{9999, 4999.5}), 9999);
+    EXPECT_THROW(reopened[10001], IndexOutOfBoundsException);
+    std::remove(path.c_str());
+}
+
+TEST(MappedSimpleVectorTest, ClearAppendAndShrink) {
+    std::string path = ::testing::TempDir() + "mapped_ints.bin";
+    std::remove(path.c_str());
+    MappedSimpleVector<int> vec(path);
+    int values[] = {1, 2, 3, 2, 5};
+    vec.append(values, 5);
+    vec.remove(2);
+    EXPECT_EQ(std::vector<int>(vec.begin(), vec.end()), std::vector<int>({1, 3, 5}));
+    EXPECT_EQ(vec.count(3), 1u);
+    vec.reserve(1000);
+    EXPECT_EQ(vec.capacity(), 1000u);
+    EXPECT_TRUE(vec.shrinkToFit());
+    EXPECT_EQ(vec.capacity(), 3u);
+    vec.clear();
+    EXPECT_TRUE(vec.isEmpty());
+    EXPECT_EQ(vec.elements(), 0u);
+    EXPECT_EQ(vec.size(), 3u);
+    std::remove(path.c_str());
+}
+
+TEST(MappedSimpleVectorTest, AppendOwnElementsWhileGrowing) {
+    std::string path = ::testing::TempDir() + "mapped_self.bin";
+    std::remove(path.c_str());
+    MappedSimpleVector<int> vec(path);
+    for (int i = 0; i < 100000; i++) {
+        vec.push_back(i);
+    }
+    vec.shrinkToFit();
+    vec.append(vec.data(), 100000); // The remap may move the source
+    ASSERT_EQ(vec.elements(), 200000u);
+    EXPECT_EQ(vec[100000], 0);
+    EXPECT_EQ(vec[199999], 99999);
+    std::remove(path.c_str());
+}
+
+TEST(MappedSimpleVectorTest, RejectsForeignFiles) {
+    std::string path = ::testing::TempDir() + "mapped_foreign.bin";
+    std::remove(path.c_str());
+    {
+        MappedSimpleVector<int> vec(path);
+        vec.push_back(7);
+    }
+    typedef MappedSimpleVector<double> DoubleVector;
+    EXPECT_THROW(DoubleVector doubles(path), SimpleVectorException);
+
+    FILE* file = std::fopen(path.c_str(), "wb");
+    std::fputs("definitely not a vector, just some text that is long enough to cover a header", file);
+    std::fclose(file);
+    typedef MappedSimpleVector<int> IntVector;
+    EXPECT_THROW(IntVector ints(path), SimpleVectorException);
+    std::remove(path.c_str());
+}
+#endif